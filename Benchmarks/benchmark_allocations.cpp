@@ -0,0 +1,64 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+// The global operator new and delete replacements live in their own translation unit: once inlined next to standard
+// containers, compilers flag the free of memory coming from operator new as a mismatch.
+
+#include "benchmark_common.hpp"
+
+#include <cstdlib>
+#include <new>
+
+namespace lbsbench {
+
+namespace {
+
+thread_local AllocationCounters currentCounters;
+
+} // namespace
+
+AllocationCounters& allocationCounters() noexcept
+{
+    return currentCounters;
+}
+
+} // namespace lbsbench
+
+// Count the C++ allocations of every benchmark executable, so all the compared libraries pay the same overhead
+void* operator new(std::size_t size)
+{
+    lbsbench::AllocationCounters& counters = lbsbench::allocationCounters();
+    ++counters.cxxAllocations;
+    counters.cxxBytes += size;
+
+    if (void* ptr = std::malloc(size != 0 ? size : 1))
+        return ptr;
+
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size)
+{
+    return ::operator new(size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete(void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
+
+void operator delete[](void* ptr, std::size_t) noexcept
+{
+    std::free(ptr);
+}
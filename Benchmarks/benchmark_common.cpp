@@ -5,13 +5,73 @@
 
 #include "benchmark_common.hpp"
 
+#if LUABRIDGE_TEST_LUAU
+#include "../ThirdParty/luau/Compiler/include/luacode.h"
+
+#include <memory>
+#endif
+
+#include <cstdlib>
 #include <string>
 
 namespace lbsbench {
 
+namespace {
+
+std::size_t registryLength(lua_State* L)
+{
+#if LUA_VERSION_NUM >= 502
+    return static_cast<std::size_t>(lua_rawlen(L, LUA_REGISTRYINDEX));
+#else
+    return static_cast<std::size_t>(lua_objlen(L, LUA_REGISTRYINDEX));
+#endif
+}
+
+} // namespace
+
+void* countingLuaAlloc(void*, void* ptr, std::size_t osize, std::size_t nsize)
+{
+    if (nsize == 0)
+    {
+        std::free(ptr);
+        return nullptr;
+    }
+
+    // When ptr is null, osize is the type of the object being allocated and not a size
+    if (ptr == nullptr || nsize > osize)
+    {
+        AllocationCounters& counters = allocationCounters();
+        ++counters.luaAllocations;
+        counters.luaBytes += ptr == nullptr ? nsize : nsize - osize;
+    }
+
+    return std::realloc(ptr, nsize);
+}
+
+AllocationTracker::AllocationTracker(benchmark::State& state, lua_State* L)
+    : m_state(state)
+    , m_L(L)
+    , m_start(allocationCounters())
+    , m_registryStart(registryLength(L))
+{
+}
+
+AllocationTracker::~AllocationTracker()
+{
+    // Take the deltas first, adding the counters allocates
+    const AllocationCounters end = allocationCounters();
+    const double registryGrowth = static_cast<double>(registryLength(m_L)) - static_cast<double>(m_registryStart);
+
+    m_state.counters["lua_allocs"] = benchmark::Counter(static_cast<double>(end.luaAllocations - m_start.luaAllocations), benchmark::Counter::kAvgIterations);
+    m_state.counters["lua_bytes"] = benchmark::Counter(static_cast<double>(end.luaBytes - m_start.luaBytes), benchmark::Counter::kAvgIterations);
+    m_state.counters["cxx_allocs"] = benchmark::Counter(static_cast<double>(end.cxxAllocations - m_start.cxxAllocations), benchmark::Counter::kAvgIterations);
+    m_state.counters["cxx_bytes"] = benchmark::Counter(static_cast<double>(end.cxxBytes - m_start.cxxBytes), benchmark::Counter::kAvgIterations);
+    m_state.counters["registry_growth"] = benchmark::Counter(registryGrowth, benchmark::Counter::kAvgIterations);
+}
+
 void luaCheckOrThrow(lua_State* L, int status, std::string_view where)
 {
-    if (status == LUA_OK)
+    if (status == 0) // LUA_OK is not defined by Lua 5.1 and LuaJIT
         return;
 
     const char* message = lua_tostring(L, -1);
@@ -24,7 +84,19 @@ void luaCheckOrThrow(lua_State* L, int status, std::string_view where)
 
 void luaDoStringOrThrow(lua_State* L, std::string_view code, std::string_view where)
 {
+#if LUABRIDGE_TEST_LUAU
+    // Luau only loads bytecode, so the chunk is compiled first
+    std::size_t bytecodeSize = 0;
+    const std::unique_ptr<char, decltype(&std::free)> bytecode(
+        luau_compile(code.data(), code.size(), nullptr, &bytecodeSize), &std::free);
+
+    int status = luau_load(L, std::string(where).c_str(), bytecode.get(), bytecodeSize, 0);
+    if (status == 0)
+        status = lua_pcall(L, 0, LUA_MULTRET, 0);
+#else
     const int status = luaL_dostring(L, std::string(code).c_str());
+#endif
+
     luaCheckOrThrow(L, status, where);
 }
 
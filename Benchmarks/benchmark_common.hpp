@@ -9,6 +9,7 @@
 
 #include <benchmark/benchmark.h>
 
+#include <cstddef>
 #include <cstdint>
 #include <memory>
 #include <stdexcept>
@@ -221,6 +222,46 @@ inline double shared_object_get_value(std::shared_ptr<SharedObject> obj)
     return obj ? obj->get() : 0.0;
 }
 
+/**
+ * Allocations made by the current thread, through `countingLuaAlloc` and through the global `operator new`.
+ */
+struct AllocationCounters
+{
+    std::size_t luaAllocations = 0;
+    std::size_t luaBytes = 0;
+    std::size_t cxxAllocations = 0;
+    std::size_t cxxBytes = 0;
+};
+
+AllocationCounters& allocationCounters() noexcept;
+
+/**
+ * A lua_Alloc counting allocations (and growing reallocations) in the allocation counters of the current thread.
+ */
+void* countingLuaAlloc(void* ud, void* ptr, std::size_t osize, std::size_t nsize);
+
+/**
+ * Report the allocations made during the benchmark loop as user counters, averaged per iteration.
+ *
+ * Construct it right before the loop: setup allocations are not counted. The counters are `lua_allocs`, `lua_bytes`,
+ * `cxx_allocs`, `cxx_bytes` and `registry_growth` (the growth of the registry array, like leaked `luaL_ref` slots).
+ */
+class AllocationTracker
+{
+public:
+    AllocationTracker(benchmark::State& state, lua_State* L);
+    ~AllocationTracker();
+
+    AllocationTracker(const AllocationTracker&) = delete;
+    AllocationTracker& operator=(const AllocationTracker&) = delete;
+
+private:
+    benchmark::State& m_state;
+    lua_State* m_L;
+    AllocationCounters m_start;
+    std::size_t m_registryStart;
+};
+
 void luaCheckOrThrow(lua_State* L, int status, std::string_view where);
 void luaDoStringOrThrow(lua_State* L, std::string_view code, std::string_view where);
 
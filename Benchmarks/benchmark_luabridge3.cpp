@@ -6,11 +6,26 @@
 #include "benchmark_common.hpp"
 
 #include "LuaBridge/LuaBridge.h"
+#include "LuaBridge/Array.h"
+#include "LuaBridge/Map.h"
+#include "LuaBridge/Set.h"
+#include "LuaBridge/UnorderedMap.h"
+#include "LuaBridge/Variant.h"
+#include "LuaBridge/Vector.h"
 
 #include <benchmark/benchmark.h>
 
+#include <array>
 #include <cmath>
+#include <map>
+#include <memory>
+#include <optional>
+#include <set>
+#include <string>
 #include <tuple>
+#include <unordered_map>
+#include <variant>
+#include <vector>
 
 namespace luabridge {
 
@@ -44,6 +59,19 @@ namespace {
 
 using namespace lbsbench;
 
+// The same benchmarks are built against every supported runtime, the report context tells them apart
+#if LUABRIDGE_ON_LUAU
+constexpr const char* kLuaRuntime = "Luau";
+#elif LUABRIDGE_ON_RAVI
+constexpr const char* kLuaRuntime = "Ravi";
+#elif LUABRIDGE_ON_LUAJIT
+constexpr const char* kLuaRuntime = LUAJIT_VERSION;
+#else
+constexpr const char* kLuaRuntime = LUA_RELEASE;
+#endif
+
+[[maybe_unused]] const bool kLuaRuntimeRegistered = (benchmark::AddCustomContext("lua_runtime", kLuaRuntime), true);
+
 std::tuple<double, double> lb3_multi_return(double value)
 {
     return { value, value * 2.0 };
@@ -160,7 +188,7 @@ void registerSharedObject(lua_State* L)
 
 lua_State* makeLua()
 {
-    lua_State* L = luaL_newstate();
+    lua_State* L = luabridge::lua_newstate_x(&countingLuaAlloc, nullptr, 0);
     luaL_openlibs(L);
     luabridge::registerMainThread(L);
 #if LUABRIDGE_HAS_EXCEPTIONS
@@ -169,12 +197,26 @@ lua_State* makeLua()
     return L;
 }
 
+struct LuaStateCloser
+{
+    void operator()(lua_State* L) const
+    {
+        lua_close(L);
+    }
+};
+
+/**
+ * A Lua state closed at the end of the benchmark, after the references and trackers declared after it.
+ */
+using ScopedLua = std::unique_ptr<lua_State, LuaStateCloser>;
+
 void table_global_string_get_measure(benchmark::State& state)
 {
     lua_State* L = makeLua();
     luabridge::setGlobal(L, kMagicValue, "value");
 
     double x = 0;
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         x += static_cast<double>(luabridge::getGlobal(L, "value"));
@@ -187,6 +229,7 @@ void table_global_string_set_measure(benchmark::State& state)
     lua_State* L = makeLua();
 
     double v = 0;
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         v += kMagicValue;
@@ -196,6 +239,41 @@ void table_global_string_set_measure(benchmark::State& state)
     benchmark::DoNotOptimize(v);
 }
 
+void global_handle_get_measure(benchmark::State& state)
+{
+    const ScopedLua lua(makeLua());
+    lua_State* L = lua.get();
+    luabridge::setGlobal(L, kMagicValue, "value");
+
+    const luabridge::GlobalHandle<double> handle(L, "value");
+
+    double x = 0;
+    AllocationTracker allocations(state, L);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        x += *handle.get();
+    }
+    benchmark::DoNotOptimize(x);
+}
+
+template <bool Cached>
+void global_handle_vector_get_measure(benchmark::State& state)
+{
+    const ScopedLua lua(makeLua());
+    lua_State* L = lua.get();
+    luabridge::setGlobal(L, std::vector<int>(static_cast<std::size_t>(state.range(0)), 1), "values");
+
+    const luabridge::GlobalHandle<std::vector<int>> handle(L, "values", Cached);
+
+    std::size_t x = 0;
+    AllocationTracker allocations(state, L);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        x += handle.get()->size();
+    }
+    benchmark::DoNotOptimize(x);
+}
+
 void table_get_measure(benchmark::State& state)
 {
     lua_State* L = makeLua();
@@ -203,6 +281,7 @@ void table_get_measure(benchmark::State& state)
     luabridge::LuaRef t = luabridge::getGlobal(L, "warble");
 
     double x = 0;
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         x += static_cast<double>(t["value"]);
@@ -218,6 +297,7 @@ void table_set_measure(benchmark::State& state)
     luabridge::LuaRef t = luabridge::getGlobal(L, "warble");
 
     double v = 0;
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         v += kMagicValue;
@@ -233,6 +313,7 @@ void table_chained_get_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "ulahibe = { warble = { value = 24.0 } }", "table_chained_get setup");
 
     double x = 0;
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         auto tw = luabridge::getGlobal(L, "ulahibe")["warble"]["value"];
@@ -248,6 +329,7 @@ void table_chained_set_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "ulahibe = { warble = { value = 24.0 } }", "table_chained_set setup");
 
     double v = 0;
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         v += kMagicValue;
@@ -264,6 +346,7 @@ void c_function_measure(benchmark::State& state)
 
     luaDoStringOrThrow(L, "function invoke_f() return f(24.0) end", "c_function setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "invoke_f");
@@ -279,6 +362,7 @@ void lua_function_in_c_measure(benchmark::State& state)
 
     luabridge::LuaRef f = luabridge::getGlobal(L, "f");
     double x = 0;
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         x += f.call<double>(kMagicValue).valueOr(0.0);
@@ -294,6 +378,7 @@ void c_function_through_lua_in_c_measure(benchmark::State& state)
 
     luabridge::LuaRef f = luabridge::getGlobal(L, "f");
     double x = 0;
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         x += f.call<double>(kMagicValue).valueOr(0.0);
@@ -309,6 +394,7 @@ void member_function_call_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "b = c()", "member_function setup");
     luaDoStringOrThrow(L, "function call_member() b:set(b:get() + 1.0) end", "member_function closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "call_member");
@@ -323,6 +409,7 @@ void userdata_variable_access_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "b = c()", "userdata_variable_access setup");
     luaDoStringOrThrow(L, "function access_var() return b.var end", "userdata_variable_access closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "access_var");
@@ -338,6 +425,7 @@ void userdata_variable_access_large_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "b = cl()", "userdata_variable_access_large setup");
     luaDoStringOrThrow(L, "function access_var_large() return b.var0 end", "userdata_variable_access_large closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "access_var_large");
@@ -353,6 +441,7 @@ void userdata_variable_access_last_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "b = cl()", "userdata_variable_access_last setup");
     luaDoStringOrThrow(L, "function access_var_last() return b.var49 end", "userdata_variable_access_last closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "access_var_last");
@@ -368,6 +457,7 @@ void stateful_function_object_measure(benchmark::State& state)
 
     luabridge::LuaRef f = luabridge::getGlobal(L, "f");
     double x = 0;
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         x += f.call<double>(kMagicValue).valueOr(0.0);
@@ -382,6 +472,7 @@ void multi_return_lua_measure(benchmark::State& state)
     luabridge::getGlobalNamespace(L).addFunction("f", &lb3_multi_return);
     luaDoStringOrThrow(L, "function invoke_multi() local a,b=f(24.0) return a+b end", "multi_return_lua setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "invoke_multi");
@@ -397,6 +488,7 @@ void multi_return_measure(benchmark::State& state)
     luabridge::LuaRef f = luabridge::getGlobal(L, "f");
 
     double x = 0;
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         auto result = f.call<std::tuple<double, double>>(kMagicValue).valueOr(std::make_tuple(0.0, 0.0));
@@ -429,6 +521,7 @@ void derived_base_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "obj = ComplexAB()", "base_derived setup");
     luaDoStringOrThrow(L, "function call_base() return obj:a_func() + obj:b_func() end", "base_derived closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "call_base");
@@ -443,6 +536,7 @@ void optional_success_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "warble = { value = 24.0 }", "optional_success setup");
 
     double x = 0;
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         auto result = luabridge::tryGetGlobalField<double>(L, "warble", "value");
@@ -458,6 +552,7 @@ void optional_half_failure_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "warble = { value = 'x' }", "optional_half_failure setup");
 
     double x = 0;
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         auto result = luabridge::tryGetGlobalField<double>(L, "warble", "value");
@@ -472,6 +567,7 @@ void optional_failure_measure(benchmark::State& state)
     lua_State* L = makeLua();
 
     double x = 0;
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         auto result = luabridge::tryGetGlobalField<double>(L, "warble", "value");
@@ -490,6 +586,7 @@ void return_userdata_measure(benchmark::State& state)
         .addFunction("h", &basic_get_var);
     luaDoStringOrThrow(L, "function invoke_userdata() return h(f()) end", "return_userdata setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "invoke_userdata");
@@ -505,6 +602,7 @@ void userdata_variable_write_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "b = c()", "userdata_variable_write setup");
     luaDoStringOrThrow(L, "function write_var() b.var = 24.0 end", "userdata_variable_write closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "write_var");
@@ -519,6 +617,7 @@ void userdata_property_getter_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "b = c()", "userdata_property_getter setup");
     luaDoStringOrThrow(L, "function read_getter() return b.val end", "userdata_property_getter closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "read_getter");
@@ -534,6 +633,7 @@ void userdata_property_setter_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "b = c()", "userdata_property_setter setup");
     luaDoStringOrThrow(L, "function write_setter() b.val = 24.0 end", "userdata_property_setter closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "write_setter");
@@ -548,6 +648,7 @@ void lambda_capture_measure(benchmark::State& state)
     luabridge::getGlobalNamespace(L).addFunction("f", [extra](double v) { return v + extra; });
     luaDoStringOrThrow(L, "function invoke_lambda() return f(24.0) end", "lambda_capture setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "invoke_lambda");
@@ -562,6 +663,7 @@ void shared_ptr_return_measure(benchmark::State& state)
     registerSharedObject(L);
     luaDoStringOrThrow(L, "function invoke_shared() return get_shared():get() end", "shared_ptr_return setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "invoke_shared");
@@ -577,6 +679,7 @@ void shared_ptr_pass_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "obj = SharedObject()", "shared_ptr_pass setup");
     luaDoStringOrThrow(L, "function invoke_pass_shared() return use_shared(obj) end", "shared_ptr_pass closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "invoke_pass_shared");
@@ -591,6 +694,7 @@ void static_member_function_call_measure(benchmark::State& state)
     registerCounter(L);
     luaDoStringOrThrow(L, "function invoke_static() return Counter.static_add(10, 32) end", "static_member_function setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "invoke_static");
@@ -621,6 +725,7 @@ void derived_method_call_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "obj = ComplexAB()", "derived_method setup");
     luaDoStringOrThrow(L, "function call_derived() return obj:ab_func() end", "derived_method closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "call_derived");
@@ -646,6 +751,7 @@ void implicit_inheritance_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "obj = ComplexAB()", "implicit_inheritance setup");
     luaDoStringOrThrow(L, "function test_implicit() return call_a(obj) end", "implicit_inheritance closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "test_implicit");
@@ -679,6 +785,7 @@ void converter_exact_type_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "obj = Vec3Target(1, 2, 3)", "converter_exact_type setup");
     luaDoStringOrThrow(L, "function invoke_exact() return sumVec3(obj) end", "converter_exact_type closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "invoke_exact");
@@ -694,6 +801,7 @@ void converter_phase3_value_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "obj = Vec3Source(1, 2, 3)", "converter_phase3_value setup");
     luaDoStringOrThrow(L, "function invoke_conv_value() return sumVec3(obj) end", "converter_phase3_value closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "invoke_conv_value");
@@ -709,6 +817,7 @@ void converter_phase3_ref_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "obj = Vec3Source(1, 2, 3)", "converter_phase3_ref setup");
     luaDoStringOrThrow(L, "function invoke_conv_ref() return sumVec3Ref(obj) end", "converter_phase3_ref closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "invoke_conv_ref");
@@ -724,6 +833,7 @@ void converter_multi_registered_measure(benchmark::State& state)
     luaDoStringOrThrow(L, "obj = ColorSource(0.5, 1, 0)", "converter_multi_registered setup");
     luaDoStringOrThrow(L, "function invoke_conv_multi() return sumVec3(obj) end", "converter_multi_registered closure setup");
 
+    AllocationTracker allocations(state, L);
     for ([[maybe_unused]] auto _ : state)
     {
         lua_getglobal(L, "invoke_conv_multi");
@@ -732,10 +842,415 @@ void converter_multi_registered_measure(benchmark::State& state)
     }
 }
 
+constexpr int kMapEntries = 10000;
+
+std::unordered_map<std::string, int> makeStringKeyedMap()
+{
+    std::unordered_map<std::string, int> map;
+    map.reserve(kMapEntries);
+
+    for (int i = 0; i < kMapEntries; ++i)
+        map.emplace("key" + std::to_string(i), i);
+
+    return map;
+}
+
+std::map<int, double> makeIntegerKeyedMap()
+{
+    std::map<int, double> map;
+
+    for (int i = 0; i < kMapEntries; ++i)
+        map.emplace(i * 7, i * 0.5);
+
+    return map;
+}
+
+void map_string_push_10k_measure(benchmark::State& state)
+{
+    lua_State* L = makeLua();
+    const auto map = makeStringKeyedMap();
+
+    AllocationTracker allocations(state, L);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        if (! luabridge::push(L, map))
+            return setSkipped(state, "push failed");
+
+        lua_pop(L, 1);
+    }
+
+    state.SetItemsProcessed(state.iterations() * kMapEntries);
+}
+
+void map_string_get_10k_measure(benchmark::State& state)
+{
+    lua_State* L = makeLua();
+    if (! luabridge::push(L, makeStringKeyedMap()))
+        return setSkipped(state, "push failed");
+
+    std::size_t x = 0;
+    AllocationTracker allocations(state, L);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        auto map = luabridge::get<std::unordered_map<std::string, int>>(L, -1);
+        x += map ? map->size() : 0;
+    }
+
+    benchmark::DoNotOptimize(x);
+    state.SetItemsProcessed(state.iterations() * kMapEntries);
+}
+
+void map_integer_push_10k_measure(benchmark::State& state)
+{
+    lua_State* L = makeLua();
+    const auto map = makeIntegerKeyedMap();
+
+    AllocationTracker allocations(state, L);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        if (! luabridge::push(L, map))
+            return setSkipped(state, "push failed");
+
+        lua_pop(L, 1);
+    }
+
+    state.SetItemsProcessed(state.iterations() * kMapEntries);
+}
+
+void map_integer_get_10k_measure(benchmark::State& state)
+{
+    lua_State* L = makeLua();
+    if (! luabridge::push(L, makeIntegerKeyedMap()))
+        return setSkipped(state, "push failed");
+
+    std::size_t x = 0;
+    AllocationTracker allocations(state, L);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        auto map = luabridge::get<std::map<int, double>>(L, -1);
+        x += map ? map->size() : 0;
+    }
+
+    benchmark::DoNotOptimize(x);
+    state.SetItemsProcessed(state.iterations() * kMapEntries);
+}
+
+// Marshalling of containers and value wrappers. A factory describes the marshalled type and how to build a value with a
+// number of elements: sized factories are benchmarked from 10 to 1M elements, the others marshal a single value.
+
+template <class T>
+T makeElement(int index);
+
+template <>
+int makeElement<int>(int index)
+{
+    return index;
+}
+
+template <>
+double makeElement<double>(int index)
+{
+    return index * 0.5;
+}
+
+template <>
+std::string makeElement<std::string>(int index)
+{
+    return "element" + std::to_string(index);
+}
+
+template <>
+Basic makeElement<Basic>(int index)
+{
+    Basic basic;
+    basic.var = index * 0.5;
+    return basic;
+}
+
+template <class T>
+struct VectorOf
+{
+    using Type = std::vector<T>;
+    static constexpr bool sized = true;
+
+    static Type make(int size)
+    {
+        Type result;
+        result.reserve(static_cast<std::size_t>(size));
+
+        for (int i = 0; i < size; ++i)
+            result.push_back(makeElement<T>(i));
+
+        return result;
+    }
+};
+
+template <class T, std::size_t N>
+struct ArrayOf
+{
+    using Type = std::array<T, N>;
+    static constexpr bool sized = true;
+
+    static Type make(int)
+    {
+        Type result;
+
+        for (std::size_t i = 0; i < N; ++i)
+            result[i] = makeElement<T>(static_cast<int>(i));
+
+        return result;
+    }
+};
+
+template <class T>
+struct MapOf
+{
+    using Type = std::map<int, T>;
+    static constexpr bool sized = true;
+
+    static Type make(int size)
+    {
+        Type result;
+
+        for (int i = 0; i < size; ++i)
+            result.emplace(i, makeElement<T>(i));
+
+        return result;
+    }
+};
+
+template <class T>
+struct UnorderedMapOf
+{
+    using Type = std::unordered_map<int, T>;
+    static constexpr bool sized = true;
+
+    static Type make(int size)
+    {
+        Type result;
+        result.reserve(static_cast<std::size_t>(size));
+
+        for (int i = 0; i < size; ++i)
+            result.emplace(i, makeElement<T>(i));
+
+        return result;
+    }
+};
+
+template <class T>
+struct SetOf
+{
+    using Type = std::set<T>;
+    static constexpr bool sized = true;
+
+    static Type make(int size)
+    {
+        Type result;
+
+        for (int i = 0; i < size; ++i)
+            result.insert(makeElement<T>(i));
+
+        return result;
+    }
+};
+
+template <class T>
+struct OptionalOf
+{
+    using Type = std::optional<T>;
+    static constexpr bool sized = false;
+
+    static Type make(int)
+    {
+        return makeElement<T>(42);
+    }
+};
+
+template <class T>
+struct VariantOf
+{
+    using Type = std::variant<int, double, std::string, Basic>;
+    static constexpr bool sized = false;
+
+    static Type make(int)
+    {
+        return makeElement<T>(42);
+    }
+};
+
+struct TupleOfAll
+{
+    using Type = std::tuple<int, double, std::string, Basic>;
+    static constexpr bool sized = false;
+
+    static Type make(int)
+    {
+        return { makeElement<int>(42), makeElement<double>(42), makeElement<std::string>(42), makeElement<Basic>(42) };
+    }
+};
+
+template <class Factory>
+int marshallingElements(const benchmark::State& state)
+{
+    if constexpr (Factory::sized)
+        return static_cast<int>(state.range(0));
+    else
+        return 1;
+}
+
+template <class Factory>
+void marshalling_push_measure(benchmark::State& state)
+{
+    const ScopedLua lua(makeLua());
+    lua_State* L = lua.get();
+    registerBasic(L);
+
+    const int elements = marshallingElements<Factory>(state);
+    const typename Factory::Type value = Factory::make(elements);
+
+    AllocationTracker allocations(state, L);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        if (! luabridge::push(L, value))
+            return setSkipped(state, "push failed");
+
+        lua_pop(L, 1);
+    }
+
+    state.SetItemsProcessed(state.iterations() * elements);
+}
+
+template <class Factory>
+void marshalling_get_measure(benchmark::State& state)
+{
+    const ScopedLua lua(makeLua());
+    lua_State* L = lua.get();
+    registerBasic(L);
+
+    const int elements = marshallingElements<Factory>(state);
+    if (! luabridge::push(L, Factory::make(elements)))
+        return setSkipped(state, "push failed");
+
+    AllocationTracker allocations(state, L);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        auto value = luabridge::get<typename Factory::Type>(L, -1);
+        if (! value)
+            return setSkipped(state, "get failed");
+
+        benchmark::DoNotOptimize(value);
+    }
+
+    state.SetItemsProcessed(state.iterations() * elements);
+}
+
+template <class Factory>
+void marshalling_roundtrip_measure(benchmark::State& state)
+{
+    const ScopedLua lua(makeLua());
+    lua_State* L = lua.get();
+    registerBasic(L);
+
+    const int elements = marshallingElements<Factory>(state);
+    typename Factory::Type value = Factory::make(elements);
+
+    AllocationTracker allocations(state, L);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        if (! luabridge::push(L, value))
+            return setSkipped(state, "push failed");
+
+        auto result = luabridge::get<typename Factory::Type>(L, -1);
+        if (! result)
+            return setSkipped(state, "get failed");
+
+        lua_pop(L, 1);
+        value = std::move(*result);
+    }
+
+    benchmark::DoNotOptimize(value);
+    state.SetItemsProcessed(state.iterations() * elements);
+}
+
+luabridge::LuaRef makeSequence(lua_State* L, int size)
+{
+    luabridge::LuaRef table = luabridge::newTable(L);
+
+    for (int i = 1; i <= size; ++i)
+        table[i] = i;
+
+    return table;
+}
+
+void luaref_pairs_iteration_measure(benchmark::State& state)
+{
+    const ScopedLua lua(makeLua());
+    lua_State* L = lua.get();
+    const int elements = static_cast<int>(state.range(0));
+    const luabridge::LuaRef table = makeSequence(L, elements);
+
+    lua_Integer x = 0;
+    AllocationTracker allocations(state, L);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        for (const auto& [key, value] : luabridge::pairs(table))
+            x += value.unsafe_cast<lua_Integer>();
+    }
+
+    benchmark::DoNotOptimize(x);
+    state.SetItemsProcessed(state.iterations() * elements);
+}
+
+void luaref_index_iteration_measure(benchmark::State& state)
+{
+    const ScopedLua lua(makeLua());
+    lua_State* L = lua.get();
+    const int elements = static_cast<int>(state.range(0));
+    const luabridge::LuaRef table = makeSequence(L, elements);
+
+    lua_Integer x = 0;
+    AllocationTracker allocations(state, L);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        const int length = table.length();
+        for (int i = 1; i <= length; ++i)
+            x += table[i].unsafe_cast<lua_Integer>();
+    }
+
+    benchmark::DoNotOptimize(x);
+    state.SetItemsProcessed(state.iterations() * elements);
+}
+
+void luaref_append_measure(benchmark::State& state)
+{
+    const ScopedLua lua(makeLua());
+    lua_State* L = lua.get();
+    const int elements = static_cast<int>(state.range(0));
+
+    AllocationTracker allocations(state, L);
+    for ([[maybe_unused]] auto _ : state)
+    {
+        luabridge::LuaRef table = luabridge::newTable(L);
+
+        for (int i = 0; i < elements; ++i)
+        {
+            if (! table.append(i))
+                return setSkipped(state, "append failed");
+        }
+
+        benchmark::DoNotOptimize(table);
+    }
+
+    state.SetItemsProcessed(state.iterations() * elements);
+}
+
 } // namespace
 
 BENCHMARK(table_global_string_get_measure)->Name("table_global_string_get_measure");
 BENCHMARK(table_global_string_set_measure)->Name("table_global_string_set_measure");
+BENCHMARK(global_handle_get_measure)->Name("global_handle_get_measure");
+BENCHMARK_TEMPLATE(global_handle_vector_get_measure, false)->Name("global_handle_vector_get_measure")->Arg(100);
+BENCHMARK_TEMPLATE(global_handle_vector_get_measure, true)->Name("global_handle_cached_vector_get_measure")->Arg(100);
 BENCHMARK(table_get_measure)->Name("table_get_measure");
 BENCHMARK(table_set_measure)->Name("table_set_measure");
 BENCHMARK(table_chained_get_measure)->Name("table_chained_get_measure");
@@ -768,3 +1283,57 @@ BENCHMARK(converter_exact_type_measure)->Name("converter_exact_type_measure");
 BENCHMARK(converter_phase3_value_measure)->Name("converter_phase3_value_measure");
 BENCHMARK(converter_phase3_ref_measure)->Name("converter_phase3_ref_measure");
 BENCHMARK(converter_multi_registered_measure)->Name("converter_multi_registered_measure");
+BENCHMARK(map_string_push_10k_measure)->Name("map_string_push_10k_measure");
+BENCHMARK(map_string_get_10k_measure)->Name("map_string_get_10k_measure");
+BENCHMARK(map_integer_push_10k_measure)->Name("map_integer_push_10k_measure");
+BENCHMARK(map_integer_get_10k_measure)->Name("map_integer_get_10k_measure");
+
+#define LUABRIDGE_BENCHMARK_MARSHALLING(factory, name) \
+    BENCHMARK_TEMPLATE(marshalling_push_measure, factory)->Name(name "_push_measure"); \
+    BENCHMARK_TEMPLATE(marshalling_get_measure, factory)->Name(name "_get_measure"); \
+    BENCHMARK_TEMPLATE(marshalling_roundtrip_measure, factory)->Name(name "_roundtrip_measure")
+
+#define LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(factory, name) \
+    BENCHMARK_TEMPLATE(marshalling_push_measure, factory)->Name(name "_push_measure")->RangeMultiplier(100)->Range(10, 1000000); \
+    BENCHMARK_TEMPLATE(marshalling_get_measure, factory)->Name(name "_get_measure")->RangeMultiplier(100)->Range(10, 1000000); \
+    BENCHMARK_TEMPLATE(marshalling_roundtrip_measure, factory)->Name(name "_roundtrip_measure")->RangeMultiplier(100)->Range(10, 1000000)
+
+#define LUABRIDGE_BENCHMARK_MARSHALLING_ARRAY(type, name) \
+    BENCHMARK_TEMPLATE(marshalling_push_measure, ArrayOf<type, 10>)->Name(name "_push_measure")->Arg(10); \
+    BENCHMARK_TEMPLATE(marshalling_push_measure, ArrayOf<type, 1000>)->Name(name "_push_measure")->Arg(1000); \
+    BENCHMARK_TEMPLATE(marshalling_get_measure, ArrayOf<type, 10>)->Name(name "_get_measure")->Arg(10); \
+    BENCHMARK_TEMPLATE(marshalling_get_measure, ArrayOf<type, 1000>)->Name(name "_get_measure")->Arg(1000); \
+    BENCHMARK_TEMPLATE(marshalling_roundtrip_measure, ArrayOf<type, 10>)->Name(name "_roundtrip_measure")->Arg(10); \
+    BENCHMARK_TEMPLATE(marshalling_roundtrip_measure, ArrayOf<type, 1000>)->Name(name "_roundtrip_measure")->Arg(1000)
+
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(VectorOf<int>, "vector_int");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(VectorOf<double>, "vector_double");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(VectorOf<std::string>, "vector_string");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(VectorOf<Basic>, "vector_userdata");
+LUABRIDGE_BENCHMARK_MARSHALLING_ARRAY(int, "array_int");
+LUABRIDGE_BENCHMARK_MARSHALLING_ARRAY(double, "array_double");
+LUABRIDGE_BENCHMARK_MARSHALLING_ARRAY(std::string, "array_string");
+LUABRIDGE_BENCHMARK_MARSHALLING_ARRAY(Basic, "array_userdata");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(MapOf<int>, "map_int");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(MapOf<double>, "map_double");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(MapOf<std::string>, "map_string");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(MapOf<Basic>, "map_userdata");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(UnorderedMapOf<int>, "unordered_map_int");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(UnorderedMapOf<double>, "unordered_map_double");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(UnorderedMapOf<std::string>, "unordered_map_string");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(UnorderedMapOf<Basic>, "unordered_map_userdata");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(SetOf<int>, "set_int");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(SetOf<double>, "set_double");
+LUABRIDGE_BENCHMARK_MARSHALLING_SIZED(SetOf<std::string>, "set_string");
+LUABRIDGE_BENCHMARK_MARSHALLING(OptionalOf<int>, "optional_int");
+LUABRIDGE_BENCHMARK_MARSHALLING(OptionalOf<double>, "optional_double");
+LUABRIDGE_BENCHMARK_MARSHALLING(OptionalOf<std::string>, "optional_string");
+LUABRIDGE_BENCHMARK_MARSHALLING(OptionalOf<Basic>, "optional_userdata");
+LUABRIDGE_BENCHMARK_MARSHALLING(VariantOf<int>, "variant_int");
+LUABRIDGE_BENCHMARK_MARSHALLING(VariantOf<double>, "variant_double");
+LUABRIDGE_BENCHMARK_MARSHALLING(VariantOf<std::string>, "variant_string");
+LUABRIDGE_BENCHMARK_MARSHALLING(VariantOf<Basic>, "variant_userdata");
+LUABRIDGE_BENCHMARK_MARSHALLING(TupleOfAll, "tuple_mixed");
+BENCHMARK(luaref_pairs_iteration_measure)->Name("luaref_pairs_iteration_measure")->RangeMultiplier(100)->Range(10, 1000000);
+BENCHMARK(luaref_index_iteration_measure)->Name("luaref_index_iteration_measure")->RangeMultiplier(100)->Range(10, 1000000);
+BENCHMARK(luaref_append_measure)->Name("luaref_append_measure")->RangeMultiplier(100)->Range(10, 1000000);
@@ -4,6 +4,7 @@
 
 import argparse
 import json
+import re
 from collections import defaultdict
 from pathlib import Path
 
@@ -17,9 +18,12 @@ import numpy as np
 _SUFFIX = "_measure"
 
 def _clean_label(name: str) -> str:
+    # Parameterised benchmarks are named "<case>_measure/<size>"
+    name, _, args = name.partition("/")
     if name.endswith(_SUFFIX):
         name = name[: -len(_SUFFIX)]
-    return name.replace("_", " ")
+    label = name.replace("_", " ")
+    return f"{label} ({args.replace('/', ', ')})" if args else label
 
 
 # ── JSON loading ──────────────────────────────────────────────────────────────
@@ -28,6 +32,14 @@ def infer_library_name(path: str) -> str:
     return Path(path).stem.replace("benchmark_", "")
 
 
+def infer_runtime_name(path: str, result: dict) -> str:
+    # Reported by the LuaBridge3Benchmark_<runtime> executables, otherwise taken from the file name
+    if result.get("runtime"):
+        return result["runtime"]
+    stem = infer_library_name(path)
+    return stem.rsplit("_", 1)[-1] if "_" in stem else stem
+
+
 def load_google_benchmark_json(path: str, library_name: str) -> dict:
     with open(path, "r", encoding="utf-8") as f:
         data = json.load(f)
@@ -61,7 +73,9 @@ def load_google_benchmark_json(path: str, library_name: str) -> dict:
         if name not in case_values:
             case_values[name] = entry.get("real_time", entry.get("cpu_time", 0.0))
 
-    return {"library": library_name, "values": case_values, "stddev": case_stddev, "errors": case_errors}
+    runtime = data.get("context", {}).get("lua_runtime")
+
+    return {"library": library_name, "runtime": runtime, "values": case_values, "stddev": case_stddev, "errors": case_errors}
 
 
 # ── Merge ─────────────────────────────────────────────────────────────────────
@@ -108,10 +122,12 @@ _LIB_ORDER = ["LuaBridge3Benchmark", "LuaBridgeVanillaBenchmark", "Sol3Benchmark
 _LIB_ORDER_MAP = {lib: i for i, lib in enumerate(_LIB_ORDER)}
 
 
-def plot_grouped_bars(merged: dict, stddev: dict, errors: dict, output_file: str, log_scale: bool = False) -> None:
+def plot_grouped_bars(merged: dict, stddev: dict, errors: dict, output_file: str, log_scale: bool = False,
+                      order: list = None, title: str = "Lua Binding Benchmarks") -> None:
     case_names = sorted(merged.keys())
     all_libs = {lib for cases in merged.values() for lib in cases}
-    libraries = sorted(all_libs, key=lambda l: _LIB_ORDER_MAP.get(l, len(_LIB_ORDER)))
+    order_map = {lib: i for i, lib in enumerate(order)} if order else _LIB_ORDER_MAP
+    libraries = sorted(all_libs, key=lambda l: order_map.get(l, len(order_map)))
 
     if not case_names or not libraries:
         raise RuntimeError("No benchmark samples found to plot")
@@ -219,7 +235,7 @@ def plot_grouped_bars(merged: dict, stddev: dict, errors: dict, output_file: str
             labelcolor=_FG,
         )
         ax.set_title(
-            "Lua Binding Benchmarks — lower is better (ns)",
+            f"{title} — lower is better (ns)",
             fontsize=16, pad=10, fontweight="bold", color=_FG,
         )
 
@@ -246,6 +262,33 @@ def plot_grouped_bars(merged: dict, stddev: dict, errors: dict, output_file: str
     print(f"Saved: {txt_file}")
 
 
+def write_relative_summary(merged: dict, runtimes: list, baseline: str, output_file: str) -> None:
+    """Write each runtime time as a ratio of the baseline runtime, to spot binding paths regressing on a given VM."""
+    case_names = sorted(merged.keys())
+    clean_labels = [_clean_label(cn) for cn in case_names]
+
+    txt_file = Path(output_file).with_name(Path(output_file).stem + "_relative.txt")
+    col_w = max(len(rt) for rt in runtimes) + 2
+    label_w = max(len(lbl) for lbl in clean_labels) + 2
+
+    with open(txt_file, "w", encoding="utf-8") as f:
+        f.write(f"Relative to {baseline} (> 1.00 is slower)\n\n")
+        header = f"{'Benchmark':<{label_w}}" + "".join(f"{rt:>{col_w}}" for rt in runtimes)
+        f.write(header + "\n")
+        f.write("-" * len(header) + "\n")
+        for cn, lbl in zip(case_names, clean_labels):
+            reference = merged[cn].get(baseline)
+            row = f"{lbl:<{label_w}}"
+            for rt in runtimes:
+                val = merged[cn].get(rt)
+                if val is None or not reference:
+                    row += f"{'n/a':>{col_w}}"
+                else:
+                    row += f"{val / reference:>{col_w - 1}.2f}x"
+            f.write(row + "\n")
+    print(f"Saved: {txt_file}")
+
+
 # ── Entry point ───────────────────────────────────────────────────────────────
 
 def main():
@@ -264,6 +307,18 @@ def main():
         "--log", action="store_true",
         help="Use a logarithmic x-axis"
     )
+    parser.add_argument(
+        "--filter",
+        help="Only plot the benchmarks whose name matches this regular expression (e.g. '^vector_')"
+    )
+    parser.add_argument(
+        "--runtimes", action="store_true",
+        help="Combined report of LuaBridge3Benchmark_<runtime> results: one series per Lua runtime"
+    )
+    parser.add_argument(
+        "--baseline",
+        help="Runtime the others are compared to in the relative summary (default: the first input)"
+    )
     args = parser.parse_args()
 
     result_sets = [
@@ -271,12 +326,30 @@ def main():
         for path in args.input
     ]
 
+    order = None
+    title = "Lua Binding Benchmarks"
+    if args.runtimes:
+        for path, result in zip(args.input, result_sets):
+            result["library"] = infer_runtime_name(path, result)
+        order = [result["library"] for result in result_sets]
+        title = "LuaBridge3 Across Lua Runtimes"
+
     merged, stddev, errors = merge_results(result_sets)
 
+    if args.filter:
+        pattern = re.compile(args.filter)
+        merged = {cn: libs for cn, libs in merged.items() if pattern.search(cn)}
+
     Path(args.output).parent.mkdir(parents=True, exist_ok=True)
-    plot_grouped_bars(merged, stddev, errors, args.output, log_scale=args.log)
+    plot_grouped_bars(merged, stddev, errors, args.output, log_scale=args.log, order=order, title=title)
     print(f"Saved: {args.output}")
 
+    if args.runtimes:
+        baseline = args.baseline or order[0]
+        if baseline not in order:
+            parser.error(f"unknown baseline runtime '{baseline}', expected one of: {', '.join(order)}")
+        write_relative_summary(merged, order, baseline, args.output)
+
 
 if __name__ == "__main__":
     main()
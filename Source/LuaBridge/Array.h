@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "detail/Containers.h"
 #include "detail/Stack.h"
 
 #include <array>
@@ -57,19 +58,14 @@ struct Stack<std::array<T, Size>>
 
         Type array;
 
-        int absIndex = lua_absindex(L, index);
-        lua_pushnil(L);
-
-        int arrayIndex = 0;
-        while (lua_next(L, absIndex) != 0)
+        std::size_t arrayIndex = 0;
+        auto result = detail::decode_sequence<T, true>(L, lua_absindex(L, index), static_cast<int>(Size), [&array, &arrayIndex](auto&& value)
         {
-            auto item = Stack<T>::get(L, -1);
-            if (!item)
-                return makeErrorCode(ErrorCode::InvalidTypeCast);
+            array[arrayIndex++] = std::forward<decltype(value)>(value);
+        });
 
-            array[arrayIndex++] = *item;
-            lua_pop(L, 1);
-        }
+        if (! result)
+            return result.error();
 
         return array;
     }
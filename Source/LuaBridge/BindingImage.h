@@ -0,0 +1,717 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "detail/Config.h"
+#include "detail/Errors.h"
+#include "detail/Globals.h"
+#include "detail/LuaHelpers.h"
+#include "detail/Result.h"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace luabridge {
+namespace detail {
+
+//=================================================================================================
+/**
+ * @brief Instruction of a binding image, operating on the Lua stack of the state the image is applied to.
+ */
+struct BindingInstruction
+{
+    enum class Code : unsigned char
+    {
+        Nil,           ///< Push nil.
+        Boolean,       ///< Push the boolean `count`.
+        Integer,       ///< Push `value.integer`.
+        Number,        ///< Push `value.number`.
+        String,        ///< Push `count` bytes of the string pool starting at `value.offset`.
+        LightUserdata, ///< Push `value.pointer`.
+        Table,         ///< Create a table presized to `count` array and `extra` hash slots, stored in slot `slot`.
+        CClosure,      ///< Pop `count` upvalues and push a closure of `value.function` named after the string pool at `extra`, stored in slot `slot`.
+        Slot,          ///< Push the value of slot `slot`.
+        Globals,       ///< Push the globals table.
+        Registry,      ///< Push the registry table.
+        Thread,        ///< Push the thread the image is applied with.
+        RawSet,        ///< Pop a key and a value, and set them in the table below them.
+        SetMetatable,  ///< Pop a table and set it as metatable of the value below it.
+        Pop            ///< Pop a value.
+    };
+
+    Code code = Code::Nil;
+    int count = 0;
+    int extra = 0;
+    int slot = 0;
+
+    union
+    {
+        lua_Integer integer;
+        lua_Number number;
+        std::size_t offset;
+        void* pointer;
+        lua_CFunction function;
+    } value{};
+};
+
+//=================================================================================================
+/**
+ * @brief Record the globals and registry entries added by a registration into binding image instructions.
+ */
+class BindingRecorder
+{
+public:
+    explicit BindingRecorder(lua_State* L)
+        : L(L)
+    {
+    }
+
+    /**
+     * @brief Push shallow copies of the globals and the registry, and the current metatable of the globals.
+     */
+    void snapshot()
+    {
+        detail::push_globals_table(L);
+        m_globalsIndex = lua_gettop(L);
+
+        lua_pushvalue(L, LUA_REGISTRYINDEX);
+        m_registryIndex = lua_gettop(L);
+
+        m_globalsCopyIndex = pushShallowCopy(m_globalsIndex);
+        m_registryCopyIndex = pushShallowCopy(m_registryIndex);
+
+        if (! lua_getmetatable(L, m_globalsIndex))
+            lua_pushnil(L);
+
+        m_globalsMetatableIndex = lua_gettop(L);
+
+        lua_newtable(L);
+        m_tablesIndex = lua_gettop(L);
+    }
+
+    /**
+     * @brief Record the entries changed since the snapshot, and the tables reachable from them.
+     */
+    Result record()
+    {
+        m_output = &m_assignments;
+
+        emit(BindingInstruction::Code::Globals);
+
+        auto result = recordChanges(m_globalsIndex, m_globalsCopyIndex, false);
+        if (! result)
+            return result;
+
+        if (! lua_getmetatable(L, m_globalsIndex))
+            lua_pushnil(L);
+
+        if (! lua_rawequal(L, -1, m_globalsMetatableIndex))
+        {
+            result = encode(lua_gettop(L));
+            if (! result)
+                return result;
+
+            emit(BindingInstruction::Code::SetMetatable);
+        }
+
+        lua_pop(L, 1);
+        emit(BindingInstruction::Code::Pop);
+
+        emit(BindingInstruction::Code::Registry);
+
+        result = recordChanges(m_registryIndex, m_registryCopyIndex, true);
+        if (! result)
+            return result;
+
+        emit(BindingInstruction::Code::Pop);
+
+        // Tables found while recording are filled afterwards, which also discovers more tables to fill
+        m_output = &m_contents;
+
+        for (std::size_t index = 0; index < m_pendingTables.size(); ++index)
+        {
+            result = recordTable(m_pendingTables[index]);
+            if (! result)
+                return result;
+        }
+
+        return {};
+    }
+
+    /**
+     * @brief Move the recorded instructions out, in the order they have to be applied.
+     *
+     * All the tables are created first and get their metatables while still empty, as registration does: Lua 5.2+ only
+     * finalizes tables whose metatable has a `__gc` field when it is set, which is never intended for binding tables.
+     */
+    std::vector<BindingInstruction> instructions()
+    {
+        std::vector<BindingInstruction> result;
+        result.reserve(m_tables.size() + m_metatables.size() + m_assignments.size() + m_contents.size());
+
+        for (auto* stream : { &m_tables, &m_metatables, &m_assignments, &m_contents })
+            result.insert(result.end(), stream->begin(), stream->end());
+
+        return result;
+    }
+
+    std::string strings()
+    {
+        return std::move(m_strings);
+    }
+
+    int slots() const noexcept
+    {
+        return m_slotCount;
+    }
+
+    int maxDepth() const noexcept
+    {
+        return m_maxDepth;
+    }
+
+private:
+    int pushShallowCopy(int index)
+    {
+        lua_newtable(L);
+
+        lua_pushnil(L);
+        while (lua_next(L, index) != 0)
+        {
+            lua_pushvalue(L, -2);
+            lua_insert(L, -2);
+            lua_rawset(L, -4);
+        }
+
+        return lua_gettop(L);
+    }
+
+    Result recordChanges(int index, int copyIndex, bool isRegistry)
+    {
+        lua_pushnil(L);
+        while (lua_next(L, index) != 0) // Stack: ..., key, value
+        {
+            const int keyIndex = lua_gettop(L) - 1;
+
+            // Integer keys of the registry are references and reserved slots, which are specific to each state
+            const int keyType = lua_type(L, keyIndex);
+            if (isRegistry && keyType != LUA_TSTRING && keyType != LUA_TLIGHTUSERDATA)
+            {
+                lua_pop(L, 1);
+                continue;
+            }
+
+            lua_pushvalue(L, keyIndex);
+            lua_rawget(L, copyIndex); // Stack: ..., key, value, previous value
+            const bool isUnchanged = lua_rawequal(L, -1, -2);
+            lua_pop(L, 1);
+
+            if (! isUnchanged)
+            {
+                auto result = encodePair(keyIndex);
+                if (! result)
+                {
+                    lua_pop(L, 2);
+                    return result;
+                }
+            }
+
+            lua_pop(L, 1); // Stack: ..., key
+        }
+
+        return {};
+    }
+
+    Result recordTable(int slot)
+    {
+        lua_rawgeti(L, m_tablesIndex, slot); // Stack: ..., table
+        const int index = lua_gettop(L);
+
+        emit(BindingInstruction::Code::Slot).slot = slot;
+
+        lua_pushnil(L);
+        while (lua_next(L, index) != 0) // Stack: ..., table, key, value
+        {
+            auto result = encodePair(index + 1);
+            if (! result)
+            {
+                lua_pop(L, 3);
+                return result;
+            }
+
+            lua_pop(L, 1); // Stack: ..., table, key
+        }
+
+        emit(BindingInstruction::Code::Pop);
+
+        if (lua_getmetatable(L, index)) // Stack: ..., table, metatable
+        {
+            m_output = &m_metatables;
+
+            emit(BindingInstruction::Code::Slot).slot = slot;
+            auto result = encode(index + 1);
+            emit(BindingInstruction::Code::SetMetatable);
+            emit(BindingInstruction::Code::Pop);
+
+            m_output = &m_contents;
+
+            lua_pop(L, 1);
+
+            if (! result)
+            {
+                lua_pop(L, 1);
+                return result;
+            }
+        }
+
+        lua_pop(L, 1);
+        return {};
+    }
+
+    Result encodePair(int keyIndex)
+    {
+        auto result = encode(keyIndex);
+        if (result)
+            result = encode(keyIndex + 1);
+
+        if (result)
+            emit(BindingInstruction::Code::RawSet);
+
+        return result;
+    }
+
+    Result encode(int index)
+    {
+        if (! lua_checkstack(L, 3))
+            return makeErrorCode(ErrorCode::LuaStackOverflow);
+
+        switch (lua_type(L, index))
+        {
+        case LUA_TNIL:
+            emit(BindingInstruction::Code::Nil);
+            return {};
+
+        case LUA_TBOOLEAN:
+            emit(BindingInstruction::Code::Boolean).count = lua_toboolean(L, index);
+            return {};
+
+        case LUA_TNUMBER:
+#if LUA_VERSION_NUM >= 503 && ! LUABRIDGE_ON_LUAU
+            if (lua_isinteger(L, index))
+            {
+                emit(BindingInstruction::Code::Integer).value.integer = lua_tointeger(L, index);
+                return {};
+            }
+#endif
+
+            emit(BindingInstruction::Code::Number).value.number = lua_tonumber(L, index);
+            return {};
+
+        case LUA_TSTRING:
+        {
+            std::size_t length = 0;
+            const char* string = lua_tolstring(L, index, &length);
+
+            auto& instruction = emit(BindingInstruction::Code::String);
+            instruction.count = static_cast<int>(length);
+            instruction.value.offset = m_strings.size();
+
+            m_strings.append(string, length);
+            return {};
+        }
+
+        case LUA_TLIGHTUSERDATA:
+            emit(BindingInstruction::Code::LightUserdata).value.pointer = lua_touserdata(L, index);
+            return {};
+
+        case LUA_TTABLE:
+            encodeTable(index);
+            return {};
+
+        case LUA_TFUNCTION:
+            return encodeFunction(index);
+
+        case LUA_TTHREAD:
+            // The recording thread stands for the thread applying the image, other threads belong to the recording state
+            if (lua_tothread(L, index) != L)
+                return makeErrorCode(ErrorCode::ValueNotTransferable);
+
+            emit(BindingInstruction::Code::Thread);
+            return {};
+
+        default:
+            return makeErrorCode(ErrorCode::ValueNotTransferable);
+        }
+    }
+
+    void encodeTable(int index)
+    {
+        if (lua_rawequal(L, index, m_globalsIndex))
+        {
+            emit(BindingInstruction::Code::Globals);
+            return;
+        }
+
+        if (lua_rawequal(L, index, m_registryIndex))
+        {
+            emit(BindingInstruction::Code::Registry);
+            return;
+        }
+
+        const void* identity = lua_topointer(L, index);
+
+        auto it = m_slots.find(identity);
+        if (it == m_slots.end())
+        {
+            const int arraySize = get_length(L, index);
+
+            int count = 0;
+            lua_pushnil(L);
+            while (lua_next(L, index) != 0)
+            {
+                ++count;
+                lua_pop(L, 1);
+            }
+
+            const int slot = ++m_slotCount;
+            it = m_slots.emplace(identity, slot).first;
+
+            auto& instruction = m_tables.emplace_back();
+            instruction.code = BindingInstruction::Code::Table;
+            instruction.count = arraySize;
+            instruction.extra = count > arraySize ? count - arraySize : 0;
+            instruction.slot = slot;
+
+            lua_pushvalue(L, index);
+            lua_rawseti(L, m_tablesIndex, slot);
+
+            m_pendingTables.push_back(slot);
+        }
+
+        emit(BindingInstruction::Code::Slot).slot = it->second;
+    }
+
+    Result encodeFunction(int index)
+    {
+        // Lua functions would need their bytecode and upvalues, only C functions are stateless enough to be recorded
+        if (! lua_iscfunction(L, index))
+            return makeErrorCode(ErrorCode::ValueNotTransferable);
+
+        const void* identity = lua_topointer(L, index);
+
+        const auto it = m_slots.find(identity);
+        if (it != m_slots.end())
+        {
+            // A closure being recorded can't be an upvalue of itself, as upvalues are created before the closure
+            if (it->second == 0)
+                return makeErrorCode(ErrorCode::ValueNotTransferable);
+
+            emit(BindingInstruction::Code::Slot).slot = it->second;
+            return {};
+        }
+
+        m_slots.emplace(identity, 0);
+
+        int upvalues = 0;
+        while (lua_getupvalue(L, index, upvalues + 1) != nullptr)
+        {
+            ++upvalues;
+
+            auto result = encode(lua_gettop(L));
+            lua_pop(L, 1);
+
+            if (! result)
+                return result;
+        }
+
+        // The closure replaces its upvalues on the stack
+        m_depth -= upvalues;
+
+        const int slot = ++m_slotCount;
+        m_slots[identity] = slot;
+
+        auto& instruction = emit(BindingInstruction::Code::CClosure);
+        instruction.count = upvalues;
+        instruction.extra = recordName(index);
+        instruction.value.function = lua_tocfunction(L, index);
+        instruction.slot = slot;
+
+        return {};
+    }
+
+    int recordName(int index)
+    {
+        const char* name = nullptr;
+
+#if LUABRIDGE_ON_LUAU
+        // Only Luau keeps the debug name of C closures, a negative level is the stack index of the function
+        lua_Debug debug;
+        if (lua_getinfo(L, index - lua_gettop(L) - 1, "n", &debug) != 0)
+            name = debug.name;
+#else
+        unused(index);
+#endif
+
+        if (name == nullptr || *name == '\0')
+            return -1;
+
+        const auto offset = static_cast<int>(m_strings.size());
+        m_strings.append(name);
+        m_strings.push_back('\0');
+        return offset;
+    }
+
+    BindingInstruction& emit(BindingInstruction::Code code)
+    {
+        switch (code)
+        {
+        case BindingInstruction::Code::RawSet:
+            m_depth -= 2;
+            break;
+
+        case BindingInstruction::Code::SetMetatable:
+        case BindingInstruction::Code::Pop:
+            m_depth -= 1;
+            break;
+
+        default:
+            m_depth += 1;
+            break;
+        }
+
+        if (m_depth > m_maxDepth)
+            m_maxDepth = m_depth;
+
+        auto& instruction = m_output->emplace_back();
+        instruction.code = code;
+        return instruction;
+    }
+
+    lua_State* L;
+
+    std::vector<BindingInstruction> m_tables;
+    std::vector<BindingInstruction> m_metatables;
+    std::vector<BindingInstruction> m_assignments;
+    std::vector<BindingInstruction> m_contents;
+    std::vector<BindingInstruction>* m_output = &m_assignments;
+    std::string m_strings;
+
+    std::unordered_map<const void*, int> m_slots;
+    std::vector<int> m_pendingTables;
+    int m_slotCount = 0;
+
+    int m_globalsIndex = 0;
+    int m_registryIndex = 0;
+    int m_globalsCopyIndex = 0;
+    int m_registryCopyIndex = 0;
+    int m_globalsMetatableIndex = 0;
+    int m_tablesIndex = 0;
+
+    int m_depth = 0;
+    int m_maxDepth = 0;
+};
+
+} // namespace detail
+
+//=================================================================================================
+/**
+ * @brief Compact image of the bindings registered by a setup function, to replay them quickly on new Lua states.
+ *
+ * Recording runs the setup function once on a private Lua state, then stores the globals and registry entries it added as a flat
+ * list of instructions: presized tables, C closures with their upvalues, strings and numbers, with shared references and cycles
+ * kept through slots. Applying the image executes the instructions in a single loop, without going through the registration
+ * templates again, which makes it suitable to bring up many short lived states (sandboxes, workers).
+ *
+ * Bindings are recorded as long as they only involve Lua tables, values and C functions whose upvalues are recordable too: free
+ * and member function pointers, data member pointers and constructors are, while functors and lambdas (stored as userdata) and
+ * Lua functions are not. The setup function should only register bindings: standard libraries and `enableExceptions` still have
+ * to be set up on each state.
+ *
+ * An image is immutable once recorded, and can be applied concurrently to different states from several threads.
+ *
+ * Example:
+ * @code
+ * auto image = luabridge::BindingImage::record([](lua_State* L)
+ * {
+ *     luabridge::getGlobalNamespace(L)
+ *         .beginClass<Vec2>("Vec2")
+ *             ...
+ *         .endClass();
+ * });
+ *
+ * lua_State* sandbox = luaL_newstate();
+ * luaL_openlibs(sandbox);
+ * image->apply(sandbox);
+ * @endcode
+ */
+class BindingImage
+{
+public:
+    using Setup = std::function<void(lua_State*)>;
+
+    /**
+     * @brief Construct an empty image.
+     */
+    BindingImage() = default;
+
+    /**
+     * @brief Record the bindings registered by a setup function.
+     *
+     * @param setup The functor registering bindings on the state it is passed.
+     *
+     * @returns The image, or an error if one of the registered values can't be recorded.
+     */
+    [[nodiscard]] static TypeResult<BindingImage> record(const Setup& setup)
+    {
+        std::unique_ptr<lua_State, decltype(&lua_close)> state(luaL_newstate(), &lua_close);
+        lua_State* L = state.get();
+
+        // Registrations start from the `_G` global, which is defined by the base library
+        detail::push_globals_table(L);
+        lua_setglobal(L, "_G");
+
+        detail::BindingRecorder recorder(L);
+        recorder.snapshot();
+
+        const int top = lua_gettop(L);
+
+        if (setup)
+            setup(L);
+
+        lua_settop(L, top);
+
+        auto result = recorder.record();
+        if (! result)
+            return result.error();
+
+        BindingImage image;
+        image.m_instructions = recorder.instructions();
+        image.m_strings = recorder.strings();
+        image.m_slots = recorder.slots();
+        image.m_maxDepth = recorder.maxDepth();
+        return image;
+    }
+
+    /**
+     * @brief Register the recorded bindings in a Lua state.
+     *
+     * Recorded entries are assigned, not merged: a global or registry entry already present in the state with the same key is
+     * replaced, so a namespace or class registered before applying the image loses the members it had. Apply images to fresh
+     * states, before any other registration.
+     *
+     * @param L A Lua state, usually freshly created.
+     *
+     * @returns An error if the stack can't grow enough to apply the image.
+     */
+    Result apply(lua_State* L) const
+    {
+        if (! lua_checkstack(L, m_maxDepth + 2))
+            return makeErrorCode(ErrorCode::LuaStackOverflow);
+
+        const StackRestore stackRestore(L);
+
+        lua_createtable(L, m_slots, 0);
+        const int slotsIndex = lua_gettop(L);
+
+        for (const auto& instruction : m_instructions)
+        {
+            switch (instruction.code)
+            {
+            case detail::BindingInstruction::Code::Nil:
+                lua_pushnil(L);
+                break;
+
+            case detail::BindingInstruction::Code::Boolean:
+                lua_pushboolean(L, instruction.count);
+                break;
+
+            case detail::BindingInstruction::Code::Integer:
+                lua_pushinteger(L, instruction.value.integer);
+                break;
+
+            case detail::BindingInstruction::Code::Number:
+                lua_pushnumber(L, instruction.value.number);
+                break;
+
+            case detail::BindingInstruction::Code::String:
+                lua_pushlstring(L, m_strings.data() + instruction.value.offset, static_cast<std::size_t>(instruction.count));
+                break;
+
+            case detail::BindingInstruction::Code::LightUserdata:
+                lua_pushlightuserdata(L, instruction.value.pointer);
+                break;
+
+            case detail::BindingInstruction::Code::Table:
+                lua_createtable(L, instruction.count, instruction.extra);
+                lua_rawseti(L, slotsIndex, instruction.slot);
+                break;
+
+            case detail::BindingInstruction::Code::CClosure:
+                lua_pushcclosure_x(L, instruction.value.function, instruction.extra >= 0 ? m_strings.data() + instruction.extra : "", instruction.count);
+                lua_pushvalue(L, -1);
+                lua_rawseti(L, slotsIndex, instruction.slot);
+                break;
+
+            case detail::BindingInstruction::Code::Slot:
+                lua_rawgeti(L, slotsIndex, instruction.slot);
+                break;
+
+            case detail::BindingInstruction::Code::Globals:
+                detail::push_globals_table(L);
+                break;
+
+            case detail::BindingInstruction::Code::Registry:
+                lua_pushvalue(L, LUA_REGISTRYINDEX);
+                break;
+
+            case detail::BindingInstruction::Code::Thread:
+                lua_pushthread(L);
+                break;
+
+            case detail::BindingInstruction::Code::RawSet:
+                lua_rawset(L, -3);
+                break;
+
+            case detail::BindingInstruction::Code::SetMetatable:
+                lua_setmetatable(L, -2);
+                break;
+
+            case detail::BindingInstruction::Code::Pop:
+                lua_pop(L, 1);
+                break;
+            }
+        }
+
+        return {};
+    }
+
+    /**
+     * @brief The number of instructions of the image.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_instructions.size();
+    }
+
+    /**
+     * @brief The number of tables and functions created when applying the image.
+     */
+    [[nodiscard]] std::size_t objects() const noexcept
+    {
+        return static_cast<std::size_t>(m_slots);
+    }
+
+private:
+    std::vector<detail::BindingInstruction> m_instructions;
+    std::string m_strings;
+    int m_slots = 0;
+    int m_maxDepth = 0;
+};
+
+} // namespace luabridge
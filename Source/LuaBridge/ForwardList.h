@@ -5,9 +5,11 @@
 
 #pragma once
 
+#include "detail/Containers.h"
 #include "detail/Stack.h"
 
 #include <forward_list>
+#include <iterator>
 
 namespace luabridge {
 
@@ -29,18 +31,16 @@ struct Stack<std::forward_list<T, Allocator>>
 
         StackRestore stackRestore(L);
 
-        lua_createtable(L, 0, 0);
+        lua_createtable(L, static_cast<int>(std::distance(list.cbegin(), list.cend())), 0);
 
         auto it = list.cbegin();
-        for (std::size_t tableIndex = 1; it != list.cend(); ++tableIndex, ++it)
+        for (int tableIndex = 1; it != list.cend(); ++tableIndex, ++it)
         {
-            lua_pushinteger(L, static_cast<int>(tableIndex));
-
             auto result = Stack<T>::push(L, *it);
             if (! result)
                 return result;
 
-            lua_settable(L, -3);
+            lua_rawseti(L, -2, tableIndex);
         }
 
         stackRestore.reset();
@@ -57,18 +57,14 @@ struct Stack<std::forward_list<T, Allocator>>
         Type list;
         auto insertPos = list.before_begin();
 
-        int absIndex = lua_absindex(L, index);
-        lua_pushnil(L);
-
-        while (lua_next(L, absIndex) != 0)
+        const int absIndex = lua_absindex(L, index);
+        auto result = detail::decode_sequence<T>(L, absIndex, get_length(L, absIndex), [&list, &insertPos](auto&& value)
         {
-            auto item = Stack<T>::get(L, -1);
-            if (! item)
-                return makeErrorCode(ErrorCode::InvalidTypeCast);
+            insertPos = list.emplace_after(insertPos, std::forward<decltype(value)>(value));
+        });
 
-            insertPos = list.insert_after(insertPos, *item);
-            lua_pop(L, 1);
-        }
+        if (! result)
+            return result.error();
 
         return list;
     }
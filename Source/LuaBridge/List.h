@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "detail/Containers.h"
 #include "detail/Stack.h"
 
 #include <list>
@@ -48,27 +49,7 @@ struct Stack<std::list<T, Allocator>>
 
     [[nodiscard]] static TypeResult<Type> get(lua_State* L, int index)
     {
-        if (!lua_istable(L, index))
-            return makeErrorCode(ErrorCode::InvalidTypeCast);
-
-        const StackRestore stackRestore(L);
-
-        Type list;
-
-        int absIndex = lua_absindex(L, index);
-        lua_pushnil(L);
-
-        while (lua_next(L, absIndex) != 0)
-        {
-            auto item = Stack<T>::get(L, -1);
-            if (! item)
-                return makeErrorCode(ErrorCode::InvalidTypeCast);
-
-            list.emplace_back(*item);
-            lua_pop(L, 1);
-        }
-
-        return list;
+        return detail::get_sequence<Type>(L, index);
     }
 
     [[nodiscard]] static bool isInstance(lua_State* L, int index)
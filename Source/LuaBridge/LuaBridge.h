@@ -18,10 +18,13 @@
 
 #include "detail/CFunctions.h"
 #include "detail/ClassInfo.h"
+#include "detail/ClassStats.h"
+#include "detail/Containers.h"
 #include "detail/Coroutine.h"
 #include "detail/Enum.h"
 #include "detail/Errors.h"
 #include "detail/Expected.h"
+#include "detail/ExternalMemory.h"
 #include "detail/FlagSet.h"
 #include "detail/FuncTraits.h"
 #include "detail/Globals.h"
@@ -30,11 +33,17 @@
 #include "detail/LuaException.h"
 #include "detail/LuaHelpers.h"
 #include "detail/LuaRef.h"
+#include "detail/MemoryResource.h"
 #include "detail/Namespace.h"
 #include "detail/Options.h"
 #include "detail/Overload.h"
+#include "detail/Profiling.h"
 #include "detail/Result.h"
 #include "detail/ScopeGuard.h"
+#include "detail/ScopedArena.h"
+#include "detail/SharedMetadata.h"
 #include "detail/Stack.h"
+#include "detail/ThreadPool.h"
+#include "detail/Transfer.h"
 #include "detail/TypeTraits.h"
 #include "detail/Userdata.h"
@@ -50,7 +50,7 @@ struct Stack<std::multimap<K, V, Compare, Allocator>>
                 lua_rawseti(L, -2, innerIndex);
             }
             
-            lua_settable(L, -3);
+            lua_rawset(L, -3);
             it = range.second;
         }
 
@@ -88,7 +88,7 @@ struct Stack<std::multimap<K, V, Compare, Allocator>>
                 if (! value)
                     return makeErrorCode(ErrorCode::InvalidTypeCast);
 
-                map.emplace(*key, *value);
+                map.emplace(*key, std::move(*value));
                 lua_pop(L, 1);
             }
 
@@ -0,0 +1,402 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "detail/ClassInfo.h"
+#include "detail/Config.h"
+#include "detail/LuaHelpers.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <functional>
+
+namespace luabridge {
+
+//=================================================================================================
+/**
+ * @brief Statistics of a `PoolAllocator`.
+ */
+struct PoolAllocatorStats
+{
+    std::size_t live = 0;                 ///< Bytes allocated by Lua and not yet freed.
+    std::size_t peak = 0;                 ///< Highest value of `live` since the allocator was created or `resetPeak` was called.
+    std::size_t reserved = 0;             ///< Bytes of the slabs of the pooled size classes.
+    std::uint64_t allocations = 0;        ///< Blocks allocated.
+    std::uint64_t pooledAllocations = 0;  ///< Blocks allocated from the slabs.
+    std::uint64_t failedAllocations = 0;  ///< Allocations and reallocations refused by the memory limit or the system.
+};
+
+//=================================================================================================
+/**
+ * @brief Lua allocator serving small blocks from size class slabs.
+ *
+ * Blocks up to `maxPooledSize` bytes are rounded to a multiple of `granularity` and served from the free list of their size
+ * class, or carved from slabs of `slabSize` bytes when the free list is empty. Freed blocks go back to the free list of their size
+ * class: the slabs are released only when the allocator is destroyed. Larger blocks are passed through to `std::malloc`,
+ * `std::realloc` and `std::free`.
+ *
+ * An optional memory limit caps the bytes allocated by Lua: allocations exceeding it return `nullptr`, raising a Lua memory error
+ * in the script instead of exhausting the process memory. Shrinking blocks is never refused.
+ *
+ * The allocator must outlive the Lua state using it. Each Lua state should have its own allocator: a state and all its threads run
+ * on one system thread at a time, so the allocator needs no locking.
+ *
+ * Example:
+ * @code
+ * luabridge::PoolAllocator allocator(64 * 1024 * 1024);
+ * lua_State* L = luabridge::lua_newstate_x(&luabridge::PoolAllocator::allocate, &allocator, 0);
+ * ...
+ * lua_close(L);
+ * @endcode
+ */
+class PoolAllocator
+{
+public:
+    static constexpr std::size_t granularity = alignof(std::max_align_t);
+    static constexpr std::size_t maxPooledSize = 512;
+    static constexpr std::size_t slabSize = 64 * 1024;
+
+    /**
+     * @brief Construct an allocator.
+     *
+     * @param limit Maximum bytes allocated by Lua, or 0 for no limit.
+     */
+    explicit PoolAllocator(std::size_t limit = 0) noexcept
+        : m_limit(limit)
+    {
+    }
+
+    PoolAllocator(const PoolAllocator&) = delete;
+    PoolAllocator& operator=(const PoolAllocator&) = delete;
+
+    ~PoolAllocator()
+    {
+        if (m_adoptedBlocks != 0)
+            freeAdoptedBlocks();
+
+        while (m_slabs != nullptr)
+        {
+            Slab* next = m_slabs->next;
+            std::free(m_slabs);
+            m_slabs = next;
+        }
+    }
+
+    /**
+     * @brief The `lua_Alloc` function of the allocator, to be passed with the allocator as user data to `lua_newstate`.
+     */
+    static void* allocate(void* ud, void* ptr, std::size_t osize, std::size_t nsize) noexcept
+    {
+        return static_cast<PoolAllocator*>(ud)->reallocate(ptr, osize, nsize);
+    }
+
+    /**
+     * @brief Allocate, reallocate or free a block, with the semantics of `lua_Alloc`.
+     *
+     * @param ptr The block, or `nullptr` to allocate a new block.
+     * @param osize The size of the block. Ignored when `ptr` is `nullptr`, where Lua passes the type of the object.
+     * @param nsize The new size of the block, or 0 to free it.
+     *
+     * @returns The new block, or `nullptr` when the block is freed or the allocation failed. A failed reallocation leaves the block
+     * untouched.
+     */
+    void* reallocate(void* ptr, std::size_t osize, std::size_t nsize) noexcept
+    {
+        const std::size_t oldSize = ptr != nullptr ? osize : 0;
+
+        if (nsize == 0)
+        {
+            if (ptr != nullptr)
+                release(ptr, oldSize);
+
+            m_stats.live -= oldSize;
+            return nullptr;
+        }
+
+        if (nsize > oldSize && m_limit != 0 && m_stats.live - oldSize + nsize > m_limit)
+        {
+            ++m_stats.failedAllocations;
+            return nullptr;
+        }
+
+        void* block = nullptr;
+
+        if (ptr == nullptr)
+        {
+            block = acquire(nsize);
+        }
+        else if (isPooled(oldSize) && isPooled(nsize) && sizeClass(oldSize) == sizeClass(nsize))
+        {
+            block = ptr;
+        }
+        else if (! isPooled(oldSize) && ! isPooled(nsize))
+        {
+            block = std::realloc(ptr, nsize);
+        }
+        else
+        {
+            block = acquire(nsize);
+            if (block != nullptr)
+            {
+                std::memcpy(block, ptr, std::min(oldSize, nsize));
+                release(ptr, oldSize);
+            }
+        }
+
+        if (block == nullptr)
+        {
+            // Shrinking never fails: a large block kept for a pooled size joins the free lists when Lua frees it
+            if (nsize <= oldSize)
+            {
+                if (! isPooled(oldSize) && isPooled(nsize))
+                    ++m_adoptedBlocks;
+
+                block = ptr;
+            }
+            else
+            {
+                ++m_stats.failedAllocations;
+                return nullptr;
+            }
+        }
+
+        m_stats.live = m_stats.live - oldSize + nsize;
+        m_stats.peak = std::max(m_stats.peak, m_stats.live);
+        return block;
+    }
+
+    /**
+     * @brief Get the memory limit, 0 when unlimited.
+     */
+    [[nodiscard]] std::size_t limit() const noexcept
+    {
+        return m_limit;
+    }
+
+    /**
+     * @brief Set the memory limit, 0 for no limit.
+     *
+     * Lowering the limit below the bytes already allocated does not free them, but refuses any further growth.
+     */
+    void setLimit(std::size_t limit) noexcept
+    {
+        m_limit = limit;
+    }
+
+    /**
+     * @brief Get the statistics of the allocator.
+     */
+    [[nodiscard]] const PoolAllocatorStats& stats() const noexcept
+    {
+        return m_stats;
+    }
+
+    /**
+     * @brief Restart the measurement of the peak from the bytes currently allocated.
+     */
+    void resetPeak() noexcept
+    {
+        m_stats.peak = m_stats.live;
+    }
+
+    /**
+     * @brief Get the allocator of a Lua state created with `newState`.
+     *
+     * @returns The allocator, or `nullptr` if the state was not created with `newState`.
+     */
+    [[nodiscard]] static PoolAllocator* get(lua_State* L)
+    {
+        lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getPoolAllocatorKey());
+        auto* allocator = static_cast<PoolAllocator*>(lua_touserdata(L, -1));
+        lua_pop(L, 1);
+
+        return allocator;
+    }
+
+private:
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct alignas(std::max_align_t) Slab
+    {
+        Slab* next;
+    };
+
+    static constexpr std::size_t sizeClassCount = maxPooledSize / granularity;
+
+    static_assert(maxPooledSize % granularity == 0);
+    static_assert(granularity >= sizeof(FreeBlock));
+    static_assert(sizeof(Slab) % granularity == 0);
+
+    static constexpr bool isPooled(std::size_t size) noexcept
+    {
+        return size <= maxPooledSize;
+    }
+
+    static constexpr std::size_t sizeClass(std::size_t size) noexcept
+    {
+        return (size + granularity - 1) / granularity - 1;
+    }
+
+    void* acquire(std::size_t size) noexcept
+    {
+        if (! isPooled(size))
+        {
+            void* block = std::malloc(size);
+            if (block != nullptr)
+                ++m_stats.allocations;
+
+            return block;
+        }
+
+        const std::size_t index = sizeClass(size);
+
+        if (FreeBlock* block = m_freeLists[index]; block != nullptr)
+        {
+            m_freeLists[index] = block->next;
+            ++m_stats.allocations;
+            ++m_stats.pooledAllocations;
+            return block;
+        }
+
+        const std::size_t blockSize = (index + 1) * granularity;
+        if (static_cast<std::size_t>(m_slabEnd - m_slabCursor) < blockSize)
+        {
+            auto* slab = static_cast<Slab*>(std::malloc(slabSize));
+            if (slab == nullptr)
+                return nullptr;
+
+            slab->next = m_slabs;
+            m_slabs = slab;
+            m_slabCursor = reinterpret_cast<std::byte*>(slab) + sizeof(Slab);
+            m_slabEnd = reinterpret_cast<std::byte*>(slab) + slabSize;
+            m_stats.reserved += slabSize;
+        }
+
+        void* block = m_slabCursor;
+        m_slabCursor += blockSize;
+        ++m_stats.allocations;
+        ++m_stats.pooledAllocations;
+        return block;
+    }
+
+    bool isInSlab(const void* ptr) const noexcept
+    {
+        const std::less<const void*> less;
+
+        for (const Slab* slab = m_slabs; slab != nullptr; slab = slab->next)
+        {
+            const auto* begin = reinterpret_cast<const std::byte*>(slab);
+            if (! less(ptr, begin) && less(ptr, begin + slabSize))
+                return true;
+        }
+
+        return false;
+    }
+
+    void freeAdoptedBlocks() noexcept
+    {
+        // Blocks all went back to the free lists when the state was closed
+        for (FreeBlock* block : m_freeLists)
+        {
+            while (block != nullptr)
+            {
+                FreeBlock* next = block->next;
+                if (! isInSlab(block))
+                    std::free(block);
+
+                block = next;
+            }
+        }
+    }
+
+    void release(void* ptr, std::size_t size) noexcept
+    {
+        if (! isPooled(size))
+        {
+            std::free(ptr);
+            return;
+        }
+
+        const std::size_t index = sizeClass(size);
+
+        auto* block = static_cast<FreeBlock*>(ptr);
+        block->next = m_freeLists[index];
+        m_freeLists[index] = block;
+    }
+
+    std::size_t m_limit = 0;
+    PoolAllocatorStats m_stats;
+
+    std::array<FreeBlock*, sizeClassCount> m_freeLists{};
+    Slab* m_slabs = nullptr;
+    std::byte* m_slabCursor = nullptr;
+    std::byte* m_slabEnd = nullptr;
+    std::size_t m_adoptedBlocks = 0;
+};
+
+//=================================================================================================
+/**
+ * @brief Options of the Lua states created with `newState`.
+ */
+struct StateOptions
+{
+    std::size_t memoryLimit = 0; ///< Maximum bytes allocated by the state, or 0 for no limit.
+    unsigned seed = 0;           ///< Seed of the string hashes, used from Lua 5.5.
+};
+
+/**
+ * @brief Create a Lua state allocating its memory from its own `PoolAllocator`.
+ *
+ * The main thread is registered, libraries are not opened. The allocator is available with `PoolAllocator::get`. The state must be
+ * closed with `closeState`, which destroys the allocator too.
+ *
+ * @param options The options of the state.
+ *
+ * @returns The new Lua state, or `nullptr` if it could not be created.
+ */
+[[nodiscard]] inline lua_State* newState(const StateOptions& options = {})
+{
+    auto* allocator = new PoolAllocator();
+
+    lua_State* L = lua_newstate_x(&PoolAllocator::allocate, allocator, options.seed);
+    if (L == nullptr)
+    {
+        delete allocator;
+        return nullptr;
+    }
+
+    lua_pushlightuserdata(L, allocator);
+    lua_rawsetp_x(L, LUA_REGISTRYINDEX, detail::getPoolAllocatorKey());
+
+    register_main_thread(L);
+
+    // The limit applies once the state is set up, so that a low limit does not fail the setup itself
+    allocator->setLimit(options.memoryLimit);
+
+    return L;
+}
+
+/**
+ * @brief Close a Lua state and destroy its allocator, if the state was created with `newState`.
+ *
+ * @param L The main thread of a Lua state.
+ */
+inline void closeState(lua_State* L)
+{
+    PoolAllocator* allocator = PoolAllocator::get(L);
+
+    lua_close(L);
+
+    delete allocator;
+}
+
+} // namespace luabridge
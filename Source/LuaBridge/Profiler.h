@@ -0,0 +1,357 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "detail/ClassInfo.h"
+#include "detail/Config.h"
+#include "detail/LuaHelpers.h"
+#include "detail/Profiling.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if ! LUABRIDGE_ON_LUAU
+namespace luabridge {
+
+//=================================================================================================
+/**
+ * @brief Sampling profiler of the scripts running in a Lua state.
+ *
+ * The profiler installs a count hook on the state. Each time the hook runs and at least one sampling interval elapsed since the
+ * previous sample, the Lua call stack is captured and accumulated as a folded stack, the format read by flamegraph tools like
+ * `flamegraph.pl` and speedscope:
+ *
+ * @code
+ * main chunk (game.lua);update (game.lua:12);Entity.move 42
+ * @endcode
+ *
+ * Lua frames are named after the function name known at the call site and its definition, C frames after their call site name.
+ *
+ * When `LUABRIDGE_ENABLE_PROFILING` is enabled, frames of the functions registered through LuaBridge are named after the binding,
+ * like `Entity.move` or `Entity.position (get)`, and the time spent inside the bindings, where the count hook never runs, is
+ * sampled too: when a binding returns, every sampling interval it ran for since the previous sample adds a sample of the stack
+ * ending with the binding.
+ *
+ * @note Only one profiler can run on a Lua state at a time. The hook is set on the thread passed to `start` and is inherited by
+ * the coroutines created afterwards. `stop` only restores the hook of that thread: the hook finds the running profiler through
+ * the registry, and removes itself from the coroutines still running it once no profiler runs. On LuaJIT, compiled traces do not
+ * run hooks: turn the JIT off to sample them. Not available on Luau, which has no debug hooks. Not thread-safe.
+ *
+ * Example:
+ * @code
+ * luabridge::Profiler profiler(L, std::chrono::microseconds(500));
+ * profiler.start();
+ * runGameFrame(L);
+ * profiler.stop();
+ *
+ * std::ofstream stream("game.folded");
+ * profiler.writeFolded(stream);
+ * @endcode
+ */
+class Profiler
+#if LUABRIDGE_ENABLE_PROFILING
+    : private detail::BindingSampler
+#endif
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Construct a profiler for a Lua state. The profiler is not running.
+     *
+     * @param L A Lua state.
+     * @param interval Minimum time between two samples.
+     * @param instructionCount Number of instructions between two runs of the count hook.
+     * @param maxDepth Maximum number of frames of a sample, the outermost frames are dropped.
+     */
+    explicit Profiler(lua_State* L,
+                      std::chrono::microseconds interval = std::chrono::milliseconds(1),
+                      int instructionCount = 1000,
+                      int maxDepth = 128)
+        : m_L(L)
+        , m_interval(interval)
+        , m_instructionCount(instructionCount)
+        , m_maxDepth(maxDepth)
+    {
+        LUABRIDGE_ASSERT(interval.count() > 0);
+        LUABRIDGE_ASSERT(instructionCount > 0);
+        LUABRIDGE_ASSERT(maxDepth > 0);
+    }
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    ~Profiler()
+    {
+        stop();
+    }
+
+    /**
+     * @brief Start sampling.
+     *
+     * The previous hook of the thread is restored by `stop`.
+     *
+     * @returns `true` if the profiler is running, `false` if another profiler is running on the same Lua state.
+     */
+    bool start()
+    {
+        if (m_running)
+            return true;
+
+        if (get(m_L) != nullptr)
+            return false;
+
+        m_previousHook = lua_gethook(m_L);
+        m_previousHookMask = lua_gethookmask(m_L);
+        m_previousHookCount = lua_gethookcount(m_L);
+
+        lua_pushlightuserdata(m_L, toUserdata());
+        lua_rawsetp_x(m_L, LUA_REGISTRYINDEX, detail::getProfilerKey());
+
+        lua_sethook(m_L, &Profiler::hook, LUA_MASKCOUNT, m_instructionCount);
+
+#if LUABRIDGE_ENABLE_PROFILING
+        detail::active_binding_samplers().fetch_add(1, std::memory_order_relaxed);
+#endif
+
+        m_lastSample = Clock::now();
+        m_running = true;
+        return true;
+    }
+
+    /**
+     * @brief Stop sampling, keeping the samples taken so far.
+     */
+    void stop()
+    {
+        if (! m_running)
+            return;
+
+#if LUABRIDGE_ENABLE_PROFILING
+        detail::active_binding_samplers().fetch_sub(1, std::memory_order_relaxed);
+#endif
+
+        lua_sethook(m_L, m_previousHook, m_previousHookMask, m_previousHookCount);
+
+        lua_pushnil(m_L);
+        lua_rawsetp_x(m_L, LUA_REGISTRYINDEX, detail::getProfilerKey());
+
+        m_running = false;
+    }
+
+    /**
+     * @brief Check if the profiler is sampling.
+     */
+    [[nodiscard]] bool isRunning() const noexcept
+    {
+        return m_running;
+    }
+
+    /**
+     * @brief Discard the samples taken so far.
+     */
+    void reset()
+    {
+        m_samples.clear();
+        m_sampleCount = 0;
+    }
+
+    /**
+     * @brief Total number of samples taken.
+     */
+    [[nodiscard]] std::uint64_t sampleCount() const noexcept
+    {
+        return m_sampleCount;
+    }
+
+    /**
+     * @brief Number of samples per folded stack, with frames separated by `;` from the outermost to the innermost.
+     */
+    [[nodiscard]] const std::unordered_map<std::string, std::uint64_t>& samples() const noexcept
+    {
+        return m_samples;
+    }
+
+    /**
+     * @brief Write the samples in the folded stacks format, one stack per line followed by its number of samples.
+     *
+     * Stacks are sorted, so that the output of equal profiles is equal.
+     */
+    void writeFolded(std::ostream& stream) const
+    {
+        std::vector<const std::pair<const std::string, std::uint64_t>*> sorted;
+        sorted.reserve(m_samples.size());
+
+        for (const auto& sample : m_samples)
+            sorted.push_back(&sample);
+
+        std::sort(sorted.begin(), sorted.end(), [](const auto* lhs, const auto* rhs) { return lhs->first < rhs->first; });
+
+        for (const auto* sample : sorted)
+            stream << sample->first << ' ' << sample->second << '\n';
+    }
+
+    /**
+     * @brief Get the samples in the folded stacks format.
+     */
+    [[nodiscard]] std::string folded() const
+    {
+        std::ostringstream stream;
+        writeFolded(stream);
+        return stream.str();
+    }
+
+    /**
+     * @brief Get the profiler running on a Lua state.
+     *
+     * @returns The profiler, or `nullptr` if none is running.
+     */
+    [[nodiscard]] static Profiler* get(lua_State* L)
+    {
+        lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getProfilerKey());
+        void* userdata = lua_touserdata(L, -1);
+        lua_pop(L, 1);
+
+        return fromUserdata(userdata);
+    }
+
+private:
+    // The wrappers of the profiled bindings see the registry entry as their sampler interface
+#if LUABRIDGE_ENABLE_PROFILING
+    void* toUserdata() noexcept { return static_cast<detail::BindingSampler*>(this); }
+    static Profiler* fromUserdata(void* userdata) noexcept { return static_cast<Profiler*>(static_cast<detail::BindingSampler*>(userdata)); }
+#else
+    void* toUserdata() noexcept { return this; }
+    static Profiler* fromUserdata(void* userdata) noexcept { return static_cast<Profiler*>(userdata); }
+#endif
+
+    static void hook(lua_State* L, lua_Debug*)
+    {
+        Profiler* profiler = get(L);
+        if (profiler == nullptr)
+        {
+            // A coroutine created while profiling and still running after the profiler stopped
+            lua_sethook(L, nullptr, 0, 0);
+            return;
+        }
+
+        const auto now = Clock::now();
+        if (now - profiler->m_lastSample < profiler->m_interval)
+            return;
+
+        profiler->m_lastSample = now;
+        profiler->capture(L, 1);
+    }
+
+#if LUABRIDGE_ENABLE_PROFILING
+    void sample_binding(lua_State* L, Clock::time_point start, Clock::time_point end) override
+    {
+        const auto elapsed = end - std::max(start, m_lastSample);
+        if (elapsed < m_interval)
+            return;
+
+        m_lastSample = end;
+        capture(L, static_cast<std::uint64_t>(elapsed / m_interval));
+    }
+#endif
+
+    void capture(lua_State* L, std::uint64_t count)
+    {
+        if (! lua_checkstack(L, 2))
+            return;
+
+        m_frames.clear();
+
+        lua_Debug ar;
+        for (int level = 0; level < m_maxDepth && lua_getstack(L, level, &ar) != 0; ++level)
+        {
+            lua_getinfo(L, "Snf", &ar);
+            m_frames.push_back(frameName(L, ar));
+            lua_pop(L, 1);
+        }
+
+        if (m_frames.empty())
+            return;
+
+        std::string stack;
+        for (auto it = m_frames.rbegin(); it != m_frames.rend(); ++it)
+        {
+            if (! stack.empty())
+                stack.push_back(';');
+
+            stack += *it;
+        }
+
+        m_samples[std::move(stack)] += count;
+        m_sampleCount += count;
+    }
+
+    static std::string frameName(lua_State* L, const lua_Debug& ar)
+    {
+        std::string name;
+
+#if LUABRIDGE_ENABLE_PROFILING
+        if (const auto* profiled = detail::get_profiled_binding(L, -1); profiled != nullptr)
+        {
+            const auto& counters = *profiled->counters;
+            name = detail::binding_qualified_name(counters.className, counters.name, counters.kind);
+        }
+        else
+#else
+        unused(L);
+
+#endif
+        if (ar.what != nullptr && std::string_view(ar.what) == "main")
+        {
+            name = "main chunk (";
+            name += ar.short_src;
+            name += ")";
+        }
+        else if (ar.what != nullptr && std::string_view(ar.what) == "C")
+        {
+            name = ar.name != nullptr ? ar.name : "?";
+            name += " ([C])";
+        }
+        else
+        {
+            name = ar.name != nullptr ? ar.name : "?";
+            name += " (";
+            name += ar.short_src;
+            name += ":";
+            name += std::to_string(ar.linedefined);
+            name += ")";
+        }
+
+        std::replace(name.begin(), name.end(), ';', ':');
+        return name;
+    }
+
+    lua_State* m_L;
+    std::chrono::microseconds m_interval;
+    int m_instructionCount;
+    int m_maxDepth;
+
+    bool m_running = false;
+    lua_Hook m_previousHook = nullptr;
+    int m_previousHookMask = 0;
+    int m_previousHookCount = 0;
+    Clock::time_point m_lastSample{};
+
+    std::unordered_map<std::string, std::uint64_t> m_samples;
+    std::uint64_t m_sampleCount = 0;
+    std::vector<std::string> m_frames;
+};
+
+} // namespace luabridge
+#endif
@@ -0,0 +1,596 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "detail/CFunctions.h"
+#include "detail/ClassInfo.h"
+#include "detail/LuaHelpers.h"
+#include "detail/LuaRef.h"
+#include "detail/Namespace.h"
+#include "detail/ThreadPool.h"
+
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace luabridge {
+
+//=================================================================================================
+/**
+ * @brief Counters of a Scheduler.
+ */
+struct SchedulerStats
+{
+    std::size_t ready = 0;                   ///< Threads ready to be resumed.
+    std::size_t sleeping = 0;                ///< Threads sleeping until a deadline.
+    std::size_t waiting = 0;                 ///< Threads waiting for an event.
+    std::size_t resumes = 0;                 ///< Threads resumed by the last tick.
+    std::size_t finished = 0;                ///< Threads finished in the last tick, including errors.
+    std::size_t errors = 0;                  ///< Threads terminated by an error in the last tick.
+    std::chrono::nanoseconds tickDuration{}; ///< Time spent resuming threads in the last tick.
+};
+
+//=================================================================================================
+/**
+ * @brief Cooperative scheduler of Lua threads.
+ *
+ * Threads are resumed in batches by `tick`, in the order they became ready. A thread can suspend itself with the functions
+ * installed by `registerFunctions`:
+ *
+ * - `sleep(seconds)` suspends the thread until the scheduler time advanced by the given amount, using a hashed timer wheel.
+ * - `wait(event)` suspends the thread until `signal(event, ...)` is called with a raw equal event, and returns the signal values.
+ * - `signal(event, ...)` makes all the threads waiting for event ready, and returns their count.
+ * - `spawn(function, ...)` starts a new thread running function, which is resumed from the next tick, and returns it.
+ *
+ * A thread yielding with `coroutine.yield` is resumed again in the next tick. Threads are anchored in the registry for as long
+ * as they are scheduled, and threads spawned from C++ are recycled through a `ThreadPool` when they finish. Threads spawned
+ * from Lua are handed to the script, so they are never recycled and are left to the garbage collector.
+ *
+ * @note The scheduler must be destroyed before its Lua state is closed. Not thread-safe.
+ *
+ * Example:
+ * @code
+ * luabridge::Scheduler scheduler(L);
+ * scheduler.registerFunctions("scheduler");
+ * scheduler.spawn(luabridge::getGlobal(L, "entityMain"), entityId);
+ *
+ * while (running)
+ *     scheduler.tick(frameSeconds);
+ * @endcode
+ */
+class Scheduler
+{
+public:
+    using Clock = std::chrono::steady_clock;
+    using ErrorHandler = std::function<void(lua_State* thread, std::string_view message)>;
+
+    /**
+     * @brief Number of slots of the timer wheel.
+     */
+    static constexpr std::size_t wheelSize = 256;
+
+    /**
+     * @brief Construct a scheduler for the threads of a Lua state.
+     *
+     * @param L A Lua state, becoming the one scheduled by this object.
+     * @param timerResolution Duration in seconds of a timer wheel slot, deadlines are rounded up to it.
+     */
+    explicit Scheduler(lua_State* L, double timerResolution = 0.001)
+        : m_L(L)
+        , m_resolution(timerResolution)
+        , m_threadPool(L)
+    {
+        LUABRIDGE_ASSERT(timerResolution > 0.0);
+
+        lua_pushlightuserdata(m_L, this);
+        lua_rawsetp_x(m_L, LUA_REGISTRYINDEX, detail::getSchedulerKey());
+    }
+
+    Scheduler(const Scheduler&) = delete;
+    Scheduler& operator=(const Scheduler&) = delete;
+
+    ~Scheduler()
+    {
+        if (get(m_L) != this)
+            return;
+
+        lua_pushnil(m_L);
+        lua_rawsetp_x(m_L, LUA_REGISTRYINDEX, detail::getSchedulerKey());
+    }
+
+    /**
+     * @brief Get the scheduler of a Lua state.
+     *
+     * @returns The scheduler, or `nullptr` if none is alive.
+     */
+    [[nodiscard]] static Scheduler* get(lua_State* L)
+    {
+        lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getSchedulerKey());
+        auto* scheduler = static_cast<Scheduler*>(lua_touserdata(L, -1));
+        lua_pop(L, 1);
+
+        return scheduler;
+    }
+
+    /**
+     * @brief Install `sleep`, `wait`, `signal` and `spawn` in a namespace.
+     *
+     * @param name The name of the namespace, in the global namespace.
+     */
+    void registerFunctions(const char* name = "scheduler")
+    {
+        getGlobalNamespace(m_L)
+            .beginNamespace(name)
+                .addFunction("sleep", &Scheduler::luaSleep)
+                .addFunction("wait", &Scheduler::luaWait)
+                .addFunction("signal", &Scheduler::luaSignal)
+                .addFunction("spawn", &Scheduler::luaSpawn)
+            .endNamespace();
+    }
+
+    /**
+     * @brief Start a new thread, resumed from the next tick.
+     *
+     * @param function The function run by the thread.
+     * @param args The arguments passed to the function.
+     *
+     * @returns The new thread, or `nullptr` if the arguments could not be pushed.
+     */
+    template <class... Args>
+    lua_State* spawn(const LuaRef& function, Args&&... args)
+    {
+        lua_State* thread = m_threadPool.acquire();
+        LuaRef threadRef = LuaRef::fromStack(m_L);
+
+        function.push(thread);
+
+        const auto [result, index] = detail::push_arguments(thread, std::forward_as_tuple(args...));
+        if (! result)
+        {
+            m_threadPool.release(thread);
+            return nullptr;
+        }
+
+        wake(addTask(std::move(threadRef), thread, static_cast<int>(sizeof...(Args)), true));
+        return thread;
+    }
+
+    /**
+     * @brief Make all the threads waiting for an event ready.
+     *
+     * @param event The event, compared with raw equality.
+     * @param args The values returned by `wait` in the woken threads.
+     *
+     * @returns The number of woken threads.
+     */
+    template <class... Args>
+    std::size_t signal(const LuaRef& event, Args&&... args)
+    {
+        const StackRestore stackRestore(m_L);
+        const int firstArg = lua_gettop(m_L) + 1;
+
+        const auto [result, index] = detail::push_arguments(m_L, std::forward_as_tuple(args...));
+        if (! result)
+            return 0;
+
+        return signalFromStack(event, m_L, firstArg, static_cast<int>(sizeof...(Args)));
+    }
+
+    /**
+     * @brief Advance the scheduler time and resume the threads that are ready.
+     *
+     * Only the threads ready when the tick starts are resumed, the ones becoming ready during the tick run in the next one.
+     * Resuming stops early when the tick budget is exhausted, leaving the remaining threads ready for the next tick.
+     *
+     * @param deltaTime The time elapsed since the last tick, in seconds.
+     *
+     * @returns The number of resumed threads.
+     */
+    std::size_t tick(double deltaTime)
+    {
+        m_now += deltaTime;
+        advanceTimers(static_cast<std::uint64_t>(std::floor(m_now / m_resolution)));
+
+        m_resumes = 0;
+        m_finished = 0;
+        m_errors = 0;
+
+        const auto start = Clock::now();
+
+        for (std::size_t batch = m_ready.size(); batch > 0 && ! m_ready.empty(); --batch)
+        {
+            if (m_budget > Clock::duration::zero() && m_resumes > 0 && Clock::now() - start >= m_budget)
+                break;
+
+            const std::size_t id = m_ready.front();
+            m_ready.pop_front();
+
+            resume(id);
+            ++m_resumes;
+        }
+
+        m_tickDuration = std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - start);
+        return m_resumes;
+    }
+
+    /**
+     * @brief Set the maximum time spent resuming threads in a tick, or zero for no limit.
+     */
+    void setTickBudget(Clock::duration budget) noexcept
+    {
+        m_budget = budget;
+    }
+
+    /**
+     * @brief Set the function notified of the threads terminated by an error.
+     */
+    void setErrorHandler(ErrorHandler handler)
+    {
+        m_errorHandler = std::move(handler);
+    }
+
+    /**
+     * @brief The pool recycling the threads of finished tasks.
+     */
+    [[nodiscard]] ThreadPool& threadPool() noexcept
+    {
+        return m_threadPool;
+    }
+
+    /**
+     * @brief The scheduler time, in seconds.
+     */
+    [[nodiscard]] double now() const noexcept
+    {
+        return m_now;
+    }
+
+    /**
+     * @brief The number of scheduled threads.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_tasks.size() - m_free.size();
+    }
+
+    /**
+     * @brief The counters of the scheduler and of its last tick.
+     */
+    [[nodiscard]] SchedulerStats stats() const noexcept
+    {
+        SchedulerStats stats;
+        stats.ready = m_ready.size();
+        stats.sleeping = m_sleeping;
+        stats.waiting = m_waiting;
+        stats.resumes = m_resumes;
+        stats.finished = m_finished;
+        stats.errors = m_errors;
+        stats.tickDuration = m_tickDuration;
+        return stats;
+    }
+
+private:
+    static constexpr std::size_t noTask = std::numeric_limits<std::size_t>::max();
+
+    enum class TaskState
+    {
+        Ready,
+        Running,
+        Sleeping,
+        Waiting
+    };
+
+    struct Task
+    {
+        Task(LuaRef threadRef, lua_State* threadState, int numArgs, bool isPooled)
+            : thread(std::move(threadRef))
+            , payload(thread.state())
+            , state(threadState)
+            , nargs(numArgs)
+            , pooled(isPooled)
+        {
+        }
+
+        LuaRef thread;
+        LuaRef payload;
+        lua_State* state;
+        int nargs;
+        bool pooled;
+        TaskState taskState = TaskState::Ready;
+    };
+
+    struct Timer
+    {
+        std::size_t task;
+        std::uint64_t deadline;
+    };
+
+    struct RawEqual
+    {
+        bool operator()(const LuaRef& lhs, const LuaRef& rhs) const
+        {
+            return lhs.rawequal(rhs);
+        }
+    };
+
+    std::size_t addTask(LuaRef thread, lua_State* state, int nargs, bool pooled)
+    {
+        if (m_free.empty())
+        {
+            m_tasks.emplace_back(std::move(thread), state, nargs, pooled);
+            return m_tasks.size() - 1;
+        }
+
+        const std::size_t id = m_free.back();
+        m_free.pop_back();
+
+        m_tasks[id] = Task(std::move(thread), state, nargs, pooled);
+        return id;
+    }
+
+    void removeTask(std::size_t id)
+    {
+        // A thread referenced by a script must not be handed to another task
+        if (m_tasks[id].pooled)
+            m_threadPool.release(m_tasks[id].state);
+
+        m_tasks[id] = Task(LuaRef(m_L), nullptr, 0, false);
+        m_free.push_back(id);
+    }
+
+    void wake(std::size_t id)
+    {
+        m_tasks[id].taskState = TaskState::Ready;
+        m_ready.push_back(id);
+    }
+
+    void resume(std::size_t id)
+    {
+        Task& task = m_tasks[id];
+        lua_State* thread = task.state;
+
+        const int nargs = task.nargs;
+        if (! task.payload.isNil())
+        {
+            task.payload.push(thread);
+
+            const int payloadIndex = lua_gettop(thread);
+            for (int i = 1; i <= nargs; ++i)
+                lua_rawgeti(thread, payloadIndex, i);
+
+            lua_remove(thread, payloadIndex);
+            task.payload = LuaRef(m_L);
+        }
+
+        task.nargs = 0;
+        task.taskState = TaskState::Running;
+
+        const std::size_t previous = std::exchange(m_running, id);
+
+        int nresults = 0;
+        const int status = lua_resume_x(thread, m_L, nargs, &nresults);
+
+        m_running = previous;
+
+        if (status == LUA_YIELD)
+        {
+            lua_pop(thread, nresults);
+
+            // Not suspended by sleep or wait: resume again in the next tick
+            if (m_tasks[id].taskState == TaskState::Running)
+                wake(id);
+
+            return;
+        }
+
+        ++m_finished;
+
+        if (status != LUABRIDGE_LUA_OK)
+        {
+            ++m_errors;
+
+            if (m_errorHandler)
+            {
+                const char* message = lua_tostring(thread, -1);
+                m_errorHandler(thread, message != nullptr ? message : "unknown error");
+            }
+        }
+
+        removeTask(id);
+    }
+
+    void sleep(std::size_t id, double seconds)
+    {
+        const auto deadline = static_cast<std::uint64_t>(std::ceil((m_now + seconds) / m_resolution));
+
+        m_wheel[deadline % wheelSize].push_back({ id, std::max(deadline, m_tick + 1) });
+        m_tasks[id].taskState = TaskState::Sleeping;
+        ++m_sleeping;
+    }
+
+    void advanceTimers(std::uint64_t targetTick)
+    {
+        if (targetTick <= m_tick)
+            return;
+
+        const std::uint64_t steps = std::min<std::uint64_t>(targetTick - m_tick, wheelSize);
+        for (std::uint64_t step = 1; step <= steps; ++step)
+        {
+            auto& slot = m_wheel[(m_tick + step) % wheelSize];
+
+            for (std::size_t i = 0; i < slot.size();)
+            {
+                if (slot[i].deadline > targetTick)
+                {
+                    ++i;
+                    continue;
+                }
+
+                --m_sleeping;
+                wake(slot[i].task);
+
+                slot[i] = slot.back();
+                slot.pop_back();
+            }
+        }
+
+        m_tick = targetTick;
+    }
+
+    void wait(std::size_t id, LuaRef event)
+    {
+        m_waiters[std::move(event)].push_back(id);
+        m_tasks[id].taskState = TaskState::Waiting;
+        ++m_waiting;
+    }
+
+    std::size_t signalFromStack(const LuaRef& event, lua_State* L, int firstArg, int nargs)
+    {
+        auto it = m_waiters.find(event);
+        if (it == m_waiters.end())
+            return 0;
+
+        // The payload outlives the signalling thread, which can be collected before the waiters resume: reference it from m_L.
+        LuaRef payload(m_L);
+        if (nargs > 0)
+        {
+            payload = LuaRef::newTable(m_L);
+            payload.push(L);
+            for (int i = 0; i < nargs; ++i)
+            {
+                lua_pushvalue(L, firstArg + i);
+                lua_rawseti(L, -2, i + 1);
+            }
+
+            lua_pop(L, 1);
+        }
+
+        const std::vector<std::size_t> waiters = std::move(it->second);
+        m_waiters.erase(it);
+
+        for (const std::size_t id : waiters)
+        {
+            m_tasks[id].payload = payload;
+            m_tasks[id].nargs = nargs;
+            --m_waiting;
+            wake(id);
+        }
+
+        return waiters.size();
+    }
+
+    [[nodiscard]] static Scheduler& fromRunningThread(lua_State* L, const char* functionName)
+    {
+        Scheduler* scheduler = get(L);
+        if (scheduler == nullptr || scheduler->m_running == noTask || scheduler->m_tasks[scheduler->m_running].state != L)
+            raise_lua_error(L, "%s must be called from a thread run by the scheduler", functionName);
+
+        return *scheduler;
+    }
+
+    static int luaSleep(lua_State* L)
+    {
+        Scheduler& scheduler = fromRunningThread(L, "sleep");
+
+        if (lua_type(L, 1) != LUA_TNUMBER)
+            raise_lua_error(L, "sleep expects a number of seconds");
+
+        const double seconds = static_cast<double>(lua_tonumber(L, 1));
+        if (seconds > 0.0)
+            scheduler.sleep(scheduler.m_running, seconds);
+
+        return lua_yield(L, 0);
+    }
+
+    static int luaWait(lua_State* L)
+    {
+        Scheduler& scheduler = fromRunningThread(L, "wait");
+
+        if (lua_isnoneornil(L, 1))
+            raise_lua_error(L, "wait expects an event");
+
+        // Like the signal payloads, the event key is referenced from m_L rather than from a thread that can be collected.
+        lua_settop(L, 1);
+        lua_xmove(L, scheduler.m_L, 1);
+        scheduler.wait(scheduler.m_running, LuaRef::fromStack(scheduler.m_L));
+
+        return lua_yield(L, 0);
+    }
+
+    static int luaSignal(lua_State* L)
+    {
+        Scheduler* scheduler = get(L);
+        if (scheduler == nullptr)
+            raise_lua_error(L, "signal called without a scheduler");
+
+        const LuaRef event = LuaRef::fromStack(L, 1);
+        const std::size_t woken = scheduler->signalFromStack(event, L, 2, lua_gettop(L) - 1);
+
+        lua_pushinteger(L, static_cast<lua_Integer>(woken));
+        return 1;
+    }
+
+    static int luaSpawn(lua_State* L)
+    {
+        Scheduler* scheduler = get(L);
+        if (scheduler == nullptr)
+            raise_lua_error(L, "spawn called without a scheduler");
+
+        if (lua_type(L, 1) != LUA_TFUNCTION)
+            raise_lua_error(L, "spawn expects a function");
+
+        const int count = lua_gettop(L);
+
+        // The scheduler state may be resuming the calling thread, so the new thread is built from the calling one only. The
+        // thread anchors itself, as the calling thread could be collected before the new one finishes.
+        lua_State* thread = lua_newthread(L);
+        if (! lua_checkstack(thread, count + 1))
+            raise_lua_error(L, "spawn has too many arguments");
+
+        lua_pushthread(thread);
+        LuaRef threadRef = LuaRef::fromStack(thread);
+
+        lua_insert(L, 1);
+        lua_xmove(L, thread, count);
+
+        scheduler->wake(scheduler->addTask(std::move(threadRef), thread, count - 1, false));
+
+        return 1;
+    }
+
+    lua_State* m_L;
+    double m_resolution;
+    double m_now = 0.0;
+    std::uint64_t m_tick = 0;
+    Clock::duration m_budget = Clock::duration::zero();
+    ErrorHandler m_errorHandler;
+
+    ThreadPool m_threadPool;
+    std::deque<Task> m_tasks;
+    std::vector<std::size_t> m_free;
+    std::deque<std::size_t> m_ready;
+    std::array<std::vector<Timer>, wheelSize> m_wheel;
+    std::unordered_map<LuaRef, std::vector<std::size_t>, std::hash<LuaRef>, RawEqual> m_waiters;
+    std::size_t m_running = noTask;
+    std::size_t m_sleeping = 0;
+    std::size_t m_waiting = 0;
+
+    std::size_t m_resumes = 0;
+    std::size_t m_finished = 0;
+    std::size_t m_errors = 0;
+    std::chrono::nanoseconds m_tickDuration{};
+};
+
+} // namespace luabridge
@@ -0,0 +1,220 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "detail/Config.h"
+#include "detail/Invoke.h"
+#include "detail/LuaHelpers.h"
+#include "detail/LuaRef.h"
+
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <limits>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace luabridge {
+
+//=================================================================================================
+/**
+ * @brief Mailbox of jobs posted from any thread to a Lua state, run by the thread owning the state.
+ *
+ * Producers push jobs to a lock free multiple producers single consumer queue: posting never blocks on the Lua state nor on
+ * other producers. The owning thread runs the queued jobs in order when it calls `drain`, at a point of its choosing (once per
+ * frame, between two script updates...), so the Lua state is never touched by the producers.
+ *
+ * Job arguments and results cross threads, so they are copied C++ values: references to the Lua state (like `LuaRef`) must
+ * not escape from a job.
+ *
+ * @note The actor must be destroyed before its Lua state is closed. Jobs still queued at destruction are discarded, and their
+ *       futures report a broken promise.
+ *
+ * Example:
+ * @code
+ * luabridge::StateActor actor(L);
+ *
+ * // On a network thread
+ * actor.post([message](lua_State* L) { luabridge::call(luabridge::getGlobal(L, "onMessage"), message); });
+ * auto score = actor.call<int>("score", player);
+ *
+ * // On the thread owning L, once per frame
+ * actor.drain();
+ * @endcode
+ */
+class StateActor
+{
+public:
+    using Job = std::function<void(lua_State*)>;
+
+    /**
+     * @brief Construct an empty mailbox for a Lua state.
+     *
+     * @param L The Lua state the jobs run on.
+     */
+    explicit StateActor(lua_State* L)
+        : m_L(L)
+        , m_head(new Node)
+        , m_tail(m_head.load(std::memory_order_relaxed))
+    {
+    }
+
+    StateActor(const StateActor&) = delete;
+    StateActor& operator=(const StateActor&) = delete;
+
+    ~StateActor()
+    {
+        while (m_tail != nullptr)
+            delete std::exchange(m_tail, m_tail->next.load(std::memory_order_relaxed));
+    }
+
+    /**
+     * @brief Queue a job without result. Can be called from any thread.
+     *
+     * @param job A callable taking the `lua_State*` of the actor. Exceptions escaping the job are propagated to `drain`.
+     */
+    void post(Job job)
+    {
+        Node* node = new Node;
+        node->job = std::move(job);
+
+        m_size.fetch_add(1, std::memory_order_relaxed);
+
+        // The producer owning the previous head is the only one linking it, consumers see the node once it is linked
+        Node* previous = m_head.exchange(node, std::memory_order_acq_rel);
+        previous->next.store(node, std::memory_order_release);
+    }
+
+    /**
+     * @brief Queue a job with a result. Can be called from any thread.
+     *
+     * @param job A callable taking the `lua_State*` of the actor.
+     *
+     * @returns The future result of the job. Exceptions escaping the job are stored in the future.
+     */
+    template <class F>
+    auto submit(F&& job) -> std::future<std::invoke_result_t<std::decay_t<F>&, lua_State*>>
+    {
+        using R = std::invoke_result_t<std::decay_t<F>&, lua_State*>;
+
+        auto promise = std::make_shared<std::promise<R>>();
+        auto future = promise->get_future();
+
+        post([promise, job = std::forward<F>(job)](lua_State* L) mutable
+        {
+#if LUABRIDGE_HAS_EXCEPTIONS
+            try
+            {
+#endif
+                if constexpr (std::is_void_v<R>)
+                {
+                    job(L);
+                    promise->set_value();
+                }
+                else
+                {
+                    promise->set_value(job(L));
+                }
+#if LUABRIDGE_HAS_EXCEPTIONS
+            }
+            catch (...)
+            {
+                promise->set_exception(std::current_exception());
+            }
+#endif
+        });
+
+        return future;
+    }
+
+    /**
+     * @brief Queue a call of a global Lua function. Can be called from any thread.
+     *
+     * @param functionName The name of the global function to call.
+     * @param args The arguments, copied to be pushed by the owning thread.
+     *
+     * @returns The future result of the call, decoded to R. With exceptions enabled on the state, a failed call stores a
+     *          `LuaException` in the future.
+     */
+    template <class R = void, class... Args>
+    std::future<TypeResult<R>> call(std::string functionName, Args&&... args)
+    {
+        return submit([functionName = std::move(functionName), arguments = std::make_tuple(std::forward<Args>(args)...)](lua_State* L)
+        {
+            return std::apply([&](const auto&... values)
+            {
+                return luabridge::call<R>(getGlobal(L, functionName.c_str()), values...);
+            }, arguments);
+        });
+    }
+
+    /**
+     * @brief Run the queued jobs, in the order they were posted. Must be called by the thread owning the Lua state.
+     *
+     * Jobs posted while draining, by producers or by the jobs themselves, are run by the same call if the limit allows. The Lua
+     * stack is restored after each job.
+     *
+     * @param maxJobs The maximum number of jobs to run.
+     *
+     * @returns The number of jobs run.
+     */
+    std::size_t drain(std::size_t maxJobs = std::numeric_limits<std::size_t>::max())
+    {
+        std::size_t count = 0;
+
+        while (count < maxJobs)
+        {
+            Node* next = m_tail->next.load(std::memory_order_acquire);
+            if (next == nullptr)
+                break;
+
+            // The consumed node becomes the new stub, its job is moved out before running it
+            Job job = std::move(next->job);
+            delete std::exchange(m_tail, next);
+
+            m_size.fetch_sub(1, std::memory_order_relaxed);
+            ++count;
+
+            const StackRestore stackRestore(m_L);
+            job(m_L);
+        }
+
+        return count;
+    }
+
+    /**
+     * @brief The approximate number of queued jobs.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_size.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief The Lua state of the actor.
+     */
+    [[nodiscard]] lua_State* state() const noexcept
+    {
+        return m_L;
+    }
+
+private:
+    struct Node
+    {
+        std::atomic<Node*> next = nullptr;
+        Job job;
+    };
+
+    lua_State* m_L;
+    std::atomic<Node*> m_head;
+    Node* m_tail;
+    std::atomic<std::size_t> m_size = 0;
+};
+
+} // namespace luabridge
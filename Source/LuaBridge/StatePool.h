@@ -0,0 +1,312 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "detail/Config.h"
+#include "detail/Invoke.h"
+#include "detail/LuaHelpers.h"
+#include "detail/LuaRef.h"
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace luabridge {
+
+//=================================================================================================
+/**
+ * @brief Pool of worker threads, each one owning a Lua state prepared by the same registration functor.
+ *
+ * Every state is created with `luaL_newstate` and passed to the setup functor, which is expected to open the libraries, register
+ * the bindings and load the scripts needed by the jobs. Jobs are queued to per worker deques: a worker runs its own jobs most
+ * recent first, and when idle steals the oldest jobs of the other workers.
+ *
+ * Job arguments and results cross threads, so they are copied C++ values: references to the Lua state of a worker (like
+ * `LuaRef`) must not escape from a job.
+ *
+ * @note Waiting for a future from inside a job can deadlock if all the workers are waiting.
+ *
+ * Example:
+ * @code
+ * luabridge::StatePool pool(std::thread::hardware_concurrency(), [](lua_State* L)
+ * {
+ *     luaL_openlibs(L);
+ *     luabridge::getGlobalNamespace(L)
+ *         .beginClass<Board>("Board")
+ *             ...
+ *         .endClass();
+ *     luaL_dostring(L, aiScript);
+ * });
+ *
+ * auto score = pool.call<double>("evaluate", board);
+ * double value = *score.get();
+ * @endcode
+ */
+class StatePool
+{
+public:
+    using Setup = std::function<void(lua_State*)>;
+    using Job = std::function<void(lua_State*)>;
+
+    /**
+     * @brief Create the states and start the workers.
+     *
+     * @param workers The number of workers, at least one.
+     * @param setup The functor called on each new state, on the constructing thread.
+     */
+    StatePool(std::size_t workers, const Setup& setup)
+    {
+        workers = std::max<std::size_t>(workers, 1);
+
+        m_workers.reserve(workers);
+        for (std::size_t index = 0; index < workers; ++index)
+        {
+            m_workers.push_back(std::make_unique<Worker>(luaL_newstate()));
+
+            if (setup)
+                setup(m_workers.back()->L);
+        }
+
+        for (std::size_t index = 0; index < workers; ++index)
+            m_workers[index]->thread = std::thread([this, index] { run(index); });
+    }
+
+    StatePool(const StatePool&) = delete;
+    StatePool& operator=(const StatePool&) = delete;
+
+    /**
+     * @brief Stop the workers, once all the queued jobs have been run, and close the states.
+     */
+    ~StatePool()
+    {
+        {
+            const std::lock_guard lock(m_mutex);
+            m_stopping = true;
+        }
+
+        m_wakeUp.notify_all();
+
+        for (auto& worker : m_workers)
+        {
+            if (worker->thread.joinable())
+                worker->thread.join();
+        }
+    }
+
+    /**
+     * @brief Queue a job, running on the state of the worker executing it.
+     *
+     * @param job A callable taking the `lua_State*` of the worker.
+     *
+     * @returns The future result of the job. Exceptions escaping the job are stored in the future.
+     */
+    template <class F>
+    auto submit(F&& job) -> std::future<std::invoke_result_t<std::decay_t<F>&, lua_State*>>
+    {
+        using R = std::invoke_result_t<std::decay_t<F>&, lua_State*>;
+
+        auto promise = std::make_shared<std::promise<R>>();
+        auto future = promise->get_future();
+
+        push([promise, job = std::forward<F>(job)](lua_State* L) mutable
+        {
+#if LUABRIDGE_HAS_EXCEPTIONS
+            try
+            {
+#endif
+                if constexpr (std::is_void_v<R>)
+                {
+                    job(L);
+                    promise->set_value();
+                }
+                else
+                {
+                    promise->set_value(job(L));
+                }
+#if LUABRIDGE_HAS_EXCEPTIONS
+            }
+            catch (...)
+            {
+                promise->set_exception(std::current_exception());
+            }
+#endif
+        });
+
+        return future;
+    }
+
+    /**
+     * @brief Queue a call of a global Lua function.
+     *
+     * @param functionName The name of the global function to call.
+     * @param args The arguments, copied to be pushed by the worker.
+     *
+     * @returns The future result of the call, decoded to R. With exceptions enabled on the worker state, a failed call stores
+     *          a `LuaException` in the future.
+     */
+    template <class R = void, class... Args>
+    std::future<TypeResult<R>> call(std::string functionName, Args&&... args)
+    {
+        return submit([functionName = std::move(functionName), arguments = std::make_tuple(std::forward<Args>(args)...)](lua_State* L)
+        {
+            const StackRestore stackRestore(L);
+
+            return std::apply([&](const auto&... values)
+            {
+                return luabridge::call<R>(getGlobal(L, functionName.c_str()), values...);
+            }, arguments);
+        });
+    }
+
+    /**
+     * @brief The number of workers.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_workers.size();
+    }
+
+    /**
+     * @brief The number of jobs run by a worker other than the one they were queued to.
+     */
+    [[nodiscard]] std::size_t stolen() const noexcept
+    {
+        return m_stolen.load(std::memory_order_relaxed);
+    }
+
+private:
+    struct Worker
+    {
+        explicit Worker(lua_State* state)
+            : L(state)
+        {
+        }
+
+        ~Worker()
+        {
+            if (L != nullptr)
+                lua_close(L);
+        }
+
+        lua_State* L;
+        std::thread thread;
+        std::mutex mutex;
+        std::deque<Job> jobs;
+    };
+
+    static std::pair<const StatePool*, std::size_t>& currentWorker() noexcept
+    {
+        static thread_local std::pair<const StatePool*, std::size_t> current{ nullptr, 0 };
+        return current;
+    }
+
+    void push(Job job)
+    {
+        // Jobs queued from a worker stay on its own deque, the others are spread round robin
+        const auto [pool, index] = currentWorker();
+        const std::size_t target = pool == this ? index : m_next.fetch_add(1, std::memory_order_relaxed) % m_workers.size();
+
+        // Counted before being visible, so that a worker taking it never sees fewer pending jobs than queued ones
+        {
+            const std::lock_guard lock(m_mutex);
+            ++m_pending;
+        }
+
+        {
+            Worker& worker = *m_workers[target];
+            const std::lock_guard lock(worker.mutex);
+            worker.jobs.push_back(std::move(job));
+        }
+
+        m_wakeUp.notify_one();
+    }
+
+    bool popOwn(std::size_t index, Job& job)
+    {
+        Worker& worker = *m_workers[index];
+        const std::lock_guard lock(worker.mutex);
+
+        if (worker.jobs.empty())
+            return false;
+
+        job = std::move(worker.jobs.back());
+        worker.jobs.pop_back();
+        return true;
+    }
+
+    bool steal(std::size_t index, Job& job)
+    {
+        for (std::size_t offset = 1; offset < m_workers.size(); ++offset)
+        {
+            Worker& victim = *m_workers[(index + offset) % m_workers.size()];
+            const std::lock_guard lock(victim.mutex);
+
+            if (victim.jobs.empty())
+                continue;
+
+            job = std::move(victim.jobs.front());
+            victim.jobs.pop_front();
+
+            m_stolen.fetch_add(1, std::memory_order_relaxed);
+            return true;
+        }
+
+        return false;
+    }
+
+    void run(std::size_t index)
+    {
+        currentWorker() = { this, index };
+
+        lua_State* L = m_workers[index]->L;
+
+        for (;;)
+        {
+            Job job;
+            if (popOwn(index, job) || steal(index, job))
+            {
+                {
+                    const std::lock_guard lock(m_mutex);
+                    --m_pending;
+                }
+
+                job(L);
+                lua_settop(L, 0);
+                continue;
+            }
+
+            std::unique_lock lock(m_mutex);
+            m_wakeUp.wait(lock, [this] { return m_pending > 0 || m_stopping; });
+
+            if (m_pending == 0 && m_stopping)
+                break;
+        }
+
+        currentWorker() = { nullptr, 0 };
+    }
+
+    std::vector<std::unique_ptr<Worker>> m_workers;
+    std::atomic<std::size_t> m_next = 0;
+    std::atomic<std::size_t> m_stolen = 0;
+
+    std::mutex m_mutex;
+    std::condition_variable m_wakeUp;
+    std::size_t m_pending = 0;
+    bool m_stopping = false;
+};
+
+} // namespace luabridge
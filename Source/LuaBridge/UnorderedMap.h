@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "detail/Containers.h"
 #include "detail/Stack.h"
 
 #include <unordered_map>
@@ -14,6 +15,8 @@ namespace luabridge {
 //=================================================================================================
 /**
  * @brief Stack specialization for `std::unordered_map`.
+ *
+ * A `std::pmr::unordered_map` decoded as an argument of a bound function is allocated from the per-call arguments arena.
  */
 template <class K, class V, class Hash, class KeyEqual, class Allocator>
 struct Stack<std::unordered_map<K, V, Hash, KeyEqual, Allocator>>
@@ -22,60 +25,21 @@ struct Stack<std::unordered_map<K, V, Hash, KeyEqual, Allocator>>
 
     [[nodiscard]] static Result push(lua_State* L, const Type& map)
     {
-#if LUABRIDGE_SAFE_STACK_CHECKS
-        if (! lua_checkstack(L, 3))
-            return makeErrorCode(ErrorCode::LuaStackOverflow);
-#endif
-
-        StackRestore stackRestore(L);
-
-        lua_createtable(L, 0, static_cast<int>(map.size()));
-
-        for (auto it = map.begin(); it != map.end(); ++it)
-        {
-            auto result = Stack<K>::push(L, it->first);
-            if (! result)
-                return result;
-
-            result = Stack<V>::push(L, it->second);
-            if (! result)
-                return result;
-
-            lua_settable(L, -3);
-        }
-        
-        stackRestore.reset();
-        return {};
+        return detail::push_associative(L, map);
     }
 
     [[nodiscard]] static TypeResult<Type> get(lua_State* L, int index)
     {
-        if (!lua_istable(L, index))
-            return makeErrorCode(ErrorCode::InvalidTypeCast);
-
-        const StackRestore stackRestore(L);
-
-        Type map;
-
-        int absIndex = lua_absindex(L, index);
-        lua_pushnil(L);
-
-        while (lua_next(L, absIndex) != 0)
-        {
-            auto value = Stack<V>::get(L, -1);
-            if (! value)
-                return makeErrorCode(ErrorCode::InvalidTypeCast);
-
-            auto key = Stack<K>::get(L, -2);
-            if (! key)
-                return makeErrorCode(ErrorCode::InvalidTypeCast);
-
-            map.emplace(*key, *value);
-            lua_pop(L, 1);
-        }
+        return detail::get_associative<Type>(L, index);
+    }
 
-        return map;
+#if LUABRIDGE_HAS_CXX17_MEMORY_RESOURCE
+    template <class A = Allocator, class = std::enable_if_t<std::is_same_v<A, std::pmr::polymorphic_allocator<std::pair<const K, V>>>>>
+    [[nodiscard]] static TypeResult<Type> get(lua_State* L, int index, std::pmr::memory_resource* resource)
+    {
+        return detail::get_associative<Type>(L, index, Allocator(resource));
     }
+#endif
 
     [[nodiscard]] static bool isInstance(lua_State* L, int index)
     {
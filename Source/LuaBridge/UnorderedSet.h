@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include "detail/Containers.h"
 #include "detail/Stack.h"
 
 #include <unordered_set>
@@ -21,54 +22,12 @@ struct Stack<std::unordered_set<K, Hash, KeyEqual, Allocator>>
 
     [[nodiscard]] static Result push(lua_State* L, const Type& set)
     {
-#if LUABRIDGE_SAFE_STACK_CHECKS
-        if (! lua_checkstack(L, 3))
-            return makeErrorCode(ErrorCode::LuaStackOverflow);
-#endif
-
-        StackRestore stackRestore(L);
-
-        lua_createtable(L, 0, static_cast<int>(set.size()));
-
-        auto it = set.cbegin();
-        for (lua_Integer tableIndex = 1; it != set.cend(); ++tableIndex, ++it)
-        {
-            lua_pushinteger(L, tableIndex);
-
-            auto result = Stack<K>::push(L, *it);
-            if (! result)
-                return result;
-
-            lua_settable(L, -3);
-        }
-
-        stackRestore.reset();
-        return {};
+        return detail::push_set(L, set);
     }
 
     [[nodiscard]] static TypeResult<Type> get(lua_State* L, int index)
     {
-        if (!lua_istable(L, index))
-            return makeErrorCode(ErrorCode::InvalidTypeCast);
-
-        const StackRestore stackRestore(L);
-
-        Type set;
-
-        int absIndex = lua_absindex(L, index);
-        lua_pushnil(L);
-
-        while (lua_next(L, absIndex) != 0)
-        {
-            auto item = Stack<K>::get(L, -1);
-            if (! item)
-                return makeErrorCode(ErrorCode::InvalidTypeCast);
-
-            set.emplace(*item);
-            lua_pop(L, 1);
-        }
-
-        return set;
+        return detail::get_set<Type>(L, index);
     }
 
     [[nodiscard]] static bool isInstance(lua_State* L, int index)
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "detail/Containers.h"
 #include "detail/Stack.h"
 
 #include <vector>
@@ -14,6 +15,8 @@ namespace luabridge {
 //=================================================================================================
 /**
  * @brief Stack specialization for `std::vector`.
+ *
+ * A `std::pmr::vector` decoded as an argument of a bound function is allocated from the per-call arguments arena.
  */
 template <class T, class Allocator>
 struct Stack<std::vector<T, Allocator>>
@@ -47,29 +50,16 @@ struct Stack<std::vector<T, Allocator>>
 
     [[nodiscard]] static TypeResult<Type> get(lua_State* L, int index)
     {
-        if (!lua_istable(L, index))
-            return makeErrorCode(ErrorCode::InvalidTypeCast);
-
-        const StackRestore stackRestore(L);
-
-        Type vector;
-        vector.reserve(static_cast<std::size_t>(get_length(L, index)));
-
-        int absIndex = lua_absindex(L, index);
-        lua_pushnil(L);
-
-        while (lua_next(L, absIndex) != 0)
-        {
-            auto item = Stack<T>::get(L, -1);
-            if (! item)
-                return makeErrorCode(ErrorCode::InvalidTypeCast);
-
-            vector.emplace_back(*item);
-            lua_pop(L, 1);
-        }
+        return detail::get_sequence<Type>(L, index);
+    }
 
-        return vector;
+#if LUABRIDGE_HAS_CXX17_MEMORY_RESOURCE
+    template <class A = Allocator, class = std::enable_if_t<std::is_same_v<A, std::pmr::polymorphic_allocator<T>>>>
+    [[nodiscard]] static TypeResult<Type> get(lua_State* L, int index, std::pmr::memory_resource* resource)
+    {
+        return detail::get_sequence<Type>(L, index, Allocator(resource));
     }
+#endif
 
     [[nodiscard]] static bool isInstance(lua_State* L, int index)
     {
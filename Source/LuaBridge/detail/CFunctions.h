@@ -11,7 +11,9 @@
 #include "Errors.h"
 #include "FuncTraits.h"
 #include "LuaHelpers.h"
+#include "MemoryResource.h"
 #include "Options.h"
+#include "SharedMetadata.h"
 #include "Stack.h"
 #include "TypeTraits.h"
 #include "Userdata.h"
@@ -74,10 +76,11 @@ struct ArgStorage
 /**
  * @brief Decode one argument from the Lua stack into storage element I.
  *
- * Sets error_arg/error_msg on the first failure; subsequent calls are no-ops.
+ * Sets error_arg/error_msg on the first failure; subsequent calls are no-ops. Allocator aware arguments are decoded into the
+ * arguments arena resource, when one is provided.
  */
-template <std::size_t I, class ArgsPack, std::size_t Start, class StorageTuple>
-void decode_arg(lua_State* L, StorageTuple& storage, int& error_arg, const char*& error_msg)
+template <std::size_t I, class ArgsPack, std::size_t Start, class StorageTuple, class Resource>
+void decode_arg(lua_State* L, StorageTuple& storage, int& error_arg, const char*& error_msg, Resource resource)
 {
     using T = std::tuple_element_t<I, ArgsPack>;
     using StoredType = typename std::tuple_element_t<I, StorageTuple>::StoredType;
@@ -85,7 +88,7 @@ void decode_arg(lua_State* L, StorageTuple& storage, int& error_arg, const char*
     if (error_arg)
         return;
 
-    auto result = Stack<T>::get(L, static_cast<int>(I + Start));
+    auto result = get_argument<T>(L, static_cast<int>(I + Start), resource);
     if (! result)
     {
         error_arg = static_cast<int>(I + 1);
@@ -108,19 +111,20 @@ void decode_arg(lua_State* L, StorageTuple& storage, int& error_arg, const char*
  * @tparam ArgsPack Arguments pack to extract from the lua stack.
  * @tparam Start    Start index where stack variables are located in the lua stack.
  */
-template <class ArgsPack, std::size_t Start, std::size_t... Indices>
-auto make_arguments_list_impl([[maybe_unused]] lua_State* L, std::index_sequence<Indices...>)
+template <class ArgsPack, std::size_t Start, class Resource, std::size_t... Indices>
+auto make_arguments_list_impl([[maybe_unused]] lua_State* L, [[maybe_unused]] Resource resource, std::index_sequence<Indices...>)
 {
     std::tuple<ArgStorage<std::tuple_element_t<Indices, ArgsPack>>...> storage;
 
     int error_arg = 0;
     const char* error_msg = nullptr;
 
-    (decode_arg<Indices, ArgsPack, Start>(L, storage, error_arg, error_msg), ...);
+    (decode_arg<Indices, ArgsPack, Start>(L, storage, error_arg, error_msg, resource), ...);
 
     if (error_arg)
     {
         (std::get<Indices>(storage).destroy(), ...);
+        release_arguments_arena(resource);
         raise_lua_error(L, "Error decoding argument #%d: %s", error_arg, error_msg);
     }
 
@@ -129,10 +133,10 @@ auto make_arguments_list_impl([[maybe_unused]] lua_State* L, std::index_sequence
     return result;
 }
 
-template <class ArgsPack, std::size_t Start>
-auto make_arguments_list(lua_State* L)
+template <class ArgsPack, std::size_t Start, class Resource = std::nullptr_t>
+auto make_arguments_list(lua_State* L, Resource resource = nullptr)
 {
-    return make_arguments_list_impl<ArgsPack, Start>(L, std::make_index_sequence<std::tuple_size_v<ArgsPack>>());
+    return make_arguments_list_impl<ArgsPack, Start>(L, resource, std::make_index_sequence<std::tuple_size_v<ArgsPack>>());
 }
 
 //=================================================================================================
@@ -1592,16 +1596,48 @@ int destruct_metamethod(lua_State* L)
 template <class C>
 int gc_metamethod(lua_State* L)
 {
+    const FinalizerScope finalizerScope;
+
     destruct_metamethod<C>(L);
 
     Userdata* ud = Userdata::getExact<C>(L, 1);
     LUABRIDGE_ASSERT(ud);
 
+    count_class_object_collected(L, 1);
+    release_external_memory<C>(L, 1);
+
     ud->~Userdata();
 
     return 0;
 }
 
+//=================================================================================================
+/**
+ * @brief __close metamethod for a class, destroying the objects stored by value when their to-be-closed variable goes out of scope.
+ *
+ * The userdata is marked dead after its object is destroyed, using it from Lua raises an error. Objects whose lifetime is managed
+ * by C++, like the ones pushed by pointer or shared container, are left untouched.
+ */
+template <class C>
+int close_metamethod(lua_State* L)
+{
+    if (! lua_isuserdata(L, 1) || lua_islightuserdata(L, 1))
+        return 0;
+
+    Userdata* ud = Userdata::getExact<C>(L, 1);
+    LUABRIDGE_ASSERT(ud);
+
+    if (! ud->ownsObject())
+        return 0;
+
+    destruct_metamethod<C>(L);
+
+    ud->destroyObject();
+    kill_userdata(L, 1);
+
+    return 0;
+}
+
 //=================================================================================================
 
 template <class T, class C = void>
@@ -1779,26 +1815,42 @@ inline void add_property_setter(lua_State* L, const char* name, int tableIndex)
 /**
  * @brief Function generator.
  */
-template <class ArgsPack, std::size_t Start, class F>
-decltype(auto) invoke_callable_from_stack(lua_State* L, F&& func)
+template <class ArgsPack, std::size_t Start, class F, class Resource = std::nullptr_t>
+decltype(auto) invoke_callable_from_stack(lua_State* L, F&& func, Resource resource = nullptr)
 {
-    return std::apply(std::forward<F>(func), make_arguments_list<ArgsPack, Start>(L));
+    return std::apply(std::forward<F>(func), make_arguments_list<ArgsPack, Start>(L, resource));
 }
 
-template <class ArgsPack, std::size_t Start, class T, class F>
-decltype(auto) invoke_member_callable_from_stack(lua_State* L, T* ptr, F&& func)
+template <class ArgsPack, std::size_t Start, class T, class F, class Resource = std::nullptr_t>
+decltype(auto) invoke_member_callable_from_stack(lua_State* L, T* ptr, F&& func, Resource resource = nullptr)
 {
     return std::apply(
         std::forward<F>(func),
-        std::tuple_cat(std::tuple<T*>(ptr), make_arguments_list<ArgsPack, Start>(L)));
+        std::tuple_cat(std::tuple<T*>(ptr), make_arguments_list<ArgsPack, Start>(L, resource)));
 }
 
+/**
+ * @brief Tells if a result returned by value can be constructed directly inside its destination userdata.
+ *
+ * Applies to class objects pushed by value as userdata. Functions taking a `lua_State*` are excluded, as they would observe the
+ * preallocated userdata on the stack.
+ */
+template <class ReturnType, class ArgsPack>
+inline static constexpr bool is_constructible_in_userdata_v =
+    std::is_class_v<ReturnType>
+    && ! std::is_const_v<ReturnType>
+    && IsUserdata<ReturnType>::value
+    && ! IsContainer<ReturnType>::value
+    && function_arity_excluding<ArgsPack, lua_State*>::value == std::tuple_size_v<ArgsPack>;
+
 template <class ReturnType, class ArgsPack, std::size_t Start = 1u>
 struct function
 {
     template <class F>
     static int call(lua_State* L, F&& func)
     {
+        arguments_arena_t<ArgsPack> arena(L);
+
         Result result;
         int numResults = 1;
 
@@ -1809,11 +1861,15 @@ struct function
             if constexpr (detail::is_tuple_v<ReturnType>)
             {
                 numResults = static_cast<int>(std::tuple_size_v<ReturnType>);
-                result = detail::push_tuple(L, invoke_callable_from_stack<ArgsPack, Start>(L, std::forward<F>(func)));
+                result = detail::push_tuple(L, invoke_callable_from_stack<ArgsPack, Start>(L, std::forward<F>(func), arena.get()));
+            }
+            else if constexpr (is_constructible_in_userdata_v<ReturnType, ArgsPack>)
+            {
+                result = UserdataValue<ReturnType>::construct(L, [&]() -> ReturnType { return invoke_callable_from_stack<ArgsPack, Start>(L, std::forward<F>(func), arena.get()); });
             }
             else
             {
-                result = Stack<ReturnType>::push(L, invoke_callable_from_stack<ArgsPack, Start>(L, std::forward<F>(func)));
+                result = Stack<ReturnType>::push(L, invoke_callable_from_stack<ArgsPack, Start>(L, std::forward<F>(func), arena.get()));
             }
 #if LUABRIDGE_HAS_EXCEPTIONS
         }
@@ -1832,6 +1888,8 @@ struct function
     template <class T, class F>
     static int call(lua_State* L, T* ptr, F&& func)
     {
+        arguments_arena_t<ArgsPack> arena(L);
+
         Result result;
         int numResults = 1;
 
@@ -1842,11 +1900,15 @@ struct function
             if constexpr (detail::is_tuple_v<ReturnType>)
             {
                 numResults = static_cast<int>(std::tuple_size_v<ReturnType>);
-                result = detail::push_tuple(L, invoke_member_callable_from_stack<ArgsPack, Start>(L, ptr, std::forward<F>(func)));
+                result = detail::push_tuple(L, invoke_member_callable_from_stack<ArgsPack, Start>(L, ptr, std::forward<F>(func), arena.get()));
+            }
+            else if constexpr (is_constructible_in_userdata_v<ReturnType, ArgsPack>)
+            {
+                result = UserdataValue<ReturnType>::construct(L, [&]() -> ReturnType { return invoke_member_callable_from_stack<ArgsPack, Start>(L, ptr, std::forward<F>(func), arena.get()); });
             }
             else
             {
-                result = Stack<ReturnType>::push(L, invoke_member_callable_from_stack<ArgsPack, Start>(L, ptr, std::forward<F>(func)));
+                result = Stack<ReturnType>::push(L, invoke_member_callable_from_stack<ArgsPack, Start>(L, ptr, std::forward<F>(func), arena.get()));
             }
 #if LUABRIDGE_HAS_EXCEPTIONS
         }
@@ -1869,11 +1931,13 @@ struct function<std::tuple<>, ArgsPack, Start> : function<void, ArgsPack, Start>
     template <class F>
     static int call(lua_State* L, F&& func)
     {
+        arguments_arena_t<ArgsPack> arena(L);
+
 #if LUABRIDGE_HAS_EXCEPTIONS
         try
         {
 #endif
-        invoke_callable_from_stack<ArgsPack, Start>(L, std::forward<F>(func));
+        invoke_callable_from_stack<ArgsPack, Start>(L, std::forward<F>(func), arena.get());
 
 #if LUABRIDGE_HAS_EXCEPTIONS
         }
@@ -1889,11 +1953,13 @@ struct function<std::tuple<>, ArgsPack, Start> : function<void, ArgsPack, Start>
     template <class T, class F>
     static int call(lua_State* L, T* ptr, F&& func)
     {
+        arguments_arena_t<ArgsPack> arena(L);
+
 #if LUABRIDGE_HAS_EXCEPTIONS
         try
         {
 #endif
-        invoke_member_callable_from_stack<ArgsPack, Start>(L, ptr, std::forward<F>(func));
+        invoke_member_callable_from_stack<ArgsPack, Start>(L, ptr, std::forward<F>(func), arena.get());
 
 #if LUABRIDGE_HAS_EXCEPTIONS
         }
@@ -1913,11 +1979,13 @@ struct function<void, ArgsPack, Start>
     template <class F>
     static int call(lua_State* L, F&& func)
     {
+        arguments_arena_t<ArgsPack> arena(L);
+
 #if LUABRIDGE_HAS_EXCEPTIONS
         try
         {
 #endif
-        invoke_callable_from_stack<ArgsPack, Start>(L, std::forward<F>(func));
+        invoke_callable_from_stack<ArgsPack, Start>(L, std::forward<F>(func), arena.get());
 
 #if LUABRIDGE_HAS_EXCEPTIONS
         }
@@ -1933,11 +2001,13 @@ struct function<void, ArgsPack, Start>
     template <class T, class F>
     static int call(lua_State* L, T* ptr, F&& func)
     {
+        arguments_arena_t<ArgsPack> arena(L);
+
 #if LUABRIDGE_HAS_EXCEPTIONS
         try
         {
 #endif
-        invoke_member_callable_from_stack<ArgsPack, Start>(L, ptr, std::forward<F>(func));
+        invoke_member_callable_from_stack<ArgsPack, Start>(L, ptr, std::forward<F>(func), arena.get());
 
 #if LUABRIDGE_HAS_EXCEPTIONS
         }
@@ -1987,7 +2057,7 @@ int invoke_member_function(lua_State* L)
 {
     using FnTraits = function_traits<F>;
 
-    LUABRIDGE_ASSERT(isfulluserdata(L, lua_upvalueindex(1)));
+    LUABRIDGE_ASSERT(lua_islightuserdata(L, lua_upvalueindex(1)));
 
     auto ptr = get_member_object<T>(L, false);
     if (! ptr)
@@ -2004,7 +2074,7 @@ int invoke_const_member_function(lua_State* L)
 {
     using FnTraits = function_traits<F>;
 
-    LUABRIDGE_ASSERT(isfulluserdata(L, lua_upvalueindex(1)));
+    LUABRIDGE_ASSERT(lua_islightuserdata(L, lua_upvalueindex(1)));
 
     auto ptr = get_member_object<T>(L, true);
     if (! ptr)
@@ -2027,7 +2097,7 @@ int invoke_member_cfunction(lua_State* L)
 {
     using F = int (T::*)(lua_State* L);
 
-    LUABRIDGE_ASSERT(isfulluserdata(L, lua_upvalueindex(1)));
+    LUABRIDGE_ASSERT(lua_islightuserdata(L, lua_upvalueindex(1)));
 
     auto t = Userdata::get<T>(L, 1, false);
     if (! t)
@@ -2058,7 +2128,7 @@ int invoke_const_member_cfunction(lua_State* L)
 {
     using F = int (T::*)(lua_State * L) const;
 
-    LUABRIDGE_ASSERT(isfulluserdata(L, lua_upvalueindex(1)));
+    LUABRIDGE_ASSERT(lua_islightuserdata(L, lua_upvalueindex(1)));
 
     auto t = Userdata::get<T>(L, 1, true);
     if (! t)
@@ -2189,7 +2259,7 @@ int invoke_proxy_destructor(lua_State* L)
 /**
  * @brief C++ storage for a single overload entry: arity and optional type checker.
  *
- * Stored inside an OverloadSet which is kept as a Lua full userdata (auto-GC'd).
+ * Stored inside an OverloadSet.
  */
 struct OverloadEntry
 {
@@ -2202,14 +2272,33 @@ struct OverloadEntry
 /**
  * @brief C++ storage for all overloads of a function.
  *
- * Stored as a Lua full userdata so it is GC'd automatically when the closure is collected.
- * The actual function closures are stored separately in a flat Lua table (upvalue 2).
+ * Only depends on the types of the overloads, so it is built once and shared by all the Lua states registering them, as a light
+ * userdata (upvalue 1). The actual function closures are stored separately in a flat Lua table (upvalue 2).
  */
 struct OverloadSet
 {
     std::vector<OverloadEntry> entries;
 };
 
+/**
+ * @brief Build an OverloadSet on first use and share it afterwards.
+ *
+ * The set is static to the closure type of the builder, which is unique for each registration site and each instantiation of
+ * the template registering the overloads.
+ */
+template <class Builder>
+const OverloadSet* shared_overload_set(Builder builder)
+{
+    static const OverloadSet overloadSet = [&builder]
+    {
+        OverloadSet set;
+        builder(&set);
+        return set;
+    }();
+
+    return &overloadSet;
+}
+
 /**
  * @brief Check a single argument type, skipping lua_State* (auto-injected, not on the Lua stack).
  */
@@ -2257,7 +2346,7 @@ bool overload_type_checker(lua_State* L, int start)
 /**
  * @brief lua_CFunction to resolve an invocation between several overloads.
  *
- * upvalue[1] = OverloadSet full userdata — C++ vector of {arity, type_checker} per overload.
+ * upvalue[1] = OverloadSet light userdata — C++ vector of {arity, type_checker} per overload.
  * upvalue[2] = flat Lua table {[1]=func1, [2]=func2, ...} — the actual function closures.
  *
  * Dispatch:
@@ -2272,8 +2361,8 @@ inline int try_overload_functions(lua_State* L)
     const int effective_args = nargs - (Member ? 1 : 0);
     const int start_arg = Member ? 2 : 1;
 
-    LUABRIDGE_ASSERT(isfulluserdata(L, lua_upvalueindex(1)));
-    auto* overload_set = align<OverloadSet>(lua_touserdata(L, lua_upvalueindex(1)));
+    LUABRIDGE_ASSERT(lua_islightuserdata(L, lua_upvalueindex(1)));
+    const auto* overload_set = static_cast<const OverloadSet*>(lua_touserdata(L, lua_upvalueindex(1)));
 
     // push flat functions table (upvalue 2)
     lua_pushvalue(L, lua_upvalueindex(2));
@@ -2495,7 +2584,7 @@ void push_member_function(lua_State* L, ReturnType (U::*mfp)(Params...), const c
 
     using F = decltype(mfp);
 
-    new (lua_newuserdata_x<F>(L, sizeof(F))) F(mfp);
+    push_shared_metadata(L, mfp);
     lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getClassRegistryKey<T>());
     lua_pushcclosure_x(L, &invoke_member_function<F, T>, debugname, 2);
 }
@@ -2507,7 +2596,7 @@ void push_member_function(lua_State* L, ReturnType (U::*mfp)(Params...) noexcept
 
     using F = decltype(mfp);
 
-    new (lua_newuserdata_x<F>(L, sizeof(F))) F(mfp);
+    push_shared_metadata(L, mfp);
     lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getClassRegistryKey<T>());
     lua_pushcclosure_x(L, &invoke_member_function<F, T>, debugname, 2);
 }
@@ -2520,7 +2609,7 @@ void push_member_function(lua_State* L, ReturnType (U::*mfp)(Params...) const, c
 
     using F = decltype(mfp);
 
-    new (lua_newuserdata_x<F>(L, sizeof(F))) F(mfp);
+    push_shared_metadata(L, mfp);
     lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getClassRegistryKey<T>());
     lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getConstRegistryKey<T>());
     lua_pushcclosure_x(L, &detail::invoke_const_member_function<F, T>, debugname, 3);
@@ -2533,7 +2622,7 @@ void push_member_function(lua_State* L, ReturnType (U::*mfp)(Params...) const no
 
     using F = decltype(mfp);
 
-    new (lua_newuserdata_x<F>(L, sizeof(F))) F(mfp);
+    push_shared_metadata(L, mfp);
     lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getClassRegistryKey<T>());
     lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getConstRegistryKey<T>());
     lua_pushcclosure_x(L, &detail::invoke_const_member_function<F, T>, debugname, 3);
@@ -2545,9 +2634,7 @@ void push_member_function(lua_State* L, int (U::*mfp)(lua_State*), const char* d
 {
     static_assert(std::is_same_v<T, U> || std::is_base_of_v<U, T>);
 
-    using F = decltype(mfp);
-
-    new (lua_newuserdata_x<F>(L, sizeof(F))) F(mfp);
+    push_shared_metadata(L, mfp);
     lua_pushcclosure_x(L, &invoke_member_cfunction<T>, debugname, 1);
 }
 
@@ -2557,9 +2644,7 @@ void push_member_function(lua_State* L, int (U::*mfp)(lua_State*) const, const c
 {
     static_assert(std::is_same_v<T, U> || std::is_base_of_v<U, T>);
 
-    using F = decltype(mfp);
-
-    new (lua_newuserdata_x<F>(L, sizeof(F))) F(mfp);
+    push_shared_metadata(L, mfp);
     lua_pushcclosure_x(L, &invoke_const_member_cfunction<T>, debugname, 1);
 }
 
@@ -2611,9 +2696,7 @@ void push_property_getter(lua_State* L, T getter, const char* debugname)
 template <class C, class T, class U>
 void push_class_property_getter(lua_State* L, T (U::*value), const char* debugname)
 {
-    using MemberValue = decltype(value);
-
-    new (lua_newuserdata_x<MemberValue>(L, sizeof(MemberValue))) MemberValue(value);
+    push_shared_metadata(L, value);
     lua_pushcclosure_x(L, &property_getter<T, C>::call, debugname, 1);
 }
 
@@ -2624,7 +2707,7 @@ void push_class_property_getter(lua_State* L, T (B::*getter)() const, const char
 
     using GetType = decltype(getter);
 
-    new (lua_newuserdata_x<GetType>(L, sizeof(GetType))) GetType(getter);
+    push_shared_metadata(L, getter);
     lua_pushcclosure_x(L, &invoke_const_member_function<GetType, C>, debugname, 1);
 }
 
@@ -2635,7 +2718,7 @@ void push_class_property_getter(lua_State* L, T (B::*getter)() const noexcept, c
 
     using GetType = decltype(getter);
 
-    new (lua_newuserdata_x<GetType>(L, sizeof(GetType))) GetType(getter);
+    push_shared_metadata(L, getter);
     lua_pushcclosure_x(L, &invoke_const_member_function<GetType, C>, debugname, 1);
 }
 
@@ -2646,7 +2729,7 @@ void push_class_property_getter(lua_State* L, T (B::*getter)(lua_State*) const,
 
     using GetType = decltype(getter);
 
-    new (lua_newuserdata_x<GetType>(L, sizeof(GetType))) GetType(getter);
+    push_shared_metadata(L, getter);
     lua_pushcclosure_x(L, &invoke_const_member_function<GetType, C>, debugname, 1);
 }
 
@@ -2657,7 +2740,7 @@ void push_class_property_getter(lua_State* L, T (B::*getter)(lua_State*) const n
 
     using GetType = decltype(getter);
 
-    new (lua_newuserdata_x<GetType>(L, sizeof(GetType))) GetType(getter);
+    push_shared_metadata(L, getter);
     lua_pushcclosure_x(L, &invoke_const_member_function<GetType, C>, debugname, 1);
 }
 
@@ -2782,9 +2865,7 @@ void push_property_setter(lua_State* L, T setter, const char* debugname)
 template <class C, class T, class U>
 void push_class_property_setter(lua_State* L, T U::*value, const char* debugname)
 {
-    using MemberValue = decltype(value);
-
-    new (lua_newuserdata_x<MemberValue>(L, sizeof(MemberValue))) MemberValue(value);
+    push_shared_metadata(L, value);
     lua_pushcclosure_x(L, &property_setter<T, C>::call, debugname, 1);
 }
 
@@ -2795,7 +2876,7 @@ void push_class_property_setter(lua_State* L, void (B::*setter)(T), const char*
 
     using SetType = decltype(setter);
 
-    new (lua_newuserdata_x<SetType>(L, sizeof(SetType))) SetType(setter);
+    push_shared_metadata(L, setter);
     lua_pushcclosure_x(L, &invoke_member_function<SetType, C>, debugname, 1);
 }
 
@@ -2806,7 +2887,7 @@ void push_class_property_setter(lua_State* L, void (B::*setter)(T) noexcept, con
 
     using SetType = decltype(setter);
 
-    new (lua_newuserdata_x<SetType>(L, sizeof(SetType))) SetType(setter);
+    push_shared_metadata(L, setter);
     lua_pushcclosure_x(L, &invoke_member_function<SetType, C>, debugname, 1);
 }
 
@@ -2817,7 +2898,7 @@ void push_class_property_setter(lua_State* L, void (B::*setter)(T, lua_State*),
 
     using SetType = decltype(setter);
 
-    new (lua_newuserdata_x<SetType>(L, sizeof(SetType))) SetType(setter);
+    push_shared_metadata(L, setter);
     lua_pushcclosure_x(L, &invoke_member_function<SetType, C>, debugname, 1);
 }
 
@@ -2828,7 +2909,7 @@ void push_class_property_setter(lua_State* L, void (B::*setter)(T, lua_State*) n
 
     using SetType = decltype(setter);
 
-    new (lua_newuserdata_x<SetType>(L, sizeof(SetType))) SetType(setter);
+    push_shared_metadata(L, setter);
     lua_pushcclosure_x(L, &invoke_member_function<SetType, C>, debugname, 1);
 }
 
@@ -3048,7 +3129,8 @@ int constructor_placement_proxy(lua_State* L)
     }
 #endif
 
-    value->commit();
+    value->commit(L);
+    report_external_memory(L, -1, *value->getObject());
 
     return 1;
 }
@@ -3093,7 +3175,8 @@ struct constructor_forwarder
         }
 #endif
 
-        value->commit();
+        value->commit(L);
+        report_external_memory(L, -1, *value->getObject());
 
         return object;
     }
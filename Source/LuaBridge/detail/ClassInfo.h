@@ -195,6 +195,96 @@ template <class T, auto = typeName<T>().find_first_of('.')>
     return reinterpret_cast<void*>(0xc0de);
 }
 
+//=================================================================================================
+/**
+ * @brief The key of the upstream memory resource of the arguments arenas in the registry.
+ */
+[[nodiscard]] inline const void* getArgumentsMemoryResourceKey() noexcept
+{
+    return reinterpret_cast<void*>(0xa4e);
+}
+
+//=================================================================================================
+/**
+ * @brief The key of the C++ coroutine frames pool in the registry.
+ */
+[[nodiscard]] inline const void* getCoroutineFramePoolKey() noexcept
+{
+    return reinterpret_cast<void*>(0xc0f7);
+}
+
+//=================================================================================================
+/**
+ * @brief The key of the scheduler driving the threads of a Lua state in the registry.
+ */
+[[nodiscard]] inline const void* getSchedulerKey() noexcept
+{
+    return reinterpret_cast<void*>(0x5c4e);
+}
+
+//=================================================================================================
+/**
+ * @brief The key of the sampling profiler of a Lua state in the registry.
+ */
+[[nodiscard]] inline const void* getProfilerKey() noexcept
+{
+    return reinterpret_cast<void*>(0x9f0f);
+}
+
+//=================================================================================================
+/**
+ * @brief The key of the live object counters in class and const tables, and of the table listing them in the registry.
+ */
+[[nodiscard]] inline const void* getClassStatsKey() noexcept
+{
+    return reinterpret_cast<void*>(0xc5a7);
+}
+
+//=================================================================================================
+/**
+ * @brief The key of the external memory estimator in class and const tables.
+ */
+[[nodiscard]] inline const void* getMemoryEstimatorKey() noexcept
+{
+    return reinterpret_cast<void*>(0xe571);
+}
+
+//=================================================================================================
+/**
+ * @brief The key of the external memory table of a Lua state in the registry.
+ */
+[[nodiscard]] inline const void* getExternalMemoryKey() noexcept
+{
+    return reinterpret_cast<void*>(0xe3e3);
+}
+
+//=================================================================================================
+/**
+ * @brief The key of the pool allocator of a Lua state created with `newState` in the registry.
+ */
+[[nodiscard]] inline const void* getPoolAllocatorKey() noexcept
+{
+    return reinterpret_cast<void*>(0xa110);
+}
+
+//=================================================================================================
+/**
+ * @brief The key of the active scoped arena of a Lua state in the registry.
+ */
+[[nodiscard]] inline const void* getScopedArenaKey() noexcept
+{
+    return reinterpret_cast<void*>(0xa7e4);
+}
+
+//=================================================================================================
+/**
+ * @brief The key of the metatable of the destroyed objects in the registry.
+ */
+[[nodiscard]] inline const void* getDeadObjectKey() noexcept
+{
+    return reinterpret_cast<void*>(0xdead);
+}
+
 //=================================================================================================
 /**
  * The key of the static index fall back in another metatable.
@@ -0,0 +1,242 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Config.h"
+#include "ClassInfo.h"
+#include "LuaHelpers.h"
+
+#if LUABRIDGE_ENABLE_CLASS_STATS
+#include <algorithm>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <vector>
+#endif
+
+namespace luabridge {
+
+#if LUABRIDGE_ENABLE_CLASS_STATS
+//=================================================================================================
+/**
+ * @brief Snapshot of the live object counters of a registered class in a Lua state.
+ *
+ * Objects are counted when a userdata holding them, by value, pointer or shared container, is pushed with the class or const
+ * metatable, and when that userdata is collected. The same C++ object pushed twice by pointer counts twice.
+ */
+struct ClassStats
+{
+    std::string name;            ///< Name the class was registered with.
+    std::uint64_t live = 0;      ///< Userdata not yet collected.
+    std::uint64_t created = 0;   ///< Userdata created since the first one.
+    std::uint64_t collected = 0; ///< Userdata collected.
+    std::uint64_t bytes = 0;     ///< Size of the live userdata, including the objects stored by value.
+};
+#endif
+
+namespace detail {
+
+#if LUABRIDGE_ENABLE_CLASS_STATS
+//=================================================================================================
+/**
+ * @brief Live object counters of a registered class, stored as a userdata in its class and const tables.
+ */
+struct ClassCounters
+{
+    std::uint64_t created = 0;
+    std::uint64_t collected = 0;
+    std::uint64_t bytes = 0;
+};
+
+//=================================================================================================
+/**
+ * @brief Create the counters of the class of a class or const table.
+ *
+ * The counters are created with the first object of the class, so that registrations do not create userdata. They are stored
+ * in both the class and const tables, and listed in a registry table mapping them to their class table.
+ *
+ * @param L A Lua state.
+ * @param metatable The index of the class or const table.
+ */
+inline ClassCounters* create_class_counters(lua_State* L, int metatable)
+{
+    metatable = lua_absindex(L, metatable);
+
+    lua_rawgetp_x(L, metatable, getClassKey()); // Stack: class table (cl) | nil
+    if (! lua_istable(L, -1))
+    {
+        lua_pop(L, 1);
+        lua_pushvalue(L, metatable); // Stack: cl
+    }
+
+    auto* counters = new (lua_newuserdata_x<ClassCounters>(L, sizeof(ClassCounters))) ClassCounters(); // Stack: cl, counters (cs)
+
+    lua_pushvalue(L, -1); // Stack: cl, cs, cs
+    lua_rawsetp_x(L, -3, getClassStatsKey()); // cl [classStatsKey] = cs. Stack: cl, cs
+
+    lua_rawgetp_x(L, -2, getConstKey()); // Stack: cl, cs, const table (co) | nil
+    if (lua_istable(L, -1))
+    {
+        lua_pushvalue(L, -2); // Stack: cl, cs, co, cs
+        lua_rawsetp_x(L, -2, getClassStatsKey()); // co [classStatsKey] = cs. Stack: cl, cs, co
+    }
+    lua_pop(L, 1); // Stack: cl, cs
+
+    lua_rawgetp_x(L, LUA_REGISTRYINDEX, getClassStatsKey()); // Stack: cl, cs, stats table (sts) | nil
+    if (! lua_istable(L, -1))
+    {
+        lua_pop(L, 1);
+        lua_newtable(L); // Stack: cl, cs, sts
+        lua_pushvalue(L, -1); // Stack: cl, cs, sts, sts
+        lua_rawsetp_x(L, LUA_REGISTRYINDEX, getClassStatsKey()); // Stack: cl, cs, sts
+    }
+
+    lua_insert(L, -3); // Stack: sts, cl, cs
+    lua_insert(L, -2); // Stack: sts, cs, cl
+    lua_rawset(L, -3); // sts [cs] = cl. Stack: sts
+    lua_pop(L, 1);
+
+    return counters;
+}
+
+/**
+ * @brief Count a userdata pushed with the class or const table of a registered class as metatable.
+ */
+inline void count_class_object_created(lua_State* L, int index)
+{
+    index = lua_absindex(L, index);
+
+    if (! lua_getmetatable(L, index)) // Stack: metatable (mt)
+        return;
+
+    lua_rawgetp_x(L, -1, getClassStatsKey()); // Stack: mt, counters (cs) | nil
+    auto* counters = static_cast<ClassCounters*>(lua_touserdata(L, -1));
+    lua_pop(L, 1); // Stack: mt
+
+    if (counters == nullptr)
+        counters = create_class_counters(L, -1);
+
+    lua_pop(L, 1);
+
+    ++counters->created;
+    counters->bytes += static_cast<std::uint64_t>(get_length(L, index));
+}
+
+/**
+ * @brief Count a userdata of a registered class being collected.
+ */
+inline void count_class_object_collected(lua_State* L, int index)
+{
+    index = lua_absindex(L, index);
+
+    if (! lua_getmetatable(L, index)) // Stack: metatable (mt)
+        return;
+
+    lua_rawgetp_x(L, -1, getClassStatsKey()); // Stack: mt, counters (cs) | nil
+    auto* counters = static_cast<ClassCounters*>(lua_touserdata(L, -1));
+    lua_pop(L, 2);
+
+    if (counters == nullptr)
+        return;
+
+    ++counters->collected;
+    counters->bytes -= std::min(counters->bytes, static_cast<std::uint64_t>(get_length(L, index)));
+}
+
+#else
+inline void count_class_object_created(lua_State*, int) noexcept
+{
+}
+
+inline void count_class_object_collected(lua_State*, int) noexcept
+{
+}
+#endif
+
+} // namespace detail
+
+#if LUABRIDGE_ENABLE_CLASS_STATS
+//=================================================================================================
+/**
+ * @brief Get the live object counters of the registered classes of a Lua state, sorted by name.
+ *
+ * Only available when `LUABRIDGE_ENABLE_CLASS_STATS` is enabled. Classes without objects created yet are not listed.
+ *
+ * @note On Luau, userdata destructors have no access to the Lua state, and collected objects are not counted.
+ */
+inline std::vector<ClassStats> getClassStats(lua_State* L)
+{
+    std::vector<ClassStats> stats;
+
+    lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getClassStatsKey()); // Stack: stats table (sts) | nil
+    if (! lua_istable(L, -1))
+    {
+        lua_pop(L, 1);
+        return stats;
+    }
+
+    lua_pushnil(L); // Stack: sts, nil
+    while (lua_next(L, -2)) // Stack: sts, counters (cs), class table (cl)
+    {
+        const auto* counters = static_cast<const detail::ClassCounters*>(lua_touserdata(L, -2));
+
+        ClassStats& entry = stats.emplace_back();
+        entry.created = counters->created;
+        entry.collected = counters->collected;
+        entry.live = counters->created - std::min(counters->created, counters->collected);
+        entry.bytes = counters->bytes;
+
+        lua_rawgetp_x(L, -1, detail::getTypeKey()); // Stack: sts, cs, cl, name
+        if (const char* name = lua_tostring(L, -1))
+            entry.name = name;
+
+        lua_pop(L, 2); // Stack: sts, cs
+    }
+
+    lua_pop(L, 1);
+
+    std::sort(stats.begin(), stats.end(), [](const ClassStats& lhs, const ClassStats& rhs) { return lhs.name < rhs.name; });
+
+    return stats;
+}
+
+/**
+ * @brief lua_CFunction returning the live object counters of the registered classes to Lua.
+ *
+ * The result is a table keyed by class name, with `live`, `created`, `collected` and `bytes` fields. Register it to expose the
+ * counters to scripts:
+ *
+ * @code
+ * luabridge::getGlobalNamespace(L)
+ *     .addFunction("getClassStats", &luabridge::getClassStatsTable);
+ * @endcode
+ */
+inline int getClassStatsTable(lua_State* L)
+{
+    const auto stats = getClassStats(L);
+
+    lua_createtable(L, 0, static_cast<int>(stats.size()));
+
+    for (const auto& entry : stats)
+    {
+        lua_createtable(L, 0, 4);
+
+        lua_pushinteger(L, static_cast<lua_Integer>(entry.live));
+        rawsetfield(L, -2, "live");
+        lua_pushinteger(L, static_cast<lua_Integer>(entry.created));
+        rawsetfield(L, -2, "created");
+        lua_pushinteger(L, static_cast<lua_Integer>(entry.collected));
+        rawsetfield(L, -2, "collected");
+        lua_pushinteger(L, static_cast<lua_Integer>(entry.bytes));
+        rawsetfield(L, -2, "bytes");
+
+        rawsetfield(L, -2, entry.name.c_str());
+    }
+
+    return 1;
+}
+#endif
+
+} // namespace luabridge
@@ -102,6 +102,19 @@
 #define LUABRIDGE_STRICT_STACK_CONVERSIONS 0
 #endif
 
+/**
+ * @brief Enable strict sequence conversions to reject holes when getting sequence containers from the stack.
+ *
+ * Sequence containers (`std::vector`, `std::deque`, `std::list`, `std::forward_list`) are decoded from the elements `1..#t`
+ * of a Lua table. When enabled, a `nil` element in that range fails the conversion. When disabled (default), `nil` elements
+ * are skipped. `std::array` always rejects holes.
+ *
+ * @note Default is disabled.
+ */
+#if !defined(LUABRIDGE_STRICT_SEQUENCE_CONVERSIONS)
+#define LUABRIDGE_STRICT_SEQUENCE_CONVERSIONS 0
+#endif
+
 /**
  * @brief Enable safe exception handling when lua is compiled as `C` and exceptions raise during execution of registered `lua_CFunction`.
  * 
@@ -118,6 +131,35 @@
 #define LUABRIDGE_SAFE_LUA_C_EXCEPTION_HANDLING 0
 #endif
 
+/**
+ * @brief Enable per binding call counters and latency histograms.
+ *
+ * When enabled, every function, property accessor, constructor and index fallback registered through `Namespace` is wrapped
+ * by a closure counting its calls and timing them with `std::chrono::steady_clock`. The statistics are process wide, keyed by
+ * class name and registration name, and can be queried with `luabridge::getTopBindingProfiles`.
+ *
+ * @warning When enabled, every call of a registered function pays two relaxed atomic increments and two clock reads.
+ *
+ * @note Default is disabled: registrations push the bound functions unchanged.
+ */
+#if !defined(LUABRIDGE_ENABLE_PROFILING)
+#define LUABRIDGE_ENABLE_PROFILING 0
+#endif
+
+/**
+ * @brief Enable per class live object counters.
+ *
+ * When enabled, every userdata of a registered class pushed by LuaBridge and collected by its `__gc` metamethod is counted in
+ * counters stored in the class and const tables, readable with `luabridge::getClassStats`.
+ *
+ * @warning When enabled, every object pushed and collected pays a metatable lookup.
+ *
+ * @note Default is disabled.
+ */
+#if !defined(LUABRIDGE_ENABLE_CLASS_STATS)
+#define LUABRIDGE_ENABLE_CLASS_STATS 0
+#endif
+
 /**
  * @brief Control raising when an unregistered class is used.
  * 
@@ -173,6 +215,42 @@
 #endif
 #endif
 
+/**
+ * @brief Enable C++17 polymorphic memory resource library support.
+ *
+ * Requires C++17 and the memory_resource header to be available.
+ * Define LUABRIDGE_DISABLE_CXX17_MEMORY_RESOURCE to force-disable even when available.
+ */
+#if !defined(LUABRIDGE_HAS_CXX17_MEMORY_RESOURCE)
+#if !defined(LUABRIDGE_DISABLE_CXX17_MEMORY_RESOURCE) && __has_include(<memory_resource>) && defined(__cpp_lib_memory_resource)
+#define LUABRIDGE_HAS_CXX17_MEMORY_RESOURCE 1
+#else
+#define LUABRIDGE_HAS_CXX17_MEMORY_RESOURCE 0
+#endif
+#endif
+
+/**
+ * @brief Size in bytes of the inline buffer of the per-call arena used to decode `std::pmr` arguments taken by `const&`.
+ *
+ * Arguments exceeding the buffer are allocated from the upstream resource set with `setArgumentsMemoryResource`.
+ *
+ * @note Default is 512 bytes.
+ */
+#if !defined(LUABRIDGE_ARGUMENTS_ARENA_SIZE)
+#define LUABRIDGE_ARGUMENTS_ARENA_SIZE 512
+#endif
+
+/**
+ * @brief Maximum nesting of tables copied by `transfer` between Lua states.
+ *
+ * Deeper values fail with `ErrorCode::LuaStackOverflow` instead of exhausting the C stack.
+ *
+ * @note Default is 256.
+ */
+#if !defined(LUABRIDGE_TRANSFER_MAX_DEPTH)
+#define LUABRIDGE_TRANSFER_MAX_DEPTH 256
+#endif
+
 /**
  * @brief Enable C++20 span library support.
  *
@@ -215,6 +293,18 @@
 #endif
 #endif
 
+/**
+ * @brief Size in bytes of the largest C++ coroutine frame recycled by the per state coroutine frames pool.
+ *
+ * Frames of `CppCoroutine` bodies started from Lua are rounded up to a multiple of 64 bytes and recycled through per size free
+ * lists, bigger frames are allocated from the global heap.
+ *
+ * @note Default is 1024 bytes.
+ */
+#if !defined(LUABRIDGE_COROUTINE_FRAME_POOL_MAX_SIZE)
+#define LUABRIDGE_COROUTINE_FRAME_POOL_MAX_SIZE 1024
+#endif
+
 /**
  * @brief Enable C++23 expected library support.
  *
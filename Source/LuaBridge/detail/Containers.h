@@ -0,0 +1,363 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Config.h"
+#include "LuaHelpers.h"
+#include "Stack.h"
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace luabridge {
+namespace detail {
+
+//=================================================================================================
+/**
+ * @brief Detect if a container provides `reserve(size_type)`.
+ */
+template <class C, class = void>
+struct has_reserve : std::false_type
+{
+};
+
+template <class C>
+struct has_reserve<C, std::void_t<decltype(std::declval<C&>().reserve(std::declval<typename C::size_type>()))>> : std::true_type
+{
+};
+
+template <class C>
+inline static constexpr bool has_reserve_v = has_reserve<C>::value;
+
+//=================================================================================================
+/**
+ * @brief Count the entries of the table at the given absolute index, including the hash part.
+ *
+ * The traversal does not convert keys or values, so it is a cheap way to presize hashed containers before decoding.
+ */
+inline std::size_t count_table_entries(lua_State* L, int absIndex)
+{
+    std::size_t count = 0;
+
+    lua_pushnil(L);
+    while (lua_next(L, absIndex) != 0)
+    {
+        ++count;
+        lua_pop(L, 1);
+    }
+
+    return count;
+}
+
+//=================================================================================================
+/**
+ * @brief Push the key/value pairs of an associative container as a Lua table.
+ *
+ * The table hash part is presized to the container size and entries are stored with `lua_rawset`, as a freshly created
+ * table has no metatable whose `__newindex` would need to be honoured.
+ */
+template <class C>
+[[nodiscard]] Result push_associative(lua_State* L, const C& container)
+{
+    using K = typename C::key_type;
+    using V = typename C::mapped_type;
+
+#if LUABRIDGE_SAFE_STACK_CHECKS
+    if (! lua_checkstack(L, 3))
+        return makeErrorCode(ErrorCode::LuaStackOverflow);
+#endif
+
+    StackRestore stackRestore(L);
+
+    lua_createtable(L, 0, static_cast<int>(container.size()));
+
+    for (const auto& [key, value] : container)
+    {
+        auto result = Stack<K>::push(L, key);
+        if (! result)
+            return result;
+
+        result = Stack<V>::push(L, value);
+        if (! result)
+            return result;
+
+        lua_rawset(L, -3);
+    }
+
+    stackRestore.reset();
+    return {};
+}
+
+//=================================================================================================
+/**
+ * @brief Decode a Lua table into an associative container.
+ *
+ * Hashed containers are reserved from a counting pass over the table before decoding. Decoded keys and values are moved
+ * into the container, so string keys are only allocated once. An optional allocator is forwarded to the container constructor.
+ */
+template <class C, class... Allocator>
+[[nodiscard]] TypeResult<C> get_associative(lua_State* L, int index, const Allocator&... allocator)
+{
+    using K = typename C::key_type;
+    using V = typename C::mapped_type;
+
+    if (! lua_istable(L, index))
+        return makeErrorCode(ErrorCode::InvalidTypeCast);
+
+#if LUABRIDGE_SAFE_STACK_CHECKS
+    if (! lua_checkstack(L, 2))
+        return makeErrorCode(ErrorCode::LuaStackOverflow);
+#endif
+
+    const StackRestore stackRestore(L);
+
+    C container(allocator...);
+
+    const int absIndex = lua_absindex(L, index);
+
+    if constexpr (has_reserve_v<C>)
+        container.reserve(count_table_entries(L, absIndex));
+
+    lua_pushnil(L);
+
+    while (lua_next(L, absIndex) != 0)
+    {
+        auto value = Stack<V>::get(L, -1);
+        if (! value)
+            return makeErrorCode(ErrorCode::InvalidTypeCast);
+
+        auto key = Stack<K>::get(L, -2);
+        if (! key)
+            return makeErrorCode(ErrorCode::InvalidTypeCast);
+
+        container.emplace(std::move(*key), std::move(*value));
+        lua_pop(L, 1);
+    }
+
+    return container;
+}
+
+//=================================================================================================
+/**
+ * @brief Push the elements of a set container as a Lua sequence.
+ *
+ * The table array part is presized to the container size and elements are stored with `lua_rawseti`.
+ */
+template <class C>
+[[nodiscard]] Result push_set(lua_State* L, const C& container)
+{
+    using K = typename C::key_type;
+
+#if LUABRIDGE_SAFE_STACK_CHECKS
+    if (! lua_checkstack(L, 2))
+        return makeErrorCode(ErrorCode::LuaStackOverflow);
+#endif
+
+    StackRestore stackRestore(L);
+
+    lua_createtable(L, static_cast<int>(container.size()), 0);
+
+    int tableIndex = 1;
+    for (const auto& item : container)
+    {
+        auto result = Stack<K>::push(L, item);
+        if (! result)
+            return result;
+
+        lua_rawseti(L, -2, tableIndex++);
+    }
+
+    stackRestore.reset();
+    return {};
+}
+
+//=================================================================================================
+/**
+ * @brief Decode the values of a Lua table into a set container.
+ *
+ * Hashed containers are reserved from a counting pass over the table before decoding.
+ */
+template <class C>
+[[nodiscard]] TypeResult<C> get_set(lua_State* L, int index)
+{
+    using K = typename C::key_type;
+
+    if (! lua_istable(L, index))
+        return makeErrorCode(ErrorCode::InvalidTypeCast);
+
+#if LUABRIDGE_SAFE_STACK_CHECKS
+    if (! lua_checkstack(L, 2))
+        return makeErrorCode(ErrorCode::LuaStackOverflow);
+#endif
+
+    const StackRestore stackRestore(L);
+
+    C container;
+
+    const int absIndex = lua_absindex(L, index);
+
+    if constexpr (has_reserve_v<C>)
+        container.reserve(count_table_entries(L, absIndex));
+
+    lua_pushnil(L);
+
+    while (lua_next(L, absIndex) != 0)
+    {
+        auto item = Stack<K>::get(L, -1);
+        if (! item)
+            return makeErrorCode(ErrorCode::InvalidTypeCast);
+
+        container.emplace(std::move(*item));
+        lua_pop(L, 1);
+    }
+
+    return container;
+}
+
+//=================================================================================================
+/**
+ * @brief Tells if a sequence element type is decoded with the tight arithmetic loop.
+ *
+ * Excludes `bool` and `char`, which are not marshalled as Lua numbers.
+ */
+template <class T>
+inline static constexpr bool is_sequence_arithmetic_v =
+    (std::is_integral_v<T> && ! std::is_same_v<T, bool> && ! std::is_same_v<T, char>) || std::is_floating_point_v<T>;
+
+/**
+ * @brief Convert the number on top of the stack into an arithmetic sequence element.
+ *
+ * Equivalent to `Stack<T>::get` for arithmetic types, but reads the number only once and without building a result.
+ */
+template <class T>
+[[nodiscard]] bool get_sequence_number(lua_State* L, T& value)
+{
+    if (lua_type(L, -1) != LUA_TNUMBER)
+        return false;
+
+    if constexpr (std::is_floating_point_v<T>)
+    {
+        const lua_Number number = lua_tonumber(L, -1);
+        if (! is_floating_point_representable_by<T>(number))
+            return false;
+
+        value = static_cast<T>(number);
+    }
+    else
+    {
+        int isValid = 0;
+        const lua_Integer number = tointeger(L, -1, &isValid);
+        if (! isValid || ! is_integral_representable_by<T>(number))
+            return false;
+
+        value = static_cast<T>(number);
+    }
+
+    return true;
+}
+
+/**
+ * @brief Decode the elements `1..length` of the Lua sequence at the given absolute index.
+ *
+ * Elements are read in order with `lua_rawgeti` and passed to `insert`. A `nil` element (a hole) is skipped, unless `strict`
+ * is true or `LUABRIDGE_STRICT_SEQUENCE_CONVERSIONS` is enabled, in which case the decode fails.
+ *
+ * @returns An error code if an element could not be converted to `T`.
+ */
+template <class T, bool Strict = false, class F>
+[[nodiscard]] Result decode_sequence(lua_State* L, int absIndex, int length, F&& insert)
+{
+#if LUABRIDGE_SAFE_STACK_CHECKS
+    if (! lua_checkstack(L, 1))
+        return makeErrorCode(ErrorCode::LuaStackOverflow);
+#endif
+
+    for (int i = 1; i <= length; ++i)
+    {
+        lua_rawgeti(L, absIndex, i);
+
+        if (lua_isnil(L, -1))
+        {
+            lua_pop(L, 1);
+
+            if constexpr (Strict || LUABRIDGE_STRICT_SEQUENCE_CONVERSIONS)
+                return makeErrorCode(ErrorCode::InvalidTypeCast);
+            else
+                continue;
+        }
+
+        if constexpr (is_sequence_arithmetic_v<T>)
+        {
+            T value{};
+            if (! get_sequence_number(L, value))
+                return makeErrorCode(ErrorCode::InvalidTypeCast);
+
+            insert(value);
+        }
+        else
+        {
+            auto item = Stack<T>::get(L, -1);
+            if (! item)
+                return makeErrorCode(ErrorCode::InvalidTypeCast);
+
+            insert(std::move(*item));
+        }
+
+        lua_pop(L, 1);
+    }
+
+    return {};
+}
+
+/**
+ * @brief Decode a Lua sequence into a container supporting `emplace_back`.
+ *
+ * Contiguous containers of arithmetic types are resized upfront and written in place, other containers are reserved when
+ * possible and filled with `emplace_back`. An optional allocator is forwarded to the container constructor.
+ */
+template <class C, class... Allocator>
+[[nodiscard]] TypeResult<C> get_sequence(lua_State* L, int index, const Allocator&... allocator)
+{
+    using T = typename C::value_type;
+
+    if (! lua_istable(L, index))
+        return makeErrorCode(ErrorCode::InvalidTypeCast);
+
+    const StackRestore stackRestore(L);
+
+    const int absIndex = lua_absindex(L, index);
+    const int length = get_length(L, absIndex);
+
+    C container(allocator...);
+
+    if constexpr (is_sequence_arithmetic_v<T> && has_reserve_v<C>)
+    {
+        container.resize(static_cast<std::size_t>(length));
+
+        T* data = container.data();
+        std::size_t size = 0;
+
+        auto result = decode_sequence<T>(L, absIndex, length, [data, &size](T value) { data[size++] = value; });
+        if (! result)
+            return result.error();
+
+        container.resize(size);
+    }
+    else
+    {
+        if constexpr (has_reserve_v<C>)
+            container.reserve(static_cast<std::size_t>(length));
+
+        auto result = decode_sequence<T>(L, absIndex, length, [&container](auto&& value) { container.emplace_back(std::forward<decltype(value)>(value)); });
+        if (! result)
+            return result.error();
+    }
+
+    return container;
+}
+
+} // namespace detail
+} // namespace luabridge
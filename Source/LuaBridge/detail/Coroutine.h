@@ -6,8 +6,12 @@
 
 #include "Config.h"
 #include "CFunctions.h"
+#include "ClassInfo.h"
 #include "Errors.h"
+#include "Invoke.h"
+#include "LuaException.h"
 #include "LuaHelpers.h"
+#include "LuaRef.h"
 #include "Stack.h"
 
 #if LUABRIDGE_HAS_CXX20_COROUTINES
@@ -18,12 +22,349 @@
 #endif
 #else
 
+#include <array>
 #include <coroutine>
+#include <cstddef>
 #include <exception>
+#include <functional>
+#include <new>
+#include <system_error>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 
 namespace luabridge {
+namespace detail {
+
+//=================================================================================================
+/**
+ * @brief Pool of C++ coroutine frames of a Lua state, bucketed by size.
+ *
+ * Frames up to `LUABRIDGE_COROUTINE_FRAME_POOL_MAX_SIZE` bytes are rounded up to a multiple of `granularity` bytes, and are
+ * recycled through a free list per size instead of being returned to the global heap. Each block starts with a header pointing
+ * back to its pool, so that it can be released without access to the Lua state.
+ *
+ * The pool is owned by the registry of the Lua state. Blocks still alive when the state is closed keep the pool alive until
+ * they are released.
+ *
+ * @note Not thread-safe, like the Lua state owning it.
+ */
+class CoroutineFramePool
+{
+public:
+    static constexpr std::size_t granularity = 64;
+    static constexpr std::size_t bucketCount = (LUABRIDGE_COROUTINE_FRAME_POOL_MAX_SIZE + granularity - 1) / granularity;
+
+    CoroutineFramePool() = default;
+    CoroutineFramePool(const CoroutineFramePool&) = delete;
+    CoroutineFramePool& operator=(const CoroutineFramePool&) = delete;
+
+    ~CoroutineFramePool()
+    {
+        for (FreeBlock* head : m_freeLists)
+        {
+            while (head != nullptr)
+                ::operator delete(std::exchange(head, head->next));
+        }
+    }
+
+    /**
+     * @brief Get the pool of a Lua state, creating it on first use.
+     */
+    [[nodiscard]] static CoroutineFramePool* get(lua_State* L)
+    {
+        lua_rawgetp_x(L, LUA_REGISTRYINDEX, getCoroutineFramePoolKey());
+
+        if (void* owner = lua_touserdata(L, -1))
+        {
+            CoroutineFramePool* pool = align<Owner>(owner)->pool;
+            lua_pop(L, 1);
+            return pool;
+        }
+
+        lua_pop(L, 1);
+
+        auto* pool = new CoroutineFramePool;
+        lua_newuserdata_aligned<Owner>(L, pool);
+        lua_rawsetp_x(L, LUA_REGISTRYINDEX, getCoroutineFramePoolKey());
+        return pool;
+    }
+
+    /**
+     * @brief The pool serving the frames of the coroutines being created on this thread, if any.
+     */
+    [[nodiscard]] static CoroutineFramePool*& current() noexcept
+    {
+        static thread_local CoroutineFramePool* pool = nullptr;
+        return pool;
+    }
+
+    /**
+     * @brief Makes a pool the current one for the lifetime of the scope.
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(CoroutineFramePool* pool) noexcept
+            : m_previous(std::exchange(current(), pool))
+        {
+        }
+
+        Scope(const Scope&) = delete;
+        Scope& operator=(const Scope&) = delete;
+
+        ~Scope()
+        {
+            current() = m_previous;
+        }
+
+    private:
+        CoroutineFramePool* m_previous;
+    };
+
+    /**
+     * @brief Allocate a coroutine frame from the current pool, or from the global heap if there is none.
+     */
+    [[nodiscard]] static void* allocate(std::size_t size)
+    {
+        CoroutineFramePool* pool = current();
+        const std::size_t bucket = (size + headerSize - 1) / granularity;
+
+        std::byte* block = nullptr;
+        if (pool == nullptr || bucket >= bucketCount)
+        {
+            pool = nullptr;
+            block = static_cast<std::byte*>(::operator new(size + headerSize));
+        }
+        else if (FreeBlock* head = pool->m_freeLists[bucket])
+        {
+            pool->m_freeLists[bucket] = head->next;
+            block = reinterpret_cast<std::byte*>(head);
+        }
+        else
+        {
+            block = static_cast<std::byte*>(::operator new((bucket + 1) * granularity));
+        }
+
+        if (pool != nullptr)
+            ++pool->m_outstanding;
+
+        new (block) BlockHeader{ pool, bucket };
+        return block + headerSize;
+    }
+
+    /**
+     * @brief Release a coroutine frame allocated with `allocate` back to its pool.
+     */
+    static void deallocate(void* ptr) noexcept
+    {
+        std::byte* block = static_cast<std::byte*>(ptr) - headerSize;
+        const BlockHeader header = *reinterpret_cast<BlockHeader*>(block);
+
+        CoroutineFramePool* pool = header.pool;
+        if (pool == nullptr)
+        {
+            ::operator delete(block);
+            return;
+        }
+
+        --pool->m_outstanding;
+
+        if (pool->m_closed)
+        {
+            ::operator delete(block);
+
+            if (pool->m_outstanding == 0)
+                delete pool;
+
+            return;
+        }
+
+        pool->m_freeLists[header.bucket] = new (block) FreeBlock{ pool->m_freeLists[header.bucket] };
+    }
+
+    /**
+     * @brief Number of frames allocated from the pool and not yet released.
+     */
+    [[nodiscard]] std::size_t outstanding() const noexcept
+    {
+        return m_outstanding;
+    }
+
+    /**
+     * @brief Number of released frames kept for reuse.
+     */
+    [[nodiscard]] std::size_t cached() const noexcept
+    {
+        std::size_t count = 0;
+
+        for (const FreeBlock* head : m_freeLists)
+        {
+            for (; head != nullptr; head = head->next)
+                ++count;
+        }
+
+        return count;
+    }
+
+private:
+    struct BlockHeader
+    {
+        CoroutineFramePool* pool;
+        std::size_t bucket;
+    };
+
+    struct FreeBlock
+    {
+        FreeBlock* next;
+    };
+
+    struct Owner
+    {
+        explicit Owner(CoroutineFramePool* owned) noexcept
+            : pool(owned)
+        {
+        }
+
+        ~Owner()
+        {
+            if (pool->m_outstanding == 0)
+                delete pool;
+            else
+                pool->m_closed = true;
+        }
+
+        CoroutineFramePool* pool;
+    };
+
+    static constexpr std::size_t headerSize =
+        (sizeof(BlockHeader) + __STDCPP_DEFAULT_NEW_ALIGNMENT__ - 1) / __STDCPP_DEFAULT_NEW_ALIGNMENT__ * __STDCPP_DEFAULT_NEW_ALIGNMENT__;
+
+    std::array<FreeBlock*, bucketCount> m_freeLists{};
+    std::size_t m_outstanding = 0;
+    bool m_closed = false;
+};
+
+//=================================================================================================
+/**
+ * @brief Base of the coroutine promises, allocating the coroutine frames from the current `CoroutineFramePool`.
+ */
+struct CoroutinePromiseAllocator
+{
+    static void* operator new(std::size_t size)
+    {
+        return CoroutineFramePool::allocate(size);
+    }
+
+    static void operator delete(void* ptr) noexcept
+    {
+        CoroutineFramePool::deallocate(ptr);
+    }
+};
+
+} // namespace detail
+
+//=================================================================================================
+/**
+ * @brief A pack of values yielded at once by a CppCoroutine, see `values`.
+ */
+template <class... Ts>
+struct CoroutineValues
+{
+    std::tuple<Ts...> values;
+};
+
+/**
+ * @brief Pack values to be yielded as separate Lua values by a CppCoroutine.
+ *
+ * Example:
+ * @code
+ * co_yield luabridge::values(key, value, weight); // Lua receives 3 values
+ * @endcode
+ */
+template <class... Ts>
+[[nodiscard]] CoroutineValues<std::decay_t<Ts>...> values(Ts&&... args)
+{
+    return { std::tuple<std::decay_t<Ts>...>(std::forward<Ts>(args)...) };
+}
+
+namespace detail {
+
+//=================================================================================================
+/**
+ * @brief A Lua call awaited by a suspended CppCoroutine, see `callAsync`.
+ *
+ * While the call yields, the coroutine continuation forwards the resume arguments to the call thread instead of resuming the
+ * C++ coroutine body.
+ */
+struct AsyncCallState
+{
+    lua_State* thread = nullptr;
+    int status = LUABRIDGE_LUA_OK;
+    int nresults = 0;
+};
+
+//=================================================================================================
+/**
+ * @brief Common part of the CppCoroutine promises.
+ *
+ * Yielded and returned values are pushed on the stack of the promise's Lua state, tuples and value packs push one Lua value
+ * per element and set `nresults` accordingly.
+ */
+struct CoroutinePromiseBase : CoroutinePromiseAllocator
+{
+    lua_State* L = nullptr;
+    int nresults = 0;
+    bool is_done = false;
+    std::exception_ptr exception;
+    AsyncCallState* awaiting = nullptr;
+
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+
+    void unhandled_exception() noexcept
+    {
+        exception = std::current_exception();
+    }
+
+    template <class... Ts>
+    std::suspend_always yield_value(CoroutineValues<Ts...> values)
+    {
+        push_values(std::move(values.values));
+        return {};
+    }
+
+protected:
+    template <class T>
+    void push_values(T&& value)
+    {
+        using U = remove_cvref_t<T>;
+
+        nresults = 0;
+        if (! L)
+            return;
+
+        Result result;
+        int count = 1;
+
+        if constexpr (is_tuple_v<U>)
+        {
+            result = push_tuple(L, value);
+            count = static_cast<int>(std::tuple_size_v<U>);
+        }
+        else
+        {
+            result = Stack<U>::push(L, std::forward<T>(value));
+        }
+
+        if (result)
+            nresults = count;
+        else
+            exception = std::make_exception_ptr(std::system_error(result.error()));
+    }
+};
+
+} // namespace detail
 
 //=================================================================================================
 /**
@@ -33,7 +374,7 @@ namespace luabridge {
  * runs until the first co_yield (which yields a value back to Lua) or co_return (which
  * returns a final value). Subsequent Lua resumes continue the body from the last suspension point.
  *
- * @tparam R The type yielded/returned by the coroutine. May be void.
+ * @tparam R The type yielded/returned by the coroutine. May be void. A `std::tuple` is pushed as one Lua value per element.
  *
  * Example:
  * @code
@@ -45,80 +386,40 @@ namespace luabridge {
  *     });
  * @endcode
  *
+ * Several values can be yielded at once with `co_yield luabridge::values(a, b, c)`.
+ *
  * @note Requires Lua 5.2+ (lua_yieldk). Not supported on Lua 5.1, LuaJIT, or Luau.
  * @note Not thread-safe. Must be driven from a single OS thread.
+ * @note Coroutine frames created from Lua are recycled through a per state pool, see `detail::CoroutineFramePool`.
  */
 template <class R>
 struct CppCoroutine
 {
-    struct promise_type
+    struct promise_type : detail::CoroutinePromiseBase
     {
-        lua_State* L = nullptr;
-        int nresults = 0;
-        bool is_done = false;
-        std::exception_ptr exception;
-
-        std::suspend_always initial_suspend() noexcept { return {}; }
-        std::suspend_always final_suspend() noexcept { return {}; }
-
-        void unhandled_exception() noexcept
-        {
-            exception = std::current_exception();
-        }
+        using CoroutinePromiseBase::yield_value;
 
         std::suspend_always yield_value(const R& value)
         {
-            nresults = 0;
-            if (L)
-            {
-                auto result = Stack<R>::push(L, value);
-                if (result)
-                    nresults = 1;
-                else
-                    exception = std::make_exception_ptr(std::system_error(result.error()));
-            }
+            push_values(value);
             return {};
         }
 
         std::suspend_always yield_value(R&& value)
         {
-            nresults = 0;
-            if (L)
-            {
-                auto result = Stack<R>::push(L, std::move(value));
-                if (result)
-                    nresults = 1;
-                else
-                    exception = std::make_exception_ptr(std::system_error(result.error()));
-            }
+            push_values(std::move(value));
             return {};
         }
 
         void return_value(const R& value)
         {
-            nresults = 0;
-            if (L)
-            {
-                auto result = Stack<R>::push(L, value);
-                if (result)
-                    nresults = 1;
-                else
-                    exception = std::make_exception_ptr(std::system_error(result.error()));
-            }
+            push_values(value);
             is_done = true;
         }
 
         void return_value(R&& value)
         {
-            nresults = 0;
-            if (L)
-            {
-                auto result = Stack<R>::push(L, std::move(value));
-                if (result)
-                    nresults = 1;
-                else
-                    exception = std::make_exception_ptr(std::system_error(result.error()));
-            }
+            push_values(std::move(value));
             is_done = true;
         }
 
@@ -152,21 +453,8 @@ struct CppCoroutine
 template <>
 struct CppCoroutine<void>
 {
-    struct promise_type
+    struct promise_type : detail::CoroutinePromiseBase
     {
-        lua_State* L = nullptr;
-        int nresults = 0;
-        bool is_done = false;
-        std::exception_ptr exception;
-
-        std::suspend_always initial_suspend() noexcept { return {}; }
-        std::suspend_always final_suspend() noexcept { return {}; }
-
-        void unhandled_exception() noexcept
-        {
-            exception = std::current_exception();
-        }
-
         void return_void()
         {
             nresults = 0;
@@ -241,6 +529,122 @@ private:
     int m_nresults = 0;
 };
 
+//=================================================================================================
+/**
+ * @brief An awaitable calling a Lua function on a child thread, without blocking the awaiting CppCoroutine.
+ *
+ * Each time the called function yields, the CppCoroutine is suspended and the yielded values are yielded from the Lua thread
+ * running it. When that thread is resumed, the resume arguments are passed back to the called function. When the function
+ * returns, the awaiting CppCoroutine is resumed with its return values decoded to R.
+ *
+ * @tparam R The type of the return values, as in `LuaRef::call`.
+ *
+ * @see callAsync
+ */
+template <class R, class... Args>
+class LuaAsyncCall
+{
+public:
+    template <class... Ts>
+    explicit LuaAsyncCall(LuaRef function, Ts&&... args)
+        : m_function(std::move(function))
+        , m_thread(m_function.state())
+        , m_args(std::forward<Ts>(args)...)
+    {
+    }
+
+    bool await_ready() const noexcept
+    {
+        return false;
+    }
+
+    template <class Promise>
+    bool await_suspend(std::coroutine_handle<Promise> handle)
+    {
+        auto& promise = handle.promise();
+        lua_State* L = promise.L;
+
+        m_state.thread = lua_newthread(L);
+        m_thread = LuaRef::fromStack(L);
+
+        m_function.push(m_state.thread);
+
+        const auto [result, index] = detail::push_arguments(m_state.thread, std::move(m_args));
+        if (! result)
+        {
+            m_error = result.error();
+            return false;
+        }
+
+        m_state.status = lua_resume_x(m_state.thread, L, static_cast<int>(sizeof...(Args)), &m_state.nresults);
+        if (m_state.status != LUA_YIELD)
+            return false;
+
+        // Yield the values out of the Lua thread running the coroutine, see coroutine_continuation_body
+        if (! lua_checkstack(L, m_state.nresults))
+        {
+            m_error = makeErrorCode(ErrorCode::LuaStackOverflow);
+            return false;
+        }
+
+        lua_xmove(m_state.thread, L, m_state.nresults);
+
+        promise.nresults = m_state.nresults;
+        promise.awaiting = &m_state;
+        return true;
+    }
+
+    TypeResult<R> await_resume()
+    {
+        if (m_error)
+            return m_error;
+
+        if (m_state.status != LUABRIDGE_LUA_OK)
+        {
+            auto ec = makeErrorCode(ErrorCode::LuaFunctionCallFailed);
+
+#if LUABRIDGE_HAS_EXCEPTIONS
+            if (LuaException::areExceptionsEnabled(m_state.thread))
+                LuaException::raise(m_state.thread, ec);
+#endif
+
+            return ec;
+        }
+
+        const int firstResultIndex = lua_gettop(m_state.thread) - m_state.nresults + 1;
+        return detail::decode_call_result<R>(m_state.thread, firstResultIndex, m_state.nresults);
+    }
+
+private:
+    LuaRef m_function;
+    LuaRef m_thread;
+    std::tuple<Args...> m_args;
+    detail::AsyncCallState m_state;
+    std::error_code m_error;
+};
+
+/**
+ * @brief Call a Lua function from a CppCoroutine body, suspending the coroutine while the function yields.
+ *
+ * Example:
+ * @code
+ * .addCoroutine("orchestrate", [](luabridge::LuaRef waitTimer) -> luabridge::CppCoroutine<int> {
+ *     auto elapsed = co_await luabridge::callAsync<double>(waitTimer, 1.5); // waitTimer may call coroutine.yield
+ *     co_return elapsed ? 1 : 0;
+ * });
+ * @endcode
+ *
+ * @param function The Lua function to call.
+ * @param args The arguments to pass to the function.
+ *
+ * @returns An awaitable resolving to a `TypeResult<R>` with the decoded return values of the function.
+ */
+template <class R = void, class... Args>
+[[nodiscard]] LuaAsyncCall<R, std::decay_t<Args>...> callAsync(LuaRef function, Args&&... args)
+{
+    return LuaAsyncCall<R, std::decay_t<Args>...>(std::move(function), std::forward<Args>(args)...);
+}
+
 //=================================================================================================
 namespace detail {
 
@@ -281,6 +685,7 @@ inline constexpr bool is_cpp_coroutine_factory_v = is_cpp_coroutine_factory<F>::
  * Kept alive on the Lua thread's own stack (not in the registry) so that abandoning the
  * coroutine — i.e. letting the Lua thread be collected by the GC — automatically triggers
  * the __gc metamethod, which calls the destructor and destroys the coroutine handle.
+ * A coroutine which completes, normally or with an exception, is destroyed right away instead.
  */
 template <class CoroType>
 struct CppCoroutineFrame
@@ -299,8 +704,19 @@ struct CppCoroutineFrame
 
     ~CppCoroutineFrame()
     {
-        if (handle && !handle.done())
+        reset();
+    }
+
+    /**
+     * @brief Destroy the coroutine as soon as it completed, without waiting for the userdata to be collected.
+     */
+    void reset() noexcept
+    {
+        if (handle)
+        {
             handle.destroy();
+            handle = {};
+        }
     }
 };
 
@@ -389,30 +805,52 @@ int coroutine_continuation_body(lua_State* L, int frame_abs_idx)
     using CoroType = typename function_traits<std::remove_reference_t<F>>::result_type;
     using FrameType = CppCoroutineFrame<CoroType>;
 
-    // Discard resume arguments pushed above the frame (we don't expose them to C++ yet)
-    lua_settop(L, frame_abs_idx);
-
     // Recover the frame from its stable stack position
     auto* frame = align<FrameType>(lua_touserdata(L, frame_abs_idx));
 
-    // Resume the C++ coroutine body; yield_value/return_value will push at frame_abs_idx+1
-    frame->handle.resume();
-
     auto& promise = frame->handle.promise();
 
+    // While the body awaits a yielding Lua call, pass the resume arguments to it instead of resuming the body
+    if (AsyncCallState* awaiting = promise.awaiting)
+    {
+        const int nargs = lua_gettop(L) - frame_abs_idx;
+        lua_xmove(L, awaiting->thread, nargs);
+
+        awaiting->status = lua_resume_x(awaiting->thread, L, nargs, &awaiting->nresults);
+        if (awaiting->status == LUA_YIELD)
+        {
+            if (! lua_checkstack(L, awaiting->nresults))
+                raise_lua_error(L, "stack overflow yielding from an awaited Lua call");
+
+            lua_xmove(awaiting->thread, L, awaiting->nresults);
+            return do_yield<F>(L, awaiting->nresults, frame_abs_idx);
+        }
+
+        promise.awaiting = nullptr;
+    }
+
+    // Discard resume arguments pushed above the frame (we don't expose them to C++ yet)
+    lua_settop(L, frame_abs_idx);
+
+    // Resume the C++ coroutine body; yield_value/return_value will push from frame_abs_idx+1
+    frame->handle.resume();
+
     if (promise.exception)
-        raise_from_exception(L, frame_abs_idx, promise.exception);
+    {
+        std::exception_ptr exception = std::move(promise.exception);
+        frame->reset();
+        raise_from_exception(L, frame_abs_idx, std::move(exception));
+    }
 
     if (promise.is_done)
     {
-        if (promise.nresults == 1)
-            lua_replace(L, frame_abs_idx); // swap return value into frame slot; pops frame userdata
-        else
-            lua_settop(L, frame_abs_idx - 1); // void: remove frame entirely
-        return promise.nresults;
+        const int nresults = promise.nresults;
+        frame->reset();
+        lua_remove(L, frame_abs_idx); // return values pushed above the frame; remove frame userdata
+        return nresults;
     }
 
-    // yield_value pushed one value above the frame; yield it, keeping frame below
+    // yield_value pushed the values above the frame; yield them, keeping frame below
     return do_yield<F>(L, promise.nresults, frame_abs_idx);
 }
 
@@ -436,9 +874,15 @@ int invoke_coroutine_entry(lua_State* L)
     LUABRIDGE_ASSERT(isfulluserdata(L, lua_upvalueindex(1)));
     auto& factory = *align<F>(lua_touserdata(L, lua_upvalueindex(1)));
 
-    // Invoke the factory to create the coroutine object.
+    // Invoke the factory to create the coroutine object, allocating its frame from the pool of the state.
     // The coroutine body does not run yet (initial_suspend returns suspend_always).
-    auto coro = invoke_callable_from_stack<ArgsPack, 1>(L, factory);
+    CoroutineFramePool* pool = CoroutineFramePool::get(L);
+
+    auto coro = invoke_callable_from_stack<ArgsPack, 1>(L, [&](auto&&... args)
+    {
+        const CoroutineFramePool::Scope scope(pool);
+        return std::invoke(factory, std::forward<decltype(args)>(args)...);
+    });
 
     // Push the frame as a Lua full userdata and remember its absolute stack position.
     // It is NOT pinned in the registry; keeping it on the thread's stack means GC will
@@ -458,18 +902,21 @@ int invoke_coroutine_entry(lua_State* L)
     auto& promise = frame->handle.promise();
 
     if (promise.exception)
-        raise_from_exception(L, frame_abs_idx, promise.exception);
+    {
+        std::exception_ptr exception = std::move(promise.exception);
+        frame->reset();
+        raise_from_exception(L, frame_abs_idx, std::move(exception));
+    }
 
     if (promise.is_done)
     {
-        if (promise.nresults == 1)
-            lua_replace(L, frame_abs_idx); // swap return value into frame slot
-        else
-            lua_settop(L, frame_abs_idx - 1); // void: remove frame
-        return promise.nresults;
+        const int nresults = promise.nresults;
+        frame->reset();
+        lua_remove(L, frame_abs_idx); // return values pushed above the frame; remove frame userdata
+        return nresults;
     }
 
-    // yield_value pushed one value above the frame; yield it, keeping frame below
+    // yield_value pushed the values above the frame; yield them, keeping frame below
     return do_yield<F>(L, promise.nresults, frame_abs_idx);
 }
 
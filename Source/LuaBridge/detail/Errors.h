@@ -39,7 +39,9 @@ enum class ErrorCode
 
     CoroutineYieldFromNonCoroutine,
 
-    CoroutineAlreadyDone
+    CoroutineAlreadyDone,
+
+    ValueNotTransferable
 };
 
 //=================================================================================================
@@ -87,6 +89,9 @@ struct ErrorCategory : std::error_category
         case ErrorCode::CoroutineAlreadyDone:
             return "The Lua coroutine has already finished execution";
 
+        case ErrorCode::ValueNotTransferable:
+            return "The lua value can't be transferred to another lua state";
+
         default:
             return "Unknown error";
         }
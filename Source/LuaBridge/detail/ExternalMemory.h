@@ -0,0 +1,250 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Config.h"
+#include "ClassInfo.h"
+#include "LuaHelpers.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+
+namespace luabridge {
+namespace detail {
+
+//=================================================================================================
+/**
+ * @brief Signature of the estimators of the external memory owned by an object, set with `Class<T>::setMemoryEstimator`.
+ */
+template <class T>
+using MemoryEstimator = std::size_t (*)(const T&);
+
+/**
+ * @brief Whether a memory estimator was ever set for T, in any Lua state.
+ *
+ * While it is false, the objects of T skip the estimator lookup in their metatable. The flag is sticky: removing the estimator,
+ * or closing the states that registered it, leaves it set and only costs the lookup.
+ */
+template <class T>
+std::atomic<bool>& memory_estimator_ever_set() noexcept
+{
+    static std::atomic<bool> isSet = false;
+    return isSet;
+}
+
+/**
+ * @brief Reported external bytes accumulated before advancing the garbage collector.
+ */
+inline constexpr std::uint64_t external_memory_step_size = 64 * 1024;
+
+/**
+ * @brief Number of `__gc` metamethods of classes running on the current thread.
+ *
+ * Lua 5.4 forbids `lua_gc` from a finalizer, so the objects constructed by a destructor only accumulate their external memory.
+ */
+inline int& running_finalizers() noexcept
+{
+    static thread_local int count = 0;
+    return count;
+}
+
+/**
+ * @brief Mark the scope of a `__gc` metamethod.
+ */
+struct FinalizerScope
+{
+    FinalizerScope() noexcept
+    {
+        ++running_finalizers();
+    }
+
+    ~FinalizerScope()
+    {
+        --running_finalizers();
+    }
+
+    FinalizerScope(const FinalizerScope&) = delete;
+    FinalizerScope& operator=(const FinalizerScope&) = delete;
+};
+
+//=================================================================================================
+/**
+ * @brief External memory accounting of a Lua state.
+ */
+struct ExternalMemoryAccount
+{
+    std::uint64_t live = 0;    ///< Estimated external bytes of the objects not yet collected.
+    std::uint64_t pending = 0; ///< Reported bytes not yet turned into a garbage collector step.
+};
+
+/**
+ * @brief Push the external memory table of a Lua state, creating it if needed.
+ *
+ * The table maps the light userdata of the reported objects to their estimated size, and holds the `ExternalMemoryAccount` of
+ * the state under the external memory key.
+ */
+inline ExternalMemoryAccount* push_external_memory_table(lua_State* L)
+{
+    lua_rawgetp_x(L, LUA_REGISTRYINDEX, getExternalMemoryKey()); // Stack: external memory table (em) | nil
+    if (lua_istable(L, -1))
+    {
+        lua_rawgetp_x(L, -1, getExternalMemoryKey()); // Stack: em, account
+        auto* account = static_cast<ExternalMemoryAccount*>(lua_touserdata(L, -1));
+        lua_pop(L, 1); // Stack: em
+
+        return account;
+    }
+
+    lua_pop(L, 1);
+    lua_newtable(L); // Stack: em
+
+    auto* account = new (lua_newuserdata_x<ExternalMemoryAccount>(L, sizeof(ExternalMemoryAccount))) ExternalMemoryAccount(); // Stack: em, account
+    lua_rawsetp_x(L, -2, getExternalMemoryKey()); // em [externalMemoryKey] = account. Stack: em
+
+    lua_pushvalue(L, -1); // Stack: em, em
+    lua_rawsetp_x(L, LUA_REGISTRYINDEX, getExternalMemoryKey()); // Stack: em
+
+    return account;
+}
+
+/**
+ * @brief Report the external memory of an object stored by value, if its class has a memory estimator.
+ *
+ * The estimate is added to the external memory of the state. Once `external_memory_step_size` bytes are reported, they advance
+ * the garbage collector by an incremental step of the same size, as if Lua allocated them, unless a finalizer is running.
+ *
+ * Luau gives userdata destructors no access to the Lua state, so the estimates could never be released: they are ignored.
+ *
+ * @param L A Lua state.
+ * @param index The index of the userdata holding the object, with its class table as metatable.
+ * @param object The object.
+ */
+template <class T>
+void report_external_memory(lua_State* L, int index, const T& object)
+{
+#if LUABRIDGE_ON_LUAU
+    unused(L, index, object);
+#else
+    if (! memory_estimator_ever_set<T>().load(std::memory_order_relaxed))
+        return;
+
+    index = lua_absindex(L, index);
+
+    if (! lua_getmetatable(L, index)) // Stack: metatable (mt)
+        return;
+
+    lua_rawgetp_x(L, -1, getMemoryEstimatorKey()); // Stack: mt, estimator | nil
+    const auto estimator = reinterpret_cast<MemoryEstimator<T>>(lua_touserdata(L, -1));
+    lua_pop(L, 2);
+
+    if (estimator == nullptr)
+        return;
+
+    const std::size_t bytes = estimator(object);
+    if (bytes == 0)
+        return;
+
+    auto* account = push_external_memory_table(L); // Stack: em
+    lua_pushlightuserdata(L, lua_touserdata(L, index)); // Stack: em, key
+    lua_pushnumber(L, static_cast<lua_Number>(bytes)); // Stack: em, key, size
+    lua_rawset(L, -3); // em [key] = size. Stack: em
+    lua_pop(L, 1);
+
+    account->live += bytes;
+    account->pending += bytes;
+
+    if (account->pending >= external_memory_step_size && running_finalizers() == 0)
+    {
+        const auto kilobytes = std::min(account->pending / 1024, static_cast<std::uint64_t>(INT_MAX));
+        account->pending -= kilobytes * 1024;
+
+        lua_gc(L, LUA_GCSTEP, static_cast<int>(kilobytes));
+    }
+#endif
+}
+
+/**
+ * @brief Release the external memory reported for a userdata whose object is destroyed, whatever its class.
+ *
+ * @param L A Lua state.
+ * @param index The index of the userdata.
+ */
+inline void release_external_memory_entry(lua_State* L, int index)
+{
+    index = lua_absindex(L, index);
+
+    lua_rawgetp_x(L, LUA_REGISTRYINDEX, getExternalMemoryKey()); // Stack: external memory table (em) | nil
+    if (! lua_istable(L, -1))
+    {
+        lua_pop(L, 1);
+        return;
+    }
+
+    void* key = lua_touserdata(L, index);
+
+    lua_rawgetp_x(L, -1, key); // Stack: em, size | nil
+    const auto bytes = static_cast<std::uint64_t>(lua_tonumber(L, -1));
+    lua_pop(L, 1); // Stack: em
+
+    if (bytes > 0)
+    {
+        lua_pushnil(L); // Stack: em, nil
+        lua_rawsetp_x(L, -2, key); // em [key] = nil. Stack: em
+
+        lua_rawgetp_x(L, -1, getExternalMemoryKey()); // Stack: em, account
+        auto* account = static_cast<ExternalMemoryAccount*>(lua_touserdata(L, -1));
+        account->live -= std::min(account->live, bytes);
+        lua_pop(L, 1); // Stack: em
+    }
+
+    lua_pop(L, 1);
+}
+
+/**
+ * @brief Release the external memory reported for a userdata of a class being collected.
+ *
+ * @param L A Lua state.
+ * @param index The index of the userdata.
+ */
+template <class T>
+void release_external_memory(lua_State* L, int index)
+{
+    if (! memory_estimator_ever_set<T>().load(std::memory_order_relaxed))
+        return;
+
+    release_external_memory_entry(L, index);
+}
+
+} // namespace detail
+
+//=================================================================================================
+/**
+ * @brief Get the estimated external memory owned by the objects of a Lua state not yet collected.
+ *
+ * Only the objects stored by value of the classes registered with `Class<T>::setMemoryEstimator` are accounted.
+ *
+ * @note Always 0 on Luau, where the estimates are ignored.
+ */
+inline std::size_t getExternalMemory(lua_State* L)
+{
+    lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getExternalMemoryKey()); // Stack: external memory table (em) | nil
+    if (! lua_istable(L, -1))
+    {
+        lua_pop(L, 1);
+        return 0;
+    }
+
+    lua_rawgetp_x(L, -1, detail::getExternalMemoryKey()); // Stack: em, account
+    const auto* account = static_cast<const detail::ExternalMemoryAccount*>(lua_touserdata(L, -1));
+    lua_pop(L, 2);
+
+    return static_cast<std::size_t>(account->live);
+}
+
+} // namespace luabridge
@@ -5,10 +5,12 @@
 #pragma once
 
 #include "Config.h"
+#include "LuaHelpers.h"
 #include "Stack.h"
 
 #include <optional>
 #include <type_traits>
+#include <utility>
 
 namespace luabridge {
 
@@ -74,4 +76,256 @@ bool setGlobal(lua_State* L, T&& t, const char* name)
     return false;
 }
 
+//=================================================================================================
+namespace detail {
+
+/**
+ * @brief Push the globals table of the state onto the stack.
+ */
+inline void push_globals_table(lua_State* L)
+{
+#if LUA_VERSION_NUM < 502
+    lua_pushvalue(L, LUA_GLOBALSINDEX);
+#else
+    lua_rawgeti(L, LUA_REGISTRYINDEX, LUA_RIDX_GLOBALS);
+#endif
+}
+
+/**
+ * @brief Check if two stack values are the same Lua value, telling apart integers and floats with the same value.
+ */
+inline bool is_same_lua_value(lua_State* L, int index1, int index2)
+{
+    if (! lua_rawequal(L, index1, index2))
+        return false;
+
+#if LUA_VERSION_NUM >= 503 && ! LUABRIDGE_ON_LUAU
+    if (lua_type(L, index1) == LUA_TNUMBER)
+        return lua_isinteger(L, index1) == lua_isinteger(L, index2);
+#endif
+
+    return true;
+}
+
+/**
+ * @brief Detect if a global handle of type T can cache its value.
+ *
+ * Numbers, booleans and enums convert with a single call into Lua: checking the cache costs more than converting them again.
+ */
+template <class T>
+inline static constexpr bool is_cacheable_global_v = ! std::is_arithmetic_v<T> && ! std::is_enum_v<T>;
+
+} // namespace detail
+
+//=================================================================================================
+/**
+ * @brief A handle to a global variable that avoids repeated lookups of the globals table and of the variable name.
+ *
+ * The globals table and the interned name string are pinned in the registry when the handle is constructed, so reading and
+ * writing the global only costs two registry lookups and a table access, instead of hashing the name on every access. The
+ * globals table is accessed with `lua_gettable` and `lua_settable`, so its metamethods (like the ones of strict.lua) are honored.
+ *
+ * When constructed with `cached` set to true, the handle additionally keeps the last converted value, and returns it without
+ * converting again as long as the global still holds the same Lua value (compared with `lua_rawequal`). The globals table is
+ * never modified. Because of that:
+ *
+ * - Every `get` still reads the global from the globals table, and checking the cache costs two more registry lookups: the
+ *   cache only pays off for types built from tables, like containers, whose conversion walks the whole table. For numbers,
+ *   booleans and enums the flag is ignored, and strings or `LuaRef` gain little, as copying them costs about as much as
+ *   converting them.
+ * - Changes inside a table or userdata held by the global keep the same Lua value, and are not observed by the cached value.
+ * - The handle keeps a reference to the last value read, which is not collected until the global is read again or the handle
+ *   is destroyed.
+ *
+ * A cached handle returns copies of the cached value.
+ *
+ * @tparam T The C++ type of the global, it must be specialized by `Stack`.
+ */
+template <class T>
+class GlobalHandle
+{
+public:
+    /**
+     * @brief Construct a handle to a global variable.
+     *
+     * @param L A Lua state.
+     * @param name The name of the global variable.
+     * @param cached Whether to cache the last converted value of the global, ignored for numbers, booleans and enums.
+     */
+    GlobalHandle(lua_State* L, const char* name, bool cached = false)
+        : m_L(L)
+    {
+        LUABRIDGE_ASSERT(name != nullptr);
+
+        const StackRestore stackRestore(L);
+
+        lua_pushstring(L, name);
+        m_keyRef = luaL_ref(L, LUA_REGISTRYINDEX);
+
+        if (cached && detail::is_cacheable_global_v<T>)
+        {
+            lua_createtable(L, 1, 0); // Stack: last value table
+            m_lastValueRef = luaL_ref(L, LUA_REGISTRYINDEX);
+        }
+
+        detail::push_globals_table(L);
+        m_globalsRef = luaL_ref(L, LUA_REGISTRYINDEX);
+    }
+
+    GlobalHandle(const GlobalHandle&) = delete;
+    GlobalHandle& operator=(const GlobalHandle&) = delete;
+
+    GlobalHandle(GlobalHandle&& other) noexcept
+        : m_L(std::exchange(other.m_L, nullptr))
+        , m_globalsRef(std::exchange(other.m_globalsRef, LUA_NOREF))
+        , m_keyRef(std::exchange(other.m_keyRef, LUA_NOREF))
+        , m_lastValueRef(std::exchange(other.m_lastValueRef, LUA_NOREF))
+        , m_cache(std::move(other.m_cache))
+    {
+        other.m_cache.reset();
+    }
+
+    GlobalHandle& operator=(GlobalHandle&& other) noexcept
+    {
+        if (this != &other)
+        {
+            release();
+
+            m_L = std::exchange(other.m_L, nullptr);
+            m_globalsRef = std::exchange(other.m_globalsRef, LUA_NOREF);
+            m_keyRef = std::exchange(other.m_keyRef, LUA_NOREF);
+            m_lastValueRef = std::exchange(other.m_lastValueRef, LUA_NOREF);
+            m_cache = std::move(other.m_cache);
+            other.m_cache.reset();
+        }
+
+        return *this;
+    }
+
+    ~GlobalHandle()
+    {
+        release();
+    }
+
+    /**
+     * @brief Get the value of the global.
+     *
+     * @returns The converted value, or an error code if the value could not be converted to `T`.
+     */
+    TypeResult<T> get() const
+    {
+#if LUABRIDGE_SAFE_STACK_CHECKS
+        if (! lua_checkstack(m_L, 4))
+            return makeErrorCode(ErrorCode::LuaStackOverflow);
+#endif
+
+        lua_rawgeti(m_L, LUA_REGISTRYINDEX, m_globalsRef); // Stack: globals table (g)
+        lua_rawgeti(m_L, LUA_REGISTRYINDEX, m_keyRef); // Stack: g, key
+        lua_gettable(m_L, -2); // Stack: g, value
+
+        if (m_lastValueRef != LUA_NOREF)
+        {
+            lua_rawgeti(m_L, LUA_REGISTRYINDEX, m_lastValueRef); // Stack: g, value, last value table (lv)
+            lua_rawgeti(m_L, -1, 1); // Stack: g, value, lv, last value
+
+            if (m_cache && detail::is_same_lua_value(m_L, -1, -3))
+            {
+                lua_pop(m_L, 4);
+                return *m_cache;
+            }
+
+            lua_pop(m_L, 1); // Stack: g, value, lv
+            lua_pushvalue(m_L, -2); // Stack: g, value, lv, value
+            lua_rawseti(m_L, -2, 1); // lv [1] = value. Stack: g, value, lv
+            lua_pop(m_L, 1); // Stack: g, value
+        }
+
+        auto result = Stack<T>::get(m_L, -1);
+        lua_pop(m_L, 2);
+
+        if (m_lastValueRef != LUA_NOREF)
+        {
+            if (result)
+                m_cache = *result;
+            else
+                m_cache.reset();
+        }
+
+        return result;
+    }
+
+    /**
+     * @brief Assign a new value to the global.
+     *
+     * @returns An error code if the value could not be pushed.
+     */
+    template <class U>
+    Result set(const U& value)
+    {
+#if LUABRIDGE_SAFE_STACK_CHECKS
+        if (! lua_checkstack(m_L, 3))
+            return makeErrorCode(ErrorCode::LuaStackOverflow);
+#endif
+
+        lua_rawgeti(m_L, LUA_REGISTRYINDEX, m_globalsRef);
+        lua_rawgeti(m_L, LUA_REGISTRYINDEX, m_keyRef);
+
+        if (auto result = Stack<U>::push(m_L, value); ! result)
+        {
+            lua_pop(m_L, 2);
+            return result;
+        }
+
+        lua_settable(m_L, -3);
+        lua_pop(m_L, 1);
+
+        return {};
+    }
+
+    /**
+     * @brief Returns true if the handle is caching the value of the global.
+     */
+    [[nodiscard]] bool isCached() const noexcept
+    {
+        return m_lastValueRef != LUA_NOREF;
+    }
+
+    /**
+     * @brief Drop the cached value, forcing the next `get` to read the global again.
+     */
+    void invalidate() noexcept
+    {
+        m_cache.reset();
+    }
+
+    /**
+     * @brief Get the lua_State associated with the handle.
+     */
+    [[nodiscard]] lua_State* state() const noexcept
+    {
+        return m_L;
+    }
+
+private:
+    void release() noexcept
+    {
+        if (m_L == nullptr)
+            return;
+
+        luaL_unref(m_L, LUA_REGISTRYINDEX, m_globalsRef);
+        luaL_unref(m_L, LUA_REGISTRYINDEX, m_keyRef);
+
+        if (m_lastValueRef != LUA_NOREF)
+            luaL_unref(m_L, LUA_REGISTRYINDEX, m_lastValueRef);
+
+        m_L = nullptr;
+    }
+
+    lua_State* m_L = nullptr;
+    int m_globalsRef = LUA_NOREF;
+    int m_keyRef = LUA_NOREF;
+    int m_lastValueRef = LUA_NOREF;
+    mutable std::optional<T> m_cache;
+};
+
 } // namespace luabridge
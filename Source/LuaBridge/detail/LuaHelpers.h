@@ -737,6 +737,44 @@ inline int lua_resume_x(lua_State* L, lua_State* from, int nargs, int* nresults
 #endif
 }
 
+/**
+ * @brief Portable reset of a thread which is not running, so that it can run a new function.
+ *
+ * Lua 5.4+ and Luau close the pending to-be-closed variables and reset a finished, failed or suspended thread. Older
+ * versions have no reset, so only a thread that finished without errors (or never run) is reusable, once its stack is
+ * cleared.
+ *
+ * @param L    The thread to reset.
+ * @param from The thread doing the reset (may be nullptr).
+ * @returns true if the thread has been reset and can be reused, false otherwise.
+ */
+inline bool lua_resetthread_x(lua_State* L, lua_State* from)
+{
+    // A thread with active calls and no error is running, or is resuming another thread
+    lua_Debug debug;
+    const bool isRunning = lua_status(L) == LUABRIDGE_LUA_OK && lua_getstack_x(L, 0, &debug) != 0;
+    if (isRunning)
+        return false;
+
+#if LUABRIDGE_ON_LUAU
+    unused(from);
+    lua_resetthread(L);
+#elif LUA_VERSION_NUM >= 505 || (LUA_VERSION_NUM == 504 && defined(LUA_VERSION_RELEASE_NUM) && LUA_VERSION_RELEASE_NUM >= 50406)
+    lua_closethread(L, from);
+#elif LUA_VERSION_NUM == 504 && ! LUABRIDGE_ON_RAVI
+    unused(from);
+    lua_resetthread(L);
+#else
+    unused(from);
+
+    if (lua_status(L) != LUABRIDGE_LUA_OK)
+        return false;
+#endif
+
+    lua_settop(L, 0); // Drop the error object of a failed thread
+    return true;
+}
+
 /**
  * @brief Returns true if the currently running C function can yield via lua_yieldk.
  *
@@ -0,0 +1,193 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Config.h"
+#include "ClassInfo.h"
+#include "FuncTraits.h"
+#include "LuaHelpers.h"
+#include "Stack.h"
+
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+#if LUABRIDGE_HAS_CXX17_MEMORY_RESOURCE
+#include <memory_resource>
+#endif
+
+namespace luabridge {
+
+#if LUABRIDGE_HAS_CXX17_MEMORY_RESOURCE
+//=================================================================================================
+/**
+ * @brief Set the upstream memory resource of the per-call arguments arenas of a Lua state.
+ *
+ * Bound functions taking `std::pmr` arguments by `const&` decode them from an arena local to the call, which serves allocations
+ * from an inline buffer of `LUABRIDGE_ARGUMENTS_ARENA_SIZE` bytes and then from the upstream resource. The resource must outlive
+ * its use by the Lua state. Passing `nullptr` restores the default resource.
+ *
+ * @note These arguments are only valid during the call, see `detail::ArgumentsArena`.
+ *
+ * @param L A Lua state.
+ * @param resource The upstream memory resource, or `nullptr`.
+ */
+inline void setArgumentsMemoryResource(lua_State* L, std::pmr::memory_resource* resource)
+{
+    if (resource != nullptr)
+        lua_pushlightuserdata(L, resource);
+    else
+        lua_pushnil(L);
+
+    lua_rawsetp_x(L, LUA_REGISTRYINDEX, detail::getArgumentsMemoryResourceKey());
+}
+
+/**
+ * @brief Get the upstream memory resource of the per-call arguments arenas of a Lua state.
+ *
+ * @param L A Lua state.
+ *
+ * @returns The resource set with `setArgumentsMemoryResource`, or `std::pmr::get_default_resource()` when none is set.
+ */
+[[nodiscard]] inline std::pmr::memory_resource* getArgumentsMemoryResource(lua_State* L)
+{
+    lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getArgumentsMemoryResourceKey());
+    auto* resource = static_cast<std::pmr::memory_resource*>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+
+    return resource != nullptr ? resource : std::pmr::get_default_resource();
+}
+#endif
+
+namespace detail {
+
+//=================================================================================================
+/**
+ * @brief Detect if a type can be decoded from the stack into a given memory resource.
+ */
+template <class T, class Resource, class = void>
+struct has_resource_getter : std::false_type
+{
+};
+
+template <class T, class Resource>
+struct has_resource_getter<T, Resource, std::void_t<decltype(Stack<remove_cvref_t<T>>::get(std::declval<lua_State*>(), 0, std::declval<Resource>()))>>
+    : std::true_type
+{
+};
+
+template <class T, class Resource>
+inline static constexpr bool has_resource_getter_v = has_resource_getter<T, Resource>::value;
+
+/**
+ * @brief Detect if an argument of a bound function is decoded into the arguments arena.
+ *
+ * Only `const&` arguments are: arguments taken by value or by non const reference can be moved into storage outliving the call,
+ * so they are decoded with their default allocator.
+ */
+template <class T, class Resource>
+inline static constexpr bool is_arena_argument_v =
+    std::is_lvalue_reference_v<T> && std::is_const_v<std::remove_reference_t<T>> && has_resource_getter_v<T, Resource>;
+
+//=================================================================================================
+/**
+ * @brief Arguments arena of a call not taking any allocator aware argument.
+ */
+struct NoArgumentsArena
+{
+    explicit NoArgumentsArena(lua_State*) noexcept
+    {
+    }
+
+    std::nullptr_t get() const noexcept
+    {
+        return nullptr;
+    }
+};
+
+#if LUABRIDGE_HAS_CXX17_MEMORY_RESOURCE
+//=================================================================================================
+/**
+ * @brief Monotonic arena serving the `std::pmr` arguments of a single call.
+ *
+ * Allocations are served from an inline buffer first and then from the upstream resource of the Lua state. Everything is released
+ * at once when the arena goes out of scope, after the call returned.
+ *
+ * @note Only the `const&` arguments are decoded into the arena, and they keep it as their allocator: they must not outlive the
+ *       call. Arguments taken by value can be moved into longer lived storage, and use the default resource.
+ *
+ * @note When Lua is compiled as C and raises errors with `longjmp`, an error raised by the callee skips the arena destructor:
+ *       the inline buffer is reclaimed with the C stack, but the blocks already taken from the upstream resource are leaked. Use
+ *       an upstream resource released as a whole, or keep the arguments within the inline buffer size, on such builds.
+ */
+class ArgumentsArena
+{
+public:
+    explicit ArgumentsArena(lua_State* L)
+        : m_resource(m_buffer, sizeof(m_buffer), getArgumentsMemoryResource(L))
+    {
+    }
+
+    ArgumentsArena(const ArgumentsArena&) = delete;
+    ArgumentsArena& operator=(const ArgumentsArena&) = delete;
+
+    std::pmr::monotonic_buffer_resource* get() noexcept
+    {
+        return &m_resource;
+    }
+
+private:
+    alignas(std::max_align_t) std::byte m_buffer[LUABRIDGE_ARGUMENTS_ARENA_SIZE];
+    std::pmr::monotonic_buffer_resource m_resource;
+};
+
+template <class ArgsPack>
+struct arguments_arena;
+
+template <class... Args>
+struct arguments_arena<std::tuple<Args...>>
+{
+    using type = std::conditional_t<(is_arena_argument_v<Args, std::pmr::memory_resource*> || ...), ArgumentsArena, NoArgumentsArena>;
+};
+#else
+template <class ArgsPack>
+struct arguments_arena
+{
+    using type = NoArgumentsArena;
+};
+#endif
+
+/**
+ * @brief The arguments arena needed by a call taking the given arguments pack.
+ */
+template <class ArgsPack>
+using arguments_arena_t = typename arguments_arena<ArgsPack>::type;
+
+//=================================================================================================
+/**
+ * @brief Get an argument from the stack, allocating it from the arguments arena when it is a `const&` argument.
+ */
+template <class T, class Resource>
+decltype(auto) get_argument(lua_State* L, int index, [[maybe_unused]] Resource resource)
+{
+    if constexpr (! std::is_null_pointer_v<Resource> && is_arena_argument_v<T, Resource>)
+        return Stack<remove_cvref_t<T>>::get(L, index, resource);
+    else
+        return Stack<T>::get(L, index);
+}
+
+/**
+ * @brief Release the memory of an arguments arena before raising an error.
+ */
+template <class Resource>
+void release_arguments_arena([[maybe_unused]] Resource resource) noexcept
+{
+    if constexpr (! std::is_null_pointer_v<Resource>)
+        resource->release();
+}
+
+} // namespace detail
+} // namespace luabridge
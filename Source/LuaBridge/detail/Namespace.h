@@ -9,10 +9,12 @@
 
 #include "Config.h"
 #include "ClassInfo.h"
+#include "ExternalMemory.h"
 #include "FlagSet.h"
 #include "LuaHelpers.h"
 #include "LuaException.h"
 #include "Options.h"
+#include "Profiling.h"
 #include "TypeTraits.h"
 
 #include <stdexcept>
@@ -704,6 +706,7 @@ class Namespace : public detail::Registrar
             assertStackState(); // Stack: const table (co), class table (cl), static table (st)
 
             detail::push_property_getter(L, std::move(get), name); // Stack: co, cl, st, function
+            detail::profile_binding(L, className, name, BindingKind::Getter);
             detail::add_property_getter(L, name, -2); // Stack: co, cl, st
 
             detail::push_property_readonly(L, name); // Stack: co, cl, st, function
@@ -719,9 +722,11 @@ class Namespace : public detail::Registrar
             assertStackState(); // Stack: const table (co), class table (cl), static table (st)
 
             detail::push_property_getter(L, std::move(get), name); // Stack: co, cl, st, function
+            detail::profile_binding(L, className, name, BindingKind::Getter);
             detail::add_property_getter(L, name, -2); // Stack: co, cl, st
 
             detail::push_property_setter(L, std::move(set), name); // Stack: co, cl, st, function
+            detail::profile_binding(L, className, name, BindingKind::Setter);
             detail::add_property_setter(L, name, -2); // Stack: co, cl, st
 
             return *this;
@@ -760,26 +765,28 @@ class Namespace : public detail::Registrar
             else
             {
                 // upvalue 1: OverloadSet (C++ struct with arity + type checker per overload)
-                auto* overload_set_unaligned = lua_newuserdata_aligned<detail::OverloadSet>(L);
-                auto* overload_set = align<detail::OverloadSet>(overload_set_unaligned);
-
-                ([&]
+                const auto* overload_set = detail::shared_overload_set([](detail::OverloadSet* set)
                 {
-                    detail::OverloadEntry entry;
-                    if constexpr (detail::is_any_cfunction_pointer_v<Functions>)
-                    {
-                        entry.arity = -1;
-                        entry.checker = nullptr;
-                    }
-                    else
+                    ([&]
                     {
-                        using ArgsPack = detail::function_arguments_t<Functions>;
-                        entry.arity = static_cast<int>(detail::function_arity_excluding_v<Functions, lua_State*>);
-                        entry.checker = &detail::overload_type_checker<ArgsPack>;
-                    }
-                    overload_set->entries.push_back(entry);
+                        detail::OverloadEntry entry;
+                        if constexpr (detail::is_any_cfunction_pointer_v<Functions>)
+                        {
+                            entry.arity = -1;
+                            entry.checker = nullptr;
+                        }
+                        else
+                        {
+                            using ArgsPack = detail::function_arguments_t<Functions>;
+                            entry.arity = static_cast<int>(detail::function_arity_excluding_v<Functions, lua_State*>);
+                            entry.checker = &detail::overload_type_checker<ArgsPack>;
+                        }
+                        set->entries.push_back(entry);
 
-                } (), ...);
+                    } (), ...);
+                });
+
+                lua_pushlightuserdata(L, const_cast<detail::OverloadSet*>(overload_set));
 
                 // upvalue 2: flat table of function closures indexed 1..N
                 lua_createtable(L, static_cast<int>(sizeof...(Functions)), 0);
@@ -796,6 +803,7 @@ class Namespace : public detail::Registrar
                 lua_pushcclosure_x(L, &detail::try_overload_functions<false>, name, 2);
             }
 
+            detail::profile_binding(L, className, name);
             rawsetfield(L, -2, name);
 
             return *this;
@@ -818,6 +826,7 @@ class Namespace : public detail::Registrar
 
             lua_newuserdata_aligned<FnType>(L, std::move(function)); // Stack: co, cl, st, function userdata (ud)
             lua_pushcclosure_x(L, &detail::invoke_proxy_functor<FnType>, "__index", 1); // Stack: co, cl, st, function
+            detail::profile_binding(L, className, "__index", BindingKind::IndexFallback);
             lua_rawsetp_x(L, -2, detail::getStaticIndexFallbackKey());
             setStaticMetaMethods(-1, false);
 
@@ -832,6 +841,7 @@ class Namespace : public detail::Registrar
 
             lua_pushlightuserdata(L, reinterpret_cast<void*>(idxf)); // Stack: co, cl, st, function ptr
             lua_pushcclosure_x(L, &detail::invoke_proxy_function<FnType>, "__index", 1); // Stack: co, cl, st, function
+            detail::profile_binding(L, className, "__index", BindingKind::IndexFallback);
             lua_rawsetp_x(L, -2, detail::getStaticIndexFallbackKey());
             setStaticMetaMethods(-1, false);
 
@@ -855,6 +865,7 @@ class Namespace : public detail::Registrar
 
             lua_newuserdata_aligned<FnType>(L, std::move(function)); // Stack: co, cl, st, function userdata (ud)
             lua_pushcclosure_x(L, &detail::invoke_proxy_functor<FnType>, "__newindex", 1); // Stack: co, cl, st, function
+            detail::profile_binding(L, className, "__newindex", BindingKind::NewIndexFallback);
             lua_rawsetp_x(L, -2, detail::getStaticNewIndexFallbackKey());
             setStaticMetaMethods(-1, false);
 
@@ -869,6 +880,7 @@ class Namespace : public detail::Registrar
 
             lua_pushlightuserdata(L, reinterpret_cast<void*>(idxf)); // Stack: co, cl, st, function ptr
             lua_pushcclosure_x(L, &detail::invoke_proxy_function<FnType>, "__newindex", 1); // Stack: co, cl, st, function
+            detail::profile_binding(L, className, "__newindex", BindingKind::NewIndexFallback);
             lua_rawsetp_x(L, -2, detail::getStaticNewIndexFallbackKey());
             setStaticMetaMethods(-1, false);
 
@@ -889,6 +901,7 @@ class Namespace : public detail::Registrar
             assertStackState(); // Stack: const table (co), class table (cl), static table (st)
 
             detail::push_class_property_getter<T>(L, std::move(getter), name); // Stack: co, cl, st, getter
+            detail::profile_binding(L, className, name, BindingKind::Getter);
             lua_pushvalue(L, -1); // Stack: co, cl, st, getter, getter
             detail::add_property_getter(L, name, -4); // Stack: co, cl, st, getter
             detail::add_property_getter(L, name, -4); // Stack: co, cl, st
@@ -906,11 +919,13 @@ class Namespace : public detail::Registrar
             assertStackState(); // Stack: const table (co), class table (cl), static table (st)
 
             detail::push_class_property_getter<T>(L, std::move(getter), name); // Stack: co, cl, st, getter
+            detail::profile_binding(L, className, name, BindingKind::Getter);
             lua_pushvalue(L, -1); // Stack: co, cl, st, getter, getter
             detail::add_property_getter(L, name, -4); // Stack: co, cl, st, getter
             detail::add_property_getter(L, name, -4); // Stack: co, cl, st
 
             detail::push_class_property_setter<T>(L, std::move(setter), name); // Stack: co, cl, st, setter
+            detail::profile_binding(L, className, name, BindingKind::Setter);
             detail::add_property_setter(L, name, -3); // Stack: co, cl, st
 
             return *this;
@@ -952,6 +967,8 @@ class Namespace : public detail::Registrar
 
                 } (), ...);
 
+                detail::profile_binding(L, className, name);
+
                 if constexpr (detail::const_functions_count<T, Functions...> == 1)
                 {
                     lua_pushvalue(L, -1); // Stack: co, cl, st, function, function
@@ -969,35 +986,37 @@ class Namespace : public detail::Registrar
                 if constexpr (detail::const_functions_count<T, Functions...> > 0)
                 {
                     // upvalue 1: OverloadSet
-                    auto* overload_set_const_unaligned = lua_newuserdata_aligned<detail::OverloadSet>(L);
-                    auto* overload_set_const = align<detail::OverloadSet>(overload_set_const_unaligned);
-
-                    ([&]
+                    const auto* overload_set_const = detail::shared_overload_set([](detail::OverloadSet* set)
                     {
-                        if (!detail::is_const_function<T, Functions>)
-                            return;
-
-                        detail::OverloadEntry entry;
-                        if constexpr (detail::is_any_cfunction_pointer_v<Functions>)
-                        {
-                            entry.arity = -1;
-                            entry.checker = nullptr;
-                        }
-                        else if constexpr (detail::is_proxy_member_function_v<T, Functions>)
-                        {
-                            using ArgsPack = detail::remove_first_type_t<detail::function_arguments_t<Functions>>;
-                            entry.arity = static_cast<int>(detail::member_function_arity_excluding_v<T, Functions, lua_State*>);
-                            entry.checker = &detail::overload_type_checker<ArgsPack>;
-                        }
-                        else
+                        ([&]
                         {
-                            using ArgsPack = detail::function_arguments_t<Functions>;
-                            entry.arity = static_cast<int>(detail::member_function_arity_excluding_v<T, Functions, lua_State*>);
-                            entry.checker = &detail::overload_type_checker<ArgsPack>;
-                        }
-                        overload_set_const->entries.push_back(entry);
-
-                    } (), ...);
+                            if (!detail::is_const_function<T, Functions>)
+                                return;
+
+                            detail::OverloadEntry entry;
+                            if constexpr (detail::is_any_cfunction_pointer_v<Functions>)
+                            {
+                                entry.arity = -1;
+                                entry.checker = nullptr;
+                            }
+                            else if constexpr (detail::is_proxy_member_function_v<T, Functions>)
+                            {
+                                using ArgsPack = detail::remove_first_type_t<detail::function_arguments_t<Functions>>;
+                                entry.arity = static_cast<int>(detail::member_function_arity_excluding_v<T, Functions, lua_State*>);
+                                entry.checker = &detail::overload_type_checker<ArgsPack>;
+                            }
+                            else
+                            {
+                                using ArgsPack = detail::function_arguments_t<Functions>;
+                                entry.arity = static_cast<int>(detail::member_function_arity_excluding_v<T, Functions, lua_State*>);
+                                entry.checker = &detail::overload_type_checker<ArgsPack>;
+                            }
+                            set->entries.push_back(entry);
+
+                        } (), ...);
+                    });
+
+                    lua_pushlightuserdata(L, const_cast<detail::OverloadSet*>(overload_set_const));
 
                     LUABRIDGE_ASSERT(!overload_set_const->entries.empty());
 
@@ -1017,6 +1036,7 @@ class Namespace : public detail::Registrar
                     } (), ...);
 
                     lua_pushcclosure_x(L, &detail::try_overload_functions<true>, name, 2);
+                    detail::profile_binding(L, className, name);
                     lua_pushvalue(L, -1); // Stack: co, cl, st, function, function
                     rawsetfield(L, -4, name); // Stack: co, cl, st, function
                     rawsetfield(L, -4, name); // Stack: co, cl, st
@@ -1026,35 +1046,37 @@ class Namespace : public detail::Registrar
                 if constexpr (detail::non_const_functions_count<T, Functions...> > 0)
                 {
                     // upvalue 1: OverloadSet
-                    auto* overload_set_nonconst_unaligned = lua_newuserdata_aligned<detail::OverloadSet>(L);
-                    auto* overload_set_nonconst = align<detail::OverloadSet>(overload_set_nonconst_unaligned);
-
-                    ([&]
+                    const auto* overload_set_nonconst = detail::shared_overload_set([](detail::OverloadSet* set)
                     {
-                        if (detail::is_const_function<T, Functions>)
-                            return;
-
-                        detail::OverloadEntry entry;
-                        if constexpr (detail::is_any_cfunction_pointer_v<Functions>)
+                        ([&]
                         {
-                            entry.arity = -1;
-                            entry.checker = nullptr;
-                        }
-                        else if constexpr (detail::is_proxy_member_function_v<T, Functions>)
-                        {
-                            using ArgsPack = detail::remove_first_type_t<detail::function_arguments_t<Functions>>;
-                            entry.arity = static_cast<int>(detail::member_function_arity_excluding_v<T, Functions, lua_State*>);
-                            entry.checker = &detail::overload_type_checker<ArgsPack>;
-                        }
-                        else
-                        {
-                            using ArgsPack = detail::function_arguments_t<Functions>;
-                            entry.arity = static_cast<int>(detail::member_function_arity_excluding_v<T, Functions, lua_State*>);
-                            entry.checker = &detail::overload_type_checker<ArgsPack>;
-                        }
-                        overload_set_nonconst->entries.push_back(entry);
-
-                    } (), ...);
+                            if (detail::is_const_function<T, Functions>)
+                                return;
+
+                            detail::OverloadEntry entry;
+                            if constexpr (detail::is_any_cfunction_pointer_v<Functions>)
+                            {
+                                entry.arity = -1;
+                                entry.checker = nullptr;
+                            }
+                            else if constexpr (detail::is_proxy_member_function_v<T, Functions>)
+                            {
+                                using ArgsPack = detail::remove_first_type_t<detail::function_arguments_t<Functions>>;
+                                entry.arity = static_cast<int>(detail::member_function_arity_excluding_v<T, Functions, lua_State*>);
+                                entry.checker = &detail::overload_type_checker<ArgsPack>;
+                            }
+                            else
+                            {
+                                using ArgsPack = detail::function_arguments_t<Functions>;
+                                entry.arity = static_cast<int>(detail::member_function_arity_excluding_v<T, Functions, lua_State*>);
+                                entry.checker = &detail::overload_type_checker<ArgsPack>;
+                            }
+                            set->entries.push_back(entry);
+
+                        } (), ...);
+                    });
+
+                    lua_pushlightuserdata(L, const_cast<detail::OverloadSet*>(overload_set_nonconst));
 
                     LUABRIDGE_ASSERT(!overload_set_nonconst->entries.empty());
 
@@ -1074,6 +1096,7 @@ class Namespace : public detail::Registrar
                     } (), ...);
 
                     lua_pushcclosure_x(L, &detail::try_overload_functions<true>, name, 2);
+                    detail::profile_binding(L, className, name);
                     rawsetfield(L, -3, name); // Stack: co, cl, st
                 }
             }
@@ -1103,6 +1126,7 @@ class Namespace : public detail::Registrar
             assertStackState(); // Stack: const table (co), class table (cl), static table (st)
 
             detail::push_coroutine_function(L, std::move(factory), name);
+            detail::profile_binding(L, className, name);
             rawsetfield(L, -2, name); // Stack: co, cl, st  (into st)
 
             return *this;
@@ -1137,6 +1161,7 @@ class Namespace : public detail::Registrar
             assertStackState(); // Stack: const table (co), class table (cl), static table (st)
 
             detail::push_coroutine_function(L, std::move(factory), name);
+            detail::profile_binding(L, className, name);
 
             if constexpr (detail::is_const_function<T, F>)
             {
@@ -1179,18 +1204,20 @@ class Namespace : public detail::Registrar
             else
             {
                 // upvalue 1: OverloadSet
-                auto* overload_set_unaligned = lua_newuserdata_aligned<detail::OverloadSet>(L);
-                auto* overload_set = align<detail::OverloadSet>(overload_set_unaligned);
-
-                ([&]
+                const auto* overload_set = detail::shared_overload_set([](detail::OverloadSet* set)
                 {
-                    using ArgsPack = detail::function_arguments_t<Functions>;
-                    detail::OverloadEntry entry;
-                    entry.arity = static_cast<int>(detail::function_arity_excluding_v<Functions, lua_State*>);
-                    entry.checker = &detail::overload_type_checker<ArgsPack>;
-                    overload_set->entries.push_back(entry);
+                    ([&]
+                    {
+                        using ArgsPack = detail::function_arguments_t<Functions>;
+                        detail::OverloadEntry entry;
+                        entry.arity = static_cast<int>(detail::function_arity_excluding_v<Functions, lua_State*>);
+                        entry.checker = &detail::overload_type_checker<ArgsPack>;
+                        set->entries.push_back(entry);
 
-                } (), ...);
+                    } (), ...);
+                });
+
+                lua_pushlightuserdata(L, const_cast<detail::OverloadSet*>(overload_set));
 
                 // upvalue 2: flat table of function closures
                 lua_createtable(L, static_cast<int>(sizeof...(Functions)), 0);
@@ -1207,6 +1234,7 @@ class Namespace : public detail::Registrar
                 lua_pushcclosure_x(L, &detail::try_overload_functions<true>, className, 2);
             }
 
+            detail::profile_binding(L, className, className, BindingKind::Constructor);
             rawsetfield(L, -2, "__call");
 
             return *this;
@@ -1244,27 +1272,29 @@ class Namespace : public detail::Registrar
             else
             {
                 // upvalue 1: OverloadSet
-                auto* overload_set_unaligned = lua_newuserdata_aligned<detail::OverloadSet>(L);
-                auto* overload_set = align<detail::OverloadSet>(overload_set_unaligned);
-
-                ([&]
+                const auto* overload_set = detail::shared_overload_set([](detail::OverloadSet* set)
                 {
-                    detail::OverloadEntry entry;
-                    if constexpr (detail::is_any_cfunction_pointer_v<Functions>)
-                    {
-                        entry.arity = -1;
-                        entry.checker = nullptr;
-                    }
-                    else
+                    ([&]
                     {
-                        // skip void* first arg (placement new destination, not a Lua argument)
-                        using ArgsPack = detail::remove_first_type_t<detail::function_arguments_t<Functions>>;
-                        entry.arity = static_cast<int>(detail::function_arity_excluding_v<Functions, lua_State*>) - 1;
-                        entry.checker = &detail::overload_type_checker<ArgsPack>;
-                    }
-                    overload_set->entries.push_back(entry);
+                        detail::OverloadEntry entry;
+                        if constexpr (detail::is_any_cfunction_pointer_v<Functions>)
+                        {
+                            entry.arity = -1;
+                            entry.checker = nullptr;
+                        }
+                        else
+                        {
+                            // skip void* first arg (placement new destination, not a Lua argument)
+                            using ArgsPack = detail::remove_first_type_t<detail::function_arguments_t<Functions>>;
+                            entry.arity = static_cast<int>(detail::function_arity_excluding_v<Functions, lua_State*>) - 1;
+                            entry.checker = &detail::overload_type_checker<ArgsPack>;
+                        }
+                        set->entries.push_back(entry);
 
-                } (), ...);
+                    } (), ...);
+                });
+
+                lua_pushlightuserdata(L, const_cast<detail::OverloadSet*>(overload_set));
 
                 // upvalue 2: flat table of function closures
                 lua_createtable(L, static_cast<int>(sizeof...(Functions)), 0);
@@ -1284,6 +1314,7 @@ class Namespace : public detail::Registrar
                 lua_pushcclosure_x(L, &detail::try_overload_functions<true>, className, 2);
             }
 
+            detail::profile_binding(L, className, className, BindingKind::Constructor);
             rawsetfield(L, -2, "__call"); // Stack: co, cl, st
 
             return *this;
@@ -1310,18 +1341,20 @@ class Namespace : public detail::Registrar
             else
             {
                 // upvalue 1: OverloadSet
-                auto* overload_set_unaligned = lua_newuserdata_aligned<detail::OverloadSet>(L);
-                auto* overload_set = align<detail::OverloadSet>(overload_set_unaligned);
-
-                ([&]
+                const auto* overload_set = detail::shared_overload_set([](detail::OverloadSet* set)
                 {
-                    using ArgsPack = detail::function_arguments_t<Functions>;
-                    detail::OverloadEntry entry;
-                    entry.arity = static_cast<int>(detail::function_arity_excluding_v<Functions, lua_State*>);
-                    entry.checker = &detail::overload_type_checker<ArgsPack>;
-                    overload_set->entries.push_back(entry);
+                    ([&]
+                    {
+                        using ArgsPack = detail::function_arguments_t<Functions>;
+                        detail::OverloadEntry entry;
+                        entry.arity = static_cast<int>(detail::function_arity_excluding_v<Functions, lua_State*>);
+                        entry.checker = &detail::overload_type_checker<ArgsPack>;
+                        set->entries.push_back(entry);
 
-                } (), ...);
+                    } (), ...);
+                });
+
+                lua_pushlightuserdata(L, const_cast<detail::OverloadSet*>(overload_set));
 
                 // upvalue 2: flat table of function closures
                 lua_createtable(L, static_cast<int>(sizeof...(Functions)), 0);
@@ -1338,6 +1371,7 @@ class Namespace : public detail::Registrar
                 lua_pushcclosure_x(L, &detail::try_overload_functions<true>, className, 2);
             }
 
+            detail::profile_binding(L, className, className, BindingKind::Constructor);
             rawsetfield(L, -2, "__call");
 
             return *this;
@@ -1371,26 +1405,28 @@ class Namespace : public detail::Registrar
             else
             {
                 // upvalue 1: OverloadSet
-                auto* overload_set_unaligned = lua_newuserdata_aligned<detail::OverloadSet>(L);
-                auto* overload_set = align<detail::OverloadSet>(overload_set_unaligned);
-
-                ([&]
+                const auto* overload_set = detail::shared_overload_set([](detail::OverloadSet* set)
                 {
-                    detail::OverloadEntry entry;
-                    if constexpr (detail::is_any_cfunction_pointer_v<Functions>)
-                    {
-                        entry.arity = -1;
-                        entry.checker = nullptr;
-                    }
-                    else
+                    ([&]
                     {
-                        using ArgsPack = detail::function_arguments_t<Functions>;
-                        entry.arity = static_cast<int>(detail::function_arity_excluding_v<Functions, lua_State*>);
-                        entry.checker = &detail::overload_type_checker<ArgsPack>;
-                    }
-                    overload_set->entries.push_back(entry);
+                        detail::OverloadEntry entry;
+                        if constexpr (detail::is_any_cfunction_pointer_v<Functions>)
+                        {
+                            entry.arity = -1;
+                            entry.checker = nullptr;
+                        }
+                        else
+                        {
+                            using ArgsPack = detail::function_arguments_t<Functions>;
+                            entry.arity = static_cast<int>(detail::function_arity_excluding_v<Functions, lua_State*>);
+                            entry.checker = &detail::overload_type_checker<ArgsPack>;
+                        }
+                        set->entries.push_back(entry);
 
-                } (), ...);
+                    } (), ...);
+                });
+
+                lua_pushlightuserdata(L, const_cast<detail::OverloadSet*>(overload_set));
 
                 // upvalue 2: flat table of function closures
                 lua_createtable(L, static_cast<int>(sizeof...(Functions)), 0);
@@ -1410,6 +1446,7 @@ class Namespace : public detail::Registrar
                 lua_pushcclosure_x(L, &detail::try_overload_functions<true>, className, 2);
             }
 
+            detail::profile_binding(L, className, className, BindingKind::Constructor);
             rawsetfield(L, -2, "__call"); // Stack: co, cl, st
 
             return *this;
@@ -1430,6 +1467,7 @@ class Namespace : public detail::Registrar
             lua_newuserdata_aligned<F>(L, F(std::move(function))); // Stack: co, cl, st, upvalue
             lua_pushcclosure_x(L, &detail::invoke_proxy_destructor<F>, className, 1); // Stack: co, cl, st, function
 
+            detail::profile_binding(L, className, className, BindingKind::Destructor);
             rawsetfield(L, -3, "__destruct"); // Stack: co, cl, st
 
             return *this;
@@ -1453,6 +1491,7 @@ class Namespace : public detail::Registrar
 
             lua_newuserdata_aligned<F>(L, F(std::move(allocator), std::move(deallocator))); // Stack: co, cl, st, upvalue
             lua_pushcclosure_x(L, &detail::invoke_proxy_constructor<F>, className, 1); // Stack: co, cl, st, function
+            detail::profile_binding(L, className, className, BindingKind::Constructor);
             rawsetfield(L, -2, "__call"); // Stack: co, cl, st
 
             return *this;
@@ -1475,6 +1514,7 @@ class Namespace : public detail::Registrar
 
             lua_newuserdata_aligned<FnType>(L, std::move(function)); // Stack: co, cl, st, function userdata (ud)
             lua_pushcclosure_x(L, &detail::invoke_proxy_functor<FnType>, "__index", 1); // Stack: co, cl, st, function
+            detail::profile_binding(L, className, "__index", BindingKind::IndexFallback);
             lua_rawsetp_x(L, -3, detail::getIndexFallbackKey());
             setObjectMetaMethods(-2, false);
 
@@ -1489,6 +1529,7 @@ class Namespace : public detail::Registrar
 
             lua_pushlightuserdata(L, reinterpret_cast<void*>(idxf)); // Stack: co, cl, st, function ptr
             lua_pushcclosure_x(L, &detail::invoke_proxy_function<FnType>, "__index", 1); // Stack: co, cl, st, function
+            detail::profile_binding(L, className, "__index", BindingKind::IndexFallback);
             lua_rawsetp_x(L, -3, detail::getIndexFallbackKey());
             setObjectMetaMethods(-2, false);
 
@@ -1501,8 +1542,9 @@ class Namespace : public detail::Registrar
 
             assertStackState(); // Stack: const table (co), class table (cl), static table (st)
 
-            new (lua_newuserdata_x<MemFnPtr>(L, sizeof(MemFnPtr))) MemFnPtr(idxf);
+            detail::push_shared_metadata(L, idxf);
             lua_pushcclosure_x(L, &detail::invoke_member_function<MemFnPtr, T>, "__index", 1);
+            detail::profile_binding(L, className, "__index", BindingKind::IndexFallback);
             lua_rawsetp_x(L, -3, detail::getIndexFallbackKey());
             setObjectMetaMethods(-2, false);
 
@@ -1526,6 +1568,7 @@ class Namespace : public detail::Registrar
 
             lua_newuserdata_aligned<FnType>(L, std::move(function)); // Stack: co, cl, st, function userdata (ud)
             lua_pushcclosure_x(L, &detail::invoke_proxy_functor<FnType>, "__newindex", 1); // Stack: co, cl, st, function
+            detail::profile_binding(L, className, "__newindex", BindingKind::NewIndexFallback);
             lua_rawsetp_x(L, -3, detail::getNewIndexFallbackKey());
             setObjectMetaMethods(-2, false);
 
@@ -1540,6 +1583,7 @@ class Namespace : public detail::Registrar
 
             lua_pushlightuserdata(L, reinterpret_cast<void*>(idxf)); // Stack: co, cl, st, function ptr
             lua_pushcclosure_x(L, &detail::invoke_proxy_function<FnType>, "__newindex", 1); // Stack: co, cl, st, function
+            detail::profile_binding(L, className, "__newindex", BindingKind::NewIndexFallback);
             lua_rawsetp_x(L, -3, detail::getNewIndexFallbackKey());
             setObjectMetaMethods(-2, false);
 
@@ -1552,8 +1596,9 @@ class Namespace : public detail::Registrar
 
             assertStackState(); // Stack: const table (co), class table (cl), static table (st)
 
-            new (lua_newuserdata_x<MemFnPtr>(L, sizeof(MemFnPtr))) MemFnPtr(idxf);
+            detail::push_shared_metadata(L, idxf);
             lua_pushcclosure_x(L, &detail::invoke_member_function<MemFnPtr, T>, "__newindex", 1);
+            detail::profile_binding(L, className, "__newindex", BindingKind::NewIndexFallback);
             lua_rawsetp_x(L, -3, detail::getNewIndexFallbackKey());
             setObjectMetaMethods(-2, false);
 
@@ -1590,6 +1635,105 @@ class Namespace : public detail::Registrar
 
             return *this;
         }
+
+        //=========================================================================================
+        /**
+         * @brief Set the estimator of the external memory owned by the objects of this class.
+         *
+         * The estimator is called once for each object stored by value in a userdata, after its construction. The estimated bytes
+         * count as memory allocated by Lua, advancing the garbage collector, and are released when the object is collected. Use it
+         * for objects that are small in Lua but own large heap buffers, like images or meshes, so that the collector runs before
+         * the process runs out of memory.
+         *
+         * Objects pushed by pointer or shared container are not estimated. Passing `nullptr` removes the estimator.
+         *
+         * @param estimator A function returning the estimated bytes owned by an object, outside of its `sizeof`.
+         *
+         * @returns This class registration object.
+         */
+        Class<T>& setMemoryEstimator(std::size_t (*estimator)(const T&))
+        {
+            assertStackState(); // Stack: const table (co), class table (cl), static table (st)
+
+            if (estimator != nullptr)
+                detail::memory_estimator_ever_set<T>().store(true, std::memory_order_relaxed);
+
+            lua_pushlightuserdata(L, reinterpret_cast<void*>(estimator)); // Stack: co, cl, st, estimator
+            lua_rawsetp_x(L, -3, detail::getMemoryEstimatorKey()); // cl [memoryEstimatorKey] = estimator. Stack: co, cl, st
+
+            lua_pushlightuserdata(L, reinterpret_cast<void*>(estimator)); // Stack: co, cl, st, estimator
+            lua_rawsetp_x(L, -4, detail::getMemoryEstimatorKey()); // co [memoryEstimatorKey] = estimator. Stack: co, cl, st
+
+            return *this;
+        }
+
+        //=========================================================================================
+        /**
+         * @brief Add a function releasing the resources of an object when its to-be-closed variable goes out of scope.
+         *
+         * The function is registered as the `__close` metamethod, called by Lua 5.4 and later at the end of the scope of a
+         * `local f <close> = ...` variable, or when an error unwinds it. The object stays alive until it is collected.
+         *
+         * Const objects are closable too: a non const member function without arguments, or a function taking only the object,
+         * is called on them as well. Functions taking further arguments only close const objects if they take a const object.
+         *
+         * Lua looks the `__close` metamethod up in the metatable of the object only, so classes derived from this one must add
+         * their own close method.
+         *
+         * @param function A member function or a function taking the object as first argument.
+         *
+         * @returns This class registration object.
+         */
+        template <class Function>
+        Class<T>& addCloseMethod(Function function)
+        {
+            if constexpr (detail::is_const_function<T, Function>)
+            {
+                return addFunction("__close", std::move(function));
+            }
+            else if constexpr (std::is_member_function_pointer_v<Function> && detail::function_arity_v<Function> == 0)
+            {
+                return addFunction("__close", [function](const T* object) { (const_cast<T*>(object)->*function)(); });
+            }
+            else if constexpr (! std::is_member_function_pointer_v<Function> && detail::function_arity_v<Function> == 1)
+            {
+                return addFunction("__close", [function](const T* object) mutable
+                {
+                    if constexpr (std::is_invocable_v<Function&, T*>)
+                        function(const_cast<T*>(object));
+                    else
+                        function(*const_cast<T*>(object));
+                });
+            }
+            else
+            {
+                return addFunction("__close", std::move(function));
+            }
+        }
+
+        //=========================================================================================
+        /**
+         * @brief Destroy the objects of this class stored by value when their to-be-closed variable goes out of scope.
+         *
+         * The `__close` metamethod calls the `__destruct` hook and the C++ destructor, without waiting for the garbage collector.
+         * The userdata then becomes a dead object, and using it from Lua raises an error. Objects pushed by pointer or shared
+         * container are not owned by Lua and are left untouched.
+         *
+         * As for the other overload, classes derived from this one must add their own close method.
+         *
+         * @returns This class registration object.
+         */
+        Class<T>& addCloseMethod()
+        {
+            assertStackState(); // Stack: const table (co), class table (cl), static table (st)
+
+            lua_pushcfunction_x(L, &detail::close_metamethod<T>, "__close"); // Stack: co, cl, st, function
+            lua_pushvalue(L, -1); // Stack: co, cl, st, function, function
+            rawsetfield(L, -4, "__close"); // cl ["__close"] = function. Stack: co, cl, st, function
+            rawsetfield(L, -4, "__close"); // co ["__close"] = function. Stack: co, cl, st
+
+            return *this;
+        }
     };
 
     class Table : public detail::Registrar
@@ -1621,6 +1765,7 @@ class Namespace : public detail::Registrar
 
             lua_newuserdata_aligned<FnType>(L, std::move(function)); // Stack: ns, function userdata (ud)
             lua_pushcclosure_x(L, &detail::invoke_proxy_functor<FnType>, name, 1); // Stack: ns, function
+            detail::profile_binding(L, "", name);
             rawsetfield(L, -3, name); // Stack: ns
 
             return *this;
@@ -1636,6 +1781,7 @@ class Namespace : public detail::Registrar
 
             lua_newuserdata_aligned<FnType>(L, std::move(function)); // Stack: ns, function userdata (ud)
             lua_pushcclosure_x(L, &detail::invoke_proxy_functor<FnType>, name, 1); // Stack: ns, function
+            detail::profile_binding(L, "", name);
             rawsetfield(L, -2, name); // Stack: ns
 
             return *this;
@@ -1908,6 +2054,7 @@ public:
         }
 
         detail::push_property_getter(L, std::move(getter), name); // Stack: ns, getter
+        detail::profile_binding(L, "", name, BindingKind::Getter);
         detail::add_property_getter(L, name, -2); // Stack: ns, getter
 
         detail::push_property_readonly(L, name); // Stack: ns, function
@@ -1939,9 +2086,11 @@ public:
         }
 
         detail::push_property_getter(L, std::move(getter), name); // Stack: ns, getter
+        detail::profile_binding(L, "", name, BindingKind::Getter);
         detail::add_property_getter(L, name, -2); // Stack: ns
 
         detail::push_property_setter(L, std::move(setter), name); // Stack: ns, setter
+        detail::profile_binding(L, "", name, BindingKind::Setter);
         detail::add_property_setter(L, name, -2); // Stack: ns
 
         return *this;
@@ -1974,26 +2123,28 @@ public:
         else
         {
             // upvalue 1: OverloadSet (C++ struct with arity + type checker per overload)
-            auto* overload_set_unaligned = lua_newuserdata_aligned<detail::OverloadSet>(L);
-            auto* overload_set = align<detail::OverloadSet>(overload_set_unaligned);
-
-            ([&]
+            const auto* overload_set = detail::shared_overload_set([](detail::OverloadSet* set)
             {
-                detail::OverloadEntry entry;
-                if constexpr (detail::is_any_cfunction_pointer_v<Functions>)
-                {
-                    entry.arity = -1;
-                    entry.checker = nullptr;
-                }
-                else
+                ([&]
                 {
-                    using ArgsPack = detail::function_arguments_t<Functions>;
-                    entry.arity = static_cast<int>(detail::function_arity_excluding_v<Functions, lua_State*>);
-                    entry.checker = &detail::overload_type_checker<ArgsPack>;
-                }
-                overload_set->entries.push_back(entry);
+                    detail::OverloadEntry entry;
+                    if constexpr (detail::is_any_cfunction_pointer_v<Functions>)
+                    {
+                        entry.arity = -1;
+                        entry.checker = nullptr;
+                    }
+                    else
+                    {
+                        using ArgsPack = detail::function_arguments_t<Functions>;
+                        entry.arity = static_cast<int>(detail::function_arity_excluding_v<Functions, lua_State*>);
+                        entry.checker = &detail::overload_type_checker<ArgsPack>;
+                    }
+                    set->entries.push_back(entry);
 
-            } (), ...);
+                } (), ...);
+            });
+
+            lua_pushlightuserdata(L, const_cast<detail::OverloadSet*>(overload_set));
 
             // upvalue 2: flat table of function closures indexed 1..N
             lua_createtable(L, static_cast<int>(sizeof...(Functions)), 0);
@@ -2010,6 +2161,7 @@ public:
             lua_pushcclosure_x(L, &detail::try_overload_functions<false>, name, 2);
         }
 
+        detail::profile_binding(L, "", name);
         rawsetfield(L, -2, name);
 
         return *this;
@@ -2037,6 +2189,7 @@ public:
         LUABRIDGE_ASSERT(lua_istable(L, -1)); // Stack: namespace table (ns)
 
         detail::push_coroutine_function(L, std::move(factory), name);
+        detail::profile_binding(L, "", name);
         rawsetfield(L, -2, name);
 
         return *this;
@@ -15,6 +15,7 @@ namespace detail {
 struct OptionExtensibleClass;
 struct OptionAllowOverridingMethods;
 struct OptionVisibleMetatables;
+struct OptionArenaAllocated;
 } // namespace Detail
 
 /**
@@ -23,7 +24,8 @@ struct OptionVisibleMetatables;
 using Options = FlagSet<uint32_t,
     detail::OptionExtensibleClass,
     detail::OptionAllowOverridingMethods,
-    detail::OptionVisibleMetatables>;
+    detail::OptionVisibleMetatables,
+    detail::OptionArenaAllocated>;
 
 /**
  * @brief Set of default options.
@@ -47,4 +49,9 @@ static inline constexpr Options allowOverridingMethods = Options::Value<detail::
  */
 static inline constexpr Options visibleMetatables = Options::Value<detail::OptionVisibleMetatables>();
 
+/**
+ * @brief Construct the objects stored by value in the active `ScopedArena` of the Lua state, if any.
+ */
+static inline constexpr Options arenaAllocated = Options::Value<detail::OptionArenaAllocated>();
+
 } // namespace luabridge
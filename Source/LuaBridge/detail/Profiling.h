@@ -0,0 +1,508 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Config.h"
+#include "ClassInfo.h"
+#include "LuaHelpers.h"
+
+#if LUABRIDGE_ENABLE_PROFILING
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iomanip>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#endif
+
+namespace luabridge {
+
+//=================================================================================================
+/**
+ * @brief Kind of a profiled binding.
+ */
+enum class BindingKind
+{
+    Function,
+    Getter,
+    Setter,
+    Constructor,
+    Destructor,
+    IndexFallback,
+    NewIndexFallback
+};
+
+#if LUABRIDGE_ENABLE_PROFILING
+//=================================================================================================
+/**
+ * @brief Snapshot of the call counters of a profiled binding.
+ *
+ * The latency histogram has power of two buckets: `histogram[i]` counts the calls that took less than `2^i` nanoseconds and at
+ * least `2^(i-1)`, the last bucket counts all the slower calls.
+ */
+struct BindingProfile
+{
+    static constexpr std::size_t histogramBuckets = 40;
+
+    std::string className;                                   ///< Name of the class, empty for namespace functions and properties.
+    std::string name;                                        ///< Name the binding was registered with.
+    BindingKind kind = BindingKind::Function;                ///< Kind of the binding.
+    std::uint64_t calls = 0;                                 ///< Calls started, including the ones that raised an error.
+    std::uint64_t timedCalls = 0;                            ///< Calls that returned normally and were timed.
+    std::chrono::nanoseconds totalTime{};                    ///< Time spent in the timed calls.
+    std::array<std::uint64_t, histogramBuckets> histogram{}; ///< Timed calls per latency bucket.
+
+    /**
+     * @brief Mean duration of the timed calls.
+     */
+    [[nodiscard]] std::chrono::nanoseconds averageTime() const noexcept
+    {
+        return timedCalls > 0 ? totalTime / static_cast<std::chrono::nanoseconds::rep>(timedCalls) : std::chrono::nanoseconds{};
+    }
+
+    /**
+     * @brief Upper bound of the latency under which a fraction of the timed calls completed.
+     *
+     * @param fraction A value between 0 and 1, like 0.99 for the 99th percentile.
+     *
+     * @returns The upper bound of the histogram bucket holding the requested fraction, precise to a factor of two.
+     */
+    [[nodiscard]] std::chrono::nanoseconds percentile(double fraction) const noexcept
+    {
+        if (timedCalls == 0)
+            return {};
+
+        const auto threshold = static_cast<std::uint64_t>(static_cast<double>(timedCalls) * std::clamp(fraction, 0.0, 1.0));
+
+        std::uint64_t accumulated = 0;
+        for (std::size_t bucket = 0; bucket < histogramBuckets; ++bucket)
+        {
+            accumulated += histogram[bucket];
+            if (accumulated >= threshold && accumulated > 0)
+                return std::chrono::nanoseconds(std::int64_t(1) << bucket);
+        }
+
+        return std::chrono::nanoseconds(std::int64_t(1) << (histogramBuckets - 1));
+    }
+};
+
+/**
+ * @brief Ordering of the bindings returned by `getTopBindingProfiles`.
+ */
+enum class BindingProfileOrder
+{
+    Calls,
+    TotalTime,
+    AverageTime
+};
+#endif
+
+namespace detail {
+
+#if LUABRIDGE_ENABLE_PROFILING
+//=================================================================================================
+/**
+ * @brief Live counters of a profiled binding, updated with relaxed atomics by the wrapper closures of all the Lua states.
+ */
+struct BindingCounters
+{
+    BindingCounters(std::string className, std::string name, BindingKind kind)
+        : className(std::move(className))
+        , name(std::move(name))
+        , kind(kind)
+    {
+    }
+
+    void record(std::chrono::nanoseconds elapsed) noexcept
+    {
+        const auto nanoseconds = static_cast<std::uint64_t>(std::max(elapsed.count(), std::chrono::nanoseconds::rep(0)));
+
+        std::size_t bucket = 0;
+        while (bucket + 1 < BindingProfile::histogramBuckets && (nanoseconds >> bucket) != 0)
+            ++bucket;
+
+        timedCalls.fetch_add(1, std::memory_order_relaxed);
+        totalNanoseconds.fetch_add(nanoseconds, std::memory_order_relaxed);
+        histogram[bucket].fetch_add(1, std::memory_order_relaxed);
+    }
+
+    BindingProfile snapshot() const
+    {
+        BindingProfile profile;
+        profile.className = className;
+        profile.name = name;
+        profile.kind = kind;
+        profile.calls = calls.load(std::memory_order_relaxed);
+        profile.timedCalls = timedCalls.load(std::memory_order_relaxed);
+        profile.totalTime = std::chrono::nanoseconds(totalNanoseconds.load(std::memory_order_relaxed));
+
+        for (std::size_t bucket = 0; bucket < BindingProfile::histogramBuckets; ++bucket)
+            profile.histogram[bucket] = histogram[bucket].load(std::memory_order_relaxed);
+
+        return profile;
+    }
+
+    void reset() noexcept
+    {
+        calls.store(0, std::memory_order_relaxed);
+        timedCalls.store(0, std::memory_order_relaxed);
+        totalNanoseconds.store(0, std::memory_order_relaxed);
+
+        for (auto& count : histogram)
+            count.store(0, std::memory_order_relaxed);
+    }
+
+    const std::string className;
+    const std::string name;
+    const BindingKind kind;
+
+    std::atomic<std::uint64_t> calls = 0;
+    std::atomic<std::uint64_t> timedCalls = 0;
+    std::atomic<std::uint64_t> totalNanoseconds = 0;
+    std::array<std::atomic<std::uint64_t>, BindingProfile::histogramBuckets> histogram{};
+};
+
+//=================================================================================================
+/**
+ * @brief A bound lua_CFunction and the counters of the binding it implements.
+ */
+struct ProfiledFunction
+{
+    lua_CFunction function = nullptr;
+    BindingCounters* counters = nullptr;
+};
+
+//=================================================================================================
+/**
+ * @brief Process wide registry of the counters of the profiled bindings.
+ *
+ * Registering the same binding in several Lua states, or several times, shares its counters. Like `SharedMetadata`, the
+ * counters live until the end of the process so closures of states closed during static destruction can still reference them.
+ */
+class BindingCountersRegistry
+{
+public:
+    static const ProfiledFunction* find_or_add(const char* className, const char* name, BindingKind kind, lua_CFunction function)
+    {
+        std::string key(1, static_cast<char>(kind));
+        key.append(className).push_back('\0');
+        key.append(name);
+
+        Storage& storage = instance();
+        const std::lock_guard lock(storage.mutex);
+
+        auto& entry = storage.index[std::move(key)];
+        if (entry.counters == nullptr)
+            entry.counters = &storage.counters.emplace_back(className, name, kind);
+
+        // A binding is usually implemented by a single lua_CFunction, unless it is registered again with another callable
+        for (const ProfiledFunction* existing : entry.functions)
+        {
+            if (existing->function == function)
+                return existing;
+        }
+
+        return entry.functions.emplace_back(&storage.functions.emplace_back(ProfiledFunction{ function, entry.counters }));
+    }
+
+    template <class F>
+    static void for_each(F&& function)
+    {
+        Storage& storage = instance();
+        const std::lock_guard lock(storage.mutex);
+
+        for (BindingCounters& counters : storage.counters)
+            function(counters);
+    }
+
+private:
+    struct Entry
+    {
+        BindingCounters* counters = nullptr;
+        std::vector<const ProfiledFunction*> functions;
+    };
+
+    struct Storage
+    {
+        std::mutex mutex;
+        std::deque<BindingCounters> counters;
+        std::deque<ProfiledFunction> functions;
+        std::unordered_map<std::string, Entry> index;
+    };
+
+    static Storage& instance()
+    {
+        static Storage* storage = new Storage;
+        return *storage;
+    }
+};
+
+//=================================================================================================
+/**
+ * @brief Get the qualified name of a profiled binding, like `Class.name (get)`.
+ */
+inline std::string binding_qualified_name(const std::string& className, const std::string& name, BindingKind kind)
+{
+    std::string qualifiedName = className.empty() ? name : className + "." + name;
+
+    switch (kind)
+    {
+    case BindingKind::Getter: qualifiedName += " (get)"; break;
+    case BindingKind::Setter: qualifiedName += " (set)"; break;
+    case BindingKind::Constructor: qualifiedName += " (constructor)"; break;
+    case BindingKind::Destructor: qualifiedName += " (destructor)"; break;
+    case BindingKind::IndexFallback: qualifiedName += " (index)"; break;
+    case BindingKind::NewIndexFallback: qualifiedName += " (newindex)"; break;
+    case BindingKind::Function:
+    default: break;
+    }
+
+    return qualifiedName;
+}
+
+//=================================================================================================
+/**
+ * @brief Receiver of the time spent in the profiled bindings of a Lua state, implemented by `luabridge::Profiler`.
+ *
+ * A sampler is stored as a light userdata in the registry of the state it samples, and `active_binding_samplers` counts the
+ * samplers of the process so that the wrappers skip the registry lookup while none is running.
+ */
+class BindingSampler
+{
+public:
+    virtual void sample_binding(lua_State* L,
+                                std::chrono::steady_clock::time_point start,
+                                std::chrono::steady_clock::time_point end) = 0;
+
+protected:
+    ~BindingSampler() = default;
+};
+
+inline std::atomic<std::size_t>& active_binding_samplers() noexcept
+{
+    static std::atomic<std::size_t> count = 0;
+    return count;
+}
+
+//=================================================================================================
+/**
+ * @brief lua_CFunction counting and timing a bound lua_CFunction.
+ *
+ * The closure has the upvalues of the bound closure, followed by a light userdata pointing to the `ProfiledFunction`. The bound
+ * function is invoked directly in the same call frame, so it sees its own upvalues, and error positions, function names in
+ * messages and yields across it behave as without profiling. The call is counted before invoking the function: calls raising an
+ * error or yielding are counted, and only the calls returning normally are timed.
+ */
+inline int invoke_profiled_binding(lua_State* L)
+{
+    int last = 1;
+    while (lua_type(L, lua_upvalueindex(last + 1)) != LUA_TNONE)
+        ++last;
+
+    const auto* profiled = static_cast<const ProfiledFunction*>(lua_touserdata(L, lua_upvalueindex(last)));
+    profiled->counters->calls.fetch_add(1, std::memory_order_relaxed);
+
+    const auto start = std::chrono::steady_clock::now();
+    const int results = profiled->function(L);
+    const auto end = std::chrono::steady_clock::now();
+    profiled->counters->record(std::chrono::duration_cast<std::chrono::nanoseconds>(end - start));
+
+    if (active_binding_samplers().load(std::memory_order_relaxed) != 0)
+    {
+        lua_rawgetp_x(L, LUA_REGISTRYINDEX, getProfilerKey());
+        auto* sampler = static_cast<BindingSampler*>(lua_touserdata(L, -1));
+        lua_pop(L, 1);
+
+        if (sampler != nullptr)
+            sampler->sample_binding(L, start, end);
+    }
+
+    return results;
+}
+
+//=================================================================================================
+/**
+ * @brief Get the profiled binding implemented by a function on the stack.
+ *
+ * @returns The profiled binding, or `nullptr` if the function is not a profiling wrapper.
+ */
+inline const ProfiledFunction* get_profiled_binding(lua_State* L, int index)
+{
+    if (lua_tocfunction(L, index) != &invoke_profiled_binding)
+        return nullptr;
+
+    index = lua_absindex(L, index);
+
+    int last = 1;
+    while (lua_getupvalue(L, index, last + 1) != nullptr)
+    {
+        lua_pop(L, 1);
+        ++last;
+    }
+
+    lua_getupvalue(L, index, last);
+    const auto* profiled = static_cast<const ProfiledFunction*>(lua_touserdata(L, -1));
+    lua_pop(L, 1);
+
+    return profiled;
+}
+
+//=================================================================================================
+/**
+ * @brief Replace the C function on top of the stack with a closure counting and timing its calls.
+ *
+ * @param L A Lua state.
+ * @param className The name of the class owning the binding, or an empty string for namespace bindings.
+ * @param name The name the binding is registered with.
+ * @param kind The kind of binding.
+ */
+inline void profile_binding(lua_State* L, const char* className, const char* name, BindingKind kind = BindingKind::Function)
+{
+    LUABRIDGE_ASSERT(lua_iscfunction(L, -1));
+
+    const int function = lua_gettop(L);
+
+    int upvalues = 0;
+    while (lua_getupvalue(L, function, upvalues + 1) != nullptr)
+        ++upvalues;
+
+    const auto* profiled = BindingCountersRegistry::find_or_add(className, name, kind, lua_tocfunction(L, function));
+    lua_pushlightuserdata(L, const_cast<ProfiledFunction*>(profiled));
+
+    lua_pushcclosure_x(L, &invoke_profiled_binding, name, upvalues + 1);
+    lua_replace(L, function);
+}
+
+#else
+inline void profile_binding(lua_State*, const char*, const char*, BindingKind = BindingKind::Function) noexcept
+{
+}
+#endif
+
+} // namespace detail
+
+#if LUABRIDGE_ENABLE_PROFILING
+//=================================================================================================
+/**
+ * @brief Get a snapshot of the counters of all the profiled bindings, in registration order.
+ *
+ * Only available when `LUABRIDGE_ENABLE_PROFILING` is enabled. The counters of all the Lua states are merged, and are read
+ * while the wrapped functions may be running on other threads.
+ */
+inline std::vector<BindingProfile> getBindingProfiles()
+{
+    std::vector<BindingProfile> profiles;
+
+    detail::BindingCountersRegistry::for_each([&profiles](const detail::BindingCounters& counters)
+    {
+        profiles.push_back(counters.snapshot());
+    });
+
+    return profiles;
+}
+
+/**
+ * @brief Get a snapshot of the counters of the most called or most expensive bindings.
+ *
+ * Bindings never called are skipped.
+ *
+ * @param count The maximum number of bindings to return.
+ * @param order The criteria to sort the bindings with, in descending order.
+ */
+inline std::vector<BindingProfile> getTopBindingProfiles(std::size_t count, BindingProfileOrder order = BindingProfileOrder::TotalTime)
+{
+    auto profiles = getBindingProfiles();
+
+    profiles.erase(std::remove_if(profiles.begin(), profiles.end(), [](const BindingProfile& profile) { return profile.calls == 0; }),
+                   profiles.end());
+
+    const auto key = [order](const BindingProfile& profile) -> std::uint64_t
+    {
+        switch (order)
+        {
+        case BindingProfileOrder::Calls:
+            return profile.calls;
+
+        case BindingProfileOrder::AverageTime:
+            return static_cast<std::uint64_t>(profile.averageTime().count());
+
+        case BindingProfileOrder::TotalTime:
+        default:
+            return static_cast<std::uint64_t>(profile.totalTime.count());
+        }
+    };
+
+    std::stable_sort(profiles.begin(), profiles.end(), [&key](const BindingProfile& lhs, const BindingProfile& rhs)
+    {
+        return key(lhs) > key(rhs);
+    });
+
+    if (profiles.size() > count)
+        profiles.resize(count);
+
+    return profiles;
+}
+
+/**
+ * @brief Reset the counters of all the profiled bindings.
+ */
+inline void resetBindingProfiles()
+{
+    detail::BindingCountersRegistry::for_each([](detail::BindingCounters& counters) { counters.reset(); });
+}
+
+/**
+ * @brief Write a table of the most called or most expensive bindings.
+ *
+ * Each line holds the qualified binding name, the number of calls, the total and average time, and the 50th and 99th percentile
+ * latencies in microseconds.
+ *
+ * @param stream The stream to write to.
+ * @param count The maximum number of bindings to write.
+ * @param order The criteria to sort the bindings with, in descending order.
+ */
+inline void dumpTopBindingProfiles(std::ostream& stream, std::size_t count, BindingProfileOrder order = BindingProfileOrder::TotalTime)
+{
+    const auto microseconds = [](std::chrono::nanoseconds duration)
+    {
+        return std::chrono::duration<double, std::micro>(duration).count();
+    };
+
+    const auto flags = stream.flags();
+    const auto precision = stream.precision();
+
+    stream << std::left << std::setw(48) << "binding" << std::right
+           << std::setw(12) << "calls"
+           << std::setw(14) << "total us"
+           << std::setw(12) << "avg us"
+           << std::setw(12) << "p50 us"
+           << std::setw(12) << "p99 us" << '\n';
+
+    stream << std::fixed << std::setprecision(3);
+
+    for (const auto& profile : getTopBindingProfiles(count, order))
+    {
+        stream << std::left << std::setw(48) << detail::binding_qualified_name(profile.className, profile.name, profile.kind) << std::right
+               << std::setw(12) << profile.calls
+               << std::setw(14) << microseconds(profile.totalTime)
+               << std::setw(12) << microseconds(profile.averageTime())
+               << std::setw(12) << microseconds(profile.percentile(0.5))
+               << std::setw(12) << microseconds(profile.percentile(0.99)) << '\n';
+    }
+
+    stream.flags(flags);
+    stream.precision(precision);
+}
+#endif
+
+} // namespace luabridge
@@ -0,0 +1,376 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Config.h"
+#include "ClassInfo.h"
+#include "ClassStats.h"
+#include "ExternalMemory.h"
+#include "LuaHelpers.h"
+#include "Options.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <initializer_list>
+#include <new>
+
+namespace luabridge {
+namespace detail {
+
+//=================================================================================================
+/**
+ * @brief Number of scoped arenas alive, in any Lua state.
+ *
+ * While it is zero, the userdata values skip the arena lookup in the registry.
+ */
+inline std::atomic<std::size_t>& active_scoped_arenas() noexcept
+{
+    static std::atomic<std::size_t> count = 0;
+    return count;
+}
+
+//=================================================================================================
+/**
+ * @brief lua_CFunction raising the error of a destroyed object.
+ */
+inline int dead_object_metamethod(lua_State* L)
+{
+    raise_lua_error(L, "attempt to use a destroyed object");
+}
+
+/**
+ * @brief lua_CFunction converting a destroyed object to string.
+ */
+inline int dead_object_tostring_metamethod(lua_State* L)
+{
+    lua_pushfstring(L, "destroyed object: %p", lua_touserdata(L, 1));
+    return 1;
+}
+
+/**
+ * @brief lua_CFunction closing a destroyed object, which is a no-op.
+ */
+inline int dead_object_close_metamethod(lua_State*)
+{
+    return 0;
+}
+
+/**
+ * @brief Push the metatable of the destroyed objects of a Lua state, creating it if needed.
+ *
+ * A userdata whose C++ object was destroyed before its collection gets this metatable: it is not an instance of any registered
+ * class anymore, and using it from Lua raises an error.
+ */
+inline void push_dead_object_metatable(lua_State* L)
+{
+    lua_rawgetp_x(L, LUA_REGISTRYINDEX, getDeadObjectKey()); // Stack: dead metatable (dm) | nil
+    if (lua_istable(L, -1))
+        return;
+
+    lua_pop(L, 1);
+    lua_newtable(L); // Stack: dm
+
+    for (const char* name : { "__index", "__newindex", "__call", "__len", "__concat", "__unm", "__add", "__sub", "__mul", "__div", "__mod", "__pow", "__lt", "__le" })
+    {
+        lua_pushcfunction_x(L, &dead_object_metamethod, name);
+        rawsetfield(L, -2, name);
+    }
+
+    lua_pushcfunction_x(L, &dead_object_tostring_metamethod, "__tostring");
+    rawsetfield(L, -2, "__tostring");
+
+    lua_pushcfunction_x(L, &dead_object_close_metamethod, "__close");
+    rawsetfield(L, -2, "__close");
+
+    lua_pushboolean(L, 0);
+    rawsetfield(L, -2, "__metatable");
+
+    lua_pushvalue(L, -1); // Stack: dm, dm
+    lua_rawsetp_x(L, LUA_REGISTRYINDEX, getDeadObjectKey()); // Stack: dm
+}
+
+/**
+ * @brief Mark a userdata whose C++ object is destroyed as dead.
+ *
+ * The userdata stops being counted as a live object and gets the metatable of the destroyed objects, which has no `__gc`.
+ *
+ * @param L A Lua state.
+ * @param index The index of the userdata.
+ */
+inline void kill_userdata(lua_State* L, int index)
+{
+    index = lua_absindex(L, index);
+
+    count_class_object_collected(L, index);
+    release_external_memory_entry(L, index);
+
+    push_dead_object_metatable(L);
+    lua_setmetatable(L, index);
+}
+
+} // namespace detail
+
+//=================================================================================================
+/**
+ * @brief Arena for the short lived objects of a Lua state, like the temporaries created by a script callback.
+ *
+ * While the arena is the innermost one alive on a Lua state, the objects stored by value of the classes registered with the
+ * `arenaAllocated` option are constructed in the arena memory, with a bump allocation, and their userdata only holds a pointer to
+ * them. When the arena is destroyed, all its objects are destroyed at once, the userdata still referenced from Lua become dead
+ * objects raising errors when used, and the arena memory is released in a few large blocks.
+ *
+ * Arenas can be nested, and must be destroyed in reverse order of construction. The arena must be destroyed before the Lua state.
+ *
+ * @note The arena registers itself in the registry of the Lua state. An arena whose destructor is skipped, by a Lua error raised
+ * with `longjmp` across its scope, stays registered with a dangling pointer: keep arenas out of the scopes a Lua error can unwind
+ * when exceptions are disabled.
+ *
+ * Example:
+ * @code
+ * luabridge::getGlobalNamespace(L)
+ *     .beginClass<QueryResult>("QueryResult", luabridge::arenaAllocated)
+ *         ...
+ *     .endClass();
+ *
+ * {
+ *     luabridge::ScopedArena arena(L);
+ *     luabridge::call(onFrame); // QueryResult objects returned to the script live in the arena
+ * } // Every QueryResult created by onFrame is destroyed here
+ * @endcode
+ */
+class ScopedArena
+{
+public:
+    static constexpr std::size_t defaultBlockSize = 64 * 1024;
+
+    /**
+     * @brief Construct an arena and make it the active arena of a Lua state.
+     *
+     * @param L A Lua state.
+     * @param blockSize Size of the memory blocks of the arena. Larger objects get a block of their own.
+     */
+    explicit ScopedArena(lua_State* L, std::size_t blockSize = defaultBlockSize)
+        : m_L(L)
+        , m_blockSize(std::max(blockSize, sizeof(Block) + sizeof(Entry)))
+    {
+        m_previous = current(L);
+
+        lua_newtable(L); // Stack: objects table (ot)
+        lua_newtable(L); // Stack: ot, mt
+        lua_pushstring(L, "v"); // Stack: ot, mt, v
+        rawsetfield(L, -2, "__mode"); // Stack: ot, mt
+        lua_setmetatable(L, -2); // Stack: ot
+        lua_rawsetp_x(L, LUA_REGISTRYINDEX, this); // Stack: -
+
+        lua_pushlightuserdata(L, this);
+        lua_rawsetp_x(L, LUA_REGISTRYINDEX, detail::getScopedArenaKey());
+
+        detail::active_scoped_arenas().fetch_add(1, std::memory_order_relaxed);
+    }
+
+    ScopedArena(const ScopedArena&) = delete;
+    ScopedArena& operator=(const ScopedArena&) = delete;
+
+    /**
+     * @brief Destroy the objects of the arena, release its memory and restore the previous active arena.
+     */
+    ~ScopedArena()
+    {
+        LUABRIDGE_ASSERT(current(m_L) == this);
+
+        lua_State* L = m_L;
+
+        lua_rawgetp_x(L, LUA_REGISTRYINDEX, this); // Stack: objects table (ot)
+        for (int index = 1; index <= m_objectCount; ++index)
+        {
+            lua_rawgeti(L, -1, index); // Stack: ot, userdata | nil
+            if (lua_isuserdata(L, -1))
+                detail::kill_userdata(L, -1);
+
+            lua_pop(L, 1); // Stack: ot
+        }
+        lua_pop(L, 1);
+
+        lua_pushnil(L);
+        lua_rawsetp_x(L, LUA_REGISTRYINDEX, this);
+
+        for (Entry* entry = m_entries; entry != nullptr; entry = entry->previous)
+            entry->destroy(entry->object);
+
+        while (m_blocks != nullptr)
+        {
+            Block* previous = m_blocks->previous;
+            std::free(m_blocks);
+            m_blocks = previous;
+        }
+
+        if (m_previous != nullptr)
+            lua_pushlightuserdata(L, m_previous);
+        else
+            lua_pushnil(L);
+
+        lua_rawsetp_x(L, LUA_REGISTRYINDEX, detail::getScopedArenaKey());
+
+        detail::active_scoped_arenas().fetch_sub(1, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Number of objects constructed in the arena.
+     */
+    [[nodiscard]] std::size_t objectCount() const noexcept
+    {
+        return static_cast<std::size_t>(m_objectCount);
+    }
+
+    /**
+     * @brief Bytes of the memory blocks of the arena.
+     */
+    [[nodiscard]] std::size_t reservedBytes() const noexcept
+    {
+        return m_reservedBytes;
+    }
+
+    /**
+     * @brief Get the active arena of a Lua state.
+     *
+     * @returns The innermost arena alive, or `nullptr` if none.
+     */
+    [[nodiscard]] static ScopedArena* current(lua_State* L)
+    {
+        lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getScopedArenaKey());
+        auto* arena = static_cast<ScopedArena*>(lua_touserdata(L, -1));
+        lua_pop(L, 1);
+
+        return arena;
+    }
+
+    /**
+     * @brief Allocate the storage of an object destroyed with the arena.
+     *
+     * @param size The size of the object.
+     * @param alignment The alignment of the object.
+     * @param destroy The function destroying the object, called when the arena is destroyed.
+     *
+     * @returns The storage of the object, or `nullptr` if the memory is exhausted.
+     */
+    [[nodiscard]] void* allocate(std::size_t size, std::size_t alignment, void (*destroy)(void*)) noexcept
+    {
+        LUABRIDGE_ASSERT(destroy != nullptr);
+
+        void* storage = bump(sizeof(Entry), alignof(Entry));
+        void* object = storage != nullptr ? bump(size, alignment) : nullptr;
+        if (object == nullptr)
+            return nullptr;
+
+        m_entries = new (storage) Entry{ destroy, object, m_entries };
+        return object;
+    }
+
+    /**
+     * @brief Track a userdata referring to an object of the arena, to mark it dead when the arena is destroyed.
+     *
+     * @param L A Lua state.
+     * @param index The index of the userdata.
+     */
+    void track(lua_State* L, int index)
+    {
+        index = lua_absindex(L, index);
+
+        lua_rawgetp_x(L, LUA_REGISTRYINDEX, this); // Stack: objects table (ot)
+        lua_pushvalue(L, index); // Stack: ot, userdata
+        lua_rawseti(L, -2, ++m_objectCount); // Stack: ot
+        lua_pop(L, 1);
+    }
+
+private:
+    struct alignas(std::max_align_t) Block
+    {
+        Block* previous;
+    };
+
+    struct Entry
+    {
+        void (*destroy)(void*);
+        void* object;
+        Entry* previous;
+    };
+
+    void* bump(std::size_t size, std::size_t alignment) noexcept
+    {
+        auto cursor = reinterpret_cast<std::uintptr_t>(m_cursor);
+        auto aligned = (cursor + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+
+        if (m_cursor == nullptr || aligned + size > reinterpret_cast<std::uintptr_t>(m_end))
+        {
+            const std::size_t blockSize = std::max(m_blockSize, sizeof(Block) + size + alignment);
+
+            auto* block = static_cast<Block*>(std::malloc(blockSize));
+            if (block == nullptr)
+                return nullptr;
+
+            block->previous = m_blocks;
+            m_blocks = block;
+            m_reservedBytes += blockSize;
+
+            m_cursor = reinterpret_cast<std::byte*>(block) + sizeof(Block);
+            m_end = reinterpret_cast<std::byte*>(block) + blockSize;
+
+            cursor = reinterpret_cast<std::uintptr_t>(m_cursor);
+            aligned = (cursor + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+        }
+
+        m_cursor = reinterpret_cast<std::byte*>(aligned + size);
+        return reinterpret_cast<void*>(aligned);
+    }
+
+    lua_State* m_L;
+    std::size_t m_blockSize;
+    ScopedArena* m_previous = nullptr;
+
+    Block* m_blocks = nullptr;
+    std::byte* m_cursor = nullptr;
+    std::byte* m_end = nullptr;
+    std::size_t m_reservedBytes = 0;
+
+    Entry* m_entries = nullptr;
+    int m_objectCount = 0;
+};
+
+namespace detail {
+
+/**
+ * @brief Get the arena where to construct the objects of a class stored by value.
+ *
+ * @returns The active arena of the Lua state if the class was registered with the `arenaAllocated` option, or `nullptr`.
+ */
+template <class T>
+ScopedArena* scoped_arena_for(lua_State* L)
+{
+    if (active_scoped_arenas().load(std::memory_order_relaxed) == 0)
+        return nullptr;
+
+    ScopedArena* arena = ScopedArena::current(L);
+    if (arena == nullptr)
+        return nullptr;
+
+    lua_rawgetp_x(L, LUA_REGISTRYINDEX, getClassRegistryKey<T>()); // Stack: class table (cl) | nil
+    if (! lua_istable(L, -1))
+    {
+        lua_pop(L, 1);
+        return nullptr;
+    }
+
+    lua_rawgetp_x(L, -1, getClassOptionsKey()); // Stack: cl, options | nil
+    const auto options = Options::fromUnderlying(static_cast<std::uint32_t>(lua_tointeger(L, -1)));
+    lua_pop(L, 2);
+
+    return options.test(arenaAllocated) ? arena : nullptr;
+}
+
+} // namespace detail
+} // namespace luabridge
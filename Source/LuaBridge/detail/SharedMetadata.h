@@ -0,0 +1,95 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Config.h"
+#include "LuaHelpers.h"
+
+#include <array>
+#include <cstring>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <shared_mutex>
+#include <type_traits>
+
+namespace luabridge {
+namespace detail {
+
+//=================================================================================================
+/**
+ * @brief Process wide storage of the immutable C++ payload of bound members, like member function and data member pointers.
+ *
+ * Registering the same member in several Lua states hands out the same copy, which closures reference through a light userdata
+ * upvalue instead of allocating a full userdata in each state. Copies live until the end of the process and are never modified:
+ * their number is bounded by the distinct members bound by the program, not by the number of states or registrations.
+ *
+ * Copies are indexed by the bytes of the value, and looking up a value already added only takes a shared lock. Values equal
+ * but differing in their padding bytes get distinct copies.
+ *
+ * @tparam T A trivially copyable type.
+ */
+template <class T>
+class SharedMetadata
+{
+    static_assert(std::is_trivially_copyable_v<T>);
+
+public:
+    /**
+     * @brief Get the shared copy of a value, adding it on first use. Thread-safe.
+     */
+    static const T* intern(const T& value)
+    {
+        Storage& storage = instance();
+
+        Key key;
+        std::memcpy(key.data(), &value, sizeof(T));
+
+        {
+            const std::shared_lock lock(storage.mutex);
+
+            if (auto it = storage.index.find(key); it != storage.index.end())
+                return it->second;
+        }
+
+        const std::unique_lock lock(storage.mutex);
+
+        auto [it, inserted] = storage.index.try_emplace(key, nullptr);
+        if (inserted)
+            it->second = &storage.values.emplace_back(value);
+
+        return it->second;
+    }
+
+private:
+    using Key = std::array<unsigned char, sizeof(T)>;
+
+    struct Storage
+    {
+        std::shared_mutex mutex;
+        std::deque<T> values;
+        std::map<Key, const T*> index;
+    };
+
+    static Storage& instance()
+    {
+        // Never destroyed, so closures of states closed during static destruction can still reference it
+        static Storage* storage = new Storage;
+        return *storage;
+    }
+};
+
+//=================================================================================================
+/**
+ * @brief Push the shared copy of a value as a light userdata.
+ */
+template <class T>
+void push_shared_metadata(lua_State* L, const T& value)
+{
+    lua_pushlightuserdata(L, const_cast<T*>(SharedMetadata<T>::intern(value)));
+}
+
+} // namespace detail
+} // namespace luabridge
@@ -30,6 +30,10 @@
 #include <filesystem>
 #endif
 
+#if LUABRIDGE_HAS_CXX17_MEMORY_RESOURCE
+#include <memory_resource>
+#endif
+
 namespace luabridge {
 
 //=================================================================================================
@@ -978,6 +982,48 @@ struct Stack<std::string_view>
     }
 };
 
+namespace detail {
+
+//=================================================================================================
+/**
+ * @brief Get a copy of the string at the given stack index, constructed as `S(data, size, args...)`.
+ *
+ * Numbers are converted to strings, unless `LUABRIDGE_STRICT_STACK_CONVERSIONS` is enabled. The value at the index is left
+ * untouched: a number is converted on a temporary copy, which is only popped after the string has been copied.
+ */
+template <class S, class... Args>
+[[nodiscard]] TypeResult<S> get_string(lua_State* L, int index, const Args&... args)
+{
+    std::size_t length = 0;
+
+    if (lua_type(L, index) == LUA_TSTRING)
+    {
+        const char* str = lua_tolstring(L, index, &length);
+        return S(str, length, args...);
+    }
+
+#if !LUABRIDGE_STRICT_STACK_CONVERSIONS
+#if LUABRIDGE_SAFE_STACK_CHECKS
+    if (! lua_checkstack(L, 1))
+        return makeErrorCode(ErrorCode::LuaStackOverflow);
+#endif
+
+    // Lua reference manual:
+    // If the value is a number, then lua_tolstring also changes the actual value in the stack
+    // to a string. (This change confuses lua_next when lua_tolstring is applied to keys during
+    // a table traversal)
+    const StackRestore stackRestore(L);
+
+    lua_pushvalue(L, index);
+    if (const char* str = lua_tolstring(L, -1, &length); str != nullptr)
+        return S(str, length, args...);
+#endif
+
+    return makeErrorCode(ErrorCode::InvalidTypeCast);
+}
+
+} // namespace detail
+
 //=================================================================================================
 /**
  * @brief Stack specialization for `std::string`.
@@ -998,35 +1044,44 @@ struct Stack<std::string>
 
     [[nodiscard]] static TypeResult<std::string> get(lua_State* L, int index)
     {
-        std::size_t length = 0;
-        const char* str = nullptr;
+        return detail::get_string<std::string>(L, index);
+    }
 
-        if (lua_type(L, index) == LUA_TSTRING)
-        {
-            str = lua_tolstring(L, index, &length);
-        }
-#if !LUABRIDGE_STRICT_STACK_CONVERSIONS
-        else
-        {
+    [[nodiscard]] static bool isInstance(lua_State* L, int index)
+    {
+        return lua_type(L, index) == LUA_TSTRING;
+    }
+};
+
+#if LUABRIDGE_HAS_CXX17_MEMORY_RESOURCE
+//=================================================================================================
+/**
+ * @brief Stack specialization for `std::pmr::string`.
+ *
+ * When decoded as an argument of a bound function, the string is allocated from the per-call arguments arena.
+ */
+template <>
+struct Stack<std::pmr::string>
+{
+    [[nodiscard]] static Result push(lua_State* L, const std::pmr::string& str)
+    {
 #if LUABRIDGE_SAFE_STACK_CHECKS
-            if (! lua_checkstack(L, 1))
-                return makeErrorCode(ErrorCode::LuaStackOverflow);
+        if (! lua_checkstack(L, 1))
+            return makeErrorCode(ErrorCode::LuaStackOverflow);
 #endif
 
-            // Lua reference manual:
-            // If the value is a number, then lua_tolstring also changes the actual value in the stack
-            // to a string. (This change confuses lua_next when lua_tolstring is applied to keys during
-            // a table traversal)
-            lua_pushvalue(L, index);
-            str = lua_tolstring(L, -1, &length);
-            lua_pop(L, 1);
-        }
-#endif
+        lua_pushlstring(L, str.data(), str.size());
+        return {};
+    }
 
-        if (str == nullptr)
-            return makeErrorCode(ErrorCode::InvalidTypeCast);
+    [[nodiscard]] static TypeResult<std::pmr::string> get(lua_State* L, int index)
+    {
+        return get(L, index, std::pmr::get_default_resource());
+    }
 
-        return std::string{ str, length };
+    [[nodiscard]] static TypeResult<std::pmr::string> get(lua_State* L, int index, std::pmr::memory_resource* resource)
+    {
+        return detail::get_string<std::pmr::string>(L, index, resource);
     }
 
     [[nodiscard]] static bool isInstance(lua_State* L, int index)
@@ -1034,6 +1089,7 @@ struct Stack<std::string>
         return lua_type(L, index) == LUA_TSTRING;
     }
 };
+#endif
 
 //=================================================================================================
 /**
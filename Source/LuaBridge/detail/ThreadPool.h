@@ -0,0 +1,165 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Config.h"
+#include "LuaHelpers.h"
+#include "LuaRef.h"
+
+#include <cstddef>
+
+namespace luabridge {
+
+//=================================================================================================
+/**
+ * @brief Pool of recycled Lua threads, for short lived coroutines.
+ *
+ * `acquire` is a replacement of `lua_newthread` handing out a thread released earlier when available, and `release` resets
+ * a thread which is not running anymore, keeping it for a later `acquire` instead of letting the garbage collector free it.
+ * Pooled threads are anchored in a table referenced from the registry.
+ *
+ * On Lua 5.4+ and Luau any finished, failed or suspended thread is reset, closing its pending to-be-closed variables. Older
+ * versions can only reuse threads that finished without errors.
+ *
+ * A `CppCoroutine` destroys its frame as soon as it completes. The frame of a `CppCoroutine` still suspended in a released
+ * thread is destroyed when its userdata is collected, as for an abandoned thread.
+ *
+ * @note The pool must be destroyed before its Lua state is closed. Not thread-safe.
+ */
+class ThreadPool
+{
+public:
+    /**
+     * @brief Construct a pool of threads of a Lua state.
+     *
+     * @param L A Lua state.
+     * @param capacity The maximum number of threads kept by the pool.
+     */
+    explicit ThreadPool(lua_State* L, std::size_t capacity = 64)
+        : m_L(L)
+        , m_mainThread(mainThreadOf(L))
+        , m_threads(LuaRef::newTable(L))
+        , m_capacity(capacity)
+    {
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Get a thread, recycled if the pool is not empty or created otherwise.
+     *
+     * As for `lua_newthread`, the thread is pushed onto the stack of the pool state, which keeps it alive.
+     *
+     * @returns A thread with an empty stack.
+     */
+    lua_State* acquire()
+    {
+        if (m_size == 0)
+        {
+            ++m_created;
+            return lua_newthread(m_L);
+        }
+
+        m_threads.push(m_L);
+        lua_rawgeti(m_L, -1, static_cast<int>(m_size));
+        lua_pushnil(m_L);
+        lua_rawseti(m_L, -3, static_cast<int>(m_size));
+        lua_remove(m_L, -2);
+
+        --m_size;
+        ++m_reused;
+
+        return lua_tothread(m_L, -1);
+    }
+
+    /**
+     * @brief Reset a thread and keep it for reuse.
+     *
+     * @param thread A thread of the pool state which is not running. The main thread is never pooled.
+     *
+     * @returns true if the thread has been pooled, false if it is left to the garbage collector.
+     */
+    bool release(lua_State* thread)
+    {
+        if (thread == nullptr || thread == m_L || thread == m_mainThread || m_size >= m_capacity)
+            return false;
+
+        if (! lua_resetthread_x(thread, m_L))
+            return false;
+
+        m_threads.push(m_L);
+        lua_pushthread(thread);
+        lua_xmove(thread, m_L, 1);
+        lua_rawseti(m_L, -2, static_cast<int>(++m_size));
+        lua_pop(m_L, 1);
+
+        return true;
+    }
+
+    /**
+     * @brief Drop all the pooled threads, leaving them to the garbage collector.
+     */
+    void clear()
+    {
+        m_threads = LuaRef::newTable(m_L);
+        m_size = 0;
+    }
+
+    /**
+     * @brief The number of pooled threads.
+     */
+    [[nodiscard]] std::size_t size() const noexcept
+    {
+        return m_size;
+    }
+
+    /**
+     * @brief The maximum number of pooled threads.
+     */
+    [[nodiscard]] std::size_t capacity() const noexcept
+    {
+        return m_capacity;
+    }
+
+    /**
+     * @brief The number of threads created by `acquire` because the pool was empty.
+     */
+    [[nodiscard]] std::size_t created() const noexcept
+    {
+        return m_created;
+    }
+
+    /**
+     * @brief The number of threads recycled by `acquire`.
+     */
+    [[nodiscard]] std::size_t reused() const noexcept
+    {
+        return m_reused;
+    }
+
+private:
+    static lua_State* mainThreadOf(lua_State* L)
+    {
+#if LUA_VERSION_NUM < 502
+        // Lua 5.1 has no reference to the main thread, which is only known if it is the pool state itself
+        const bool isMainThread = lua_pushthread(L) == 1;
+        lua_pop(L, 1);
+        return isMainThread ? L : nullptr;
+#else
+        return main_thread(L);
+#endif
+    }
+
+    lua_State* m_L;
+    lua_State* m_mainThread;
+    LuaRef m_threads;
+    std::size_t m_capacity;
+    std::size_t m_size = 0;
+    std::size_t m_created = 0;
+    std::size_t m_reused = 0;
+};
+
+} // namespace luabridge
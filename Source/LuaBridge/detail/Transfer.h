@@ -0,0 +1,281 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "Config.h"
+#include "ClassInfo.h"
+#include "Errors.h"
+#include "LuaHelpers.h"
+#include "LuaRef.h"
+#include "Result.h"
+#include "Stack.h"
+#include "Userdata.h"
+
+#include <unordered_map>
+
+namespace luabridge {
+namespace detail {
+
+//=================================================================================================
+/**
+ * @brief Deep copy of a value from a Lua state onto the stack of another one.
+ *
+ * Tables and userdata already copied are tracked by identity in a table of the destination state, so shared references and
+ * cycles are reproduced instead of being copied again.
+ */
+class ValueTransfer
+{
+public:
+    ValueTransfer(lua_State* src, lua_State* dst) noexcept
+        : m_src(src)
+        , m_dst(dst)
+    {
+    }
+
+    Result push(int index)
+    {
+        const int type = lua_type(m_src, index);
+        if (type != LUA_TTABLE && type != LUA_TUSERDATA)
+            return copyValue(index, 0);
+
+        lua_newtable(m_dst);
+        m_copiesIndex = lua_gettop(m_dst);
+
+        auto result = copyValue(index, 0);
+        if (result)
+            lua_remove(m_dst, m_copiesIndex);
+
+        return result;
+    }
+
+private:
+    Result copyValue(int index, int depth)
+    {
+        if (! lua_checkstack(m_dst, 3) || ! lua_checkstack(m_src, 3))
+            return makeErrorCode(ErrorCode::LuaStackOverflow);
+
+        switch (lua_type(m_src, index))
+        {
+        case LUA_TNIL:
+            lua_pushnil(m_dst);
+            return {};
+
+        case LUA_TBOOLEAN:
+            lua_pushboolean(m_dst, lua_toboolean(m_src, index));
+            return {};
+
+        case LUA_TNUMBER:
+#if LUA_VERSION_NUM >= 503 && ! LUABRIDGE_ON_LUAU
+            if (lua_isinteger(m_src, index))
+            {
+                lua_pushinteger(m_dst, lua_tointeger(m_src, index));
+                return {};
+            }
+#endif
+
+            lua_pushnumber(m_dst, lua_tonumber(m_src, index));
+            return {};
+
+        case LUA_TSTRING:
+        {
+            std::size_t length = 0;
+            const char* string = lua_tolstring(m_src, index, &length);
+            lua_pushlstring(m_dst, string, length);
+            return {};
+        }
+
+        case LUA_TLIGHTUSERDATA:
+            lua_pushlightuserdata(m_dst, lua_touserdata(m_src, index));
+            return {};
+
+        case LUA_TTABLE:
+            return copyTable(index, depth);
+
+        case LUA_TUSERDATA:
+            return copyUserdata(index);
+
+        case LUA_TFUNCTION:
+            return copyFunction(index);
+
+        default:
+            return makeErrorCode(ErrorCode::ValueNotTransferable);
+        }
+    }
+
+    Result copyTable(int index, int depth)
+    {
+        const void* identity = lua_topointer(m_src, index);
+        if (pushCopied(identity))
+            return {};
+
+        if (depth >= LUABRIDGE_TRANSFER_MAX_DEPTH)
+            return makeErrorCode(ErrorCode::LuaStackOverflow);
+
+        lua_createtable(m_dst, get_length(m_src, index), 0); // Stack dst: ..., copy
+        remember(identity);
+
+        lua_pushnil(m_src); // Stack src: ..., nil
+        while (lua_next(m_src, index) != 0) // Stack src: ..., key, value
+        {
+            const int valueIndex = lua_gettop(m_src);
+
+            auto result = copyValue(valueIndex - 1, depth + 1);
+            if (result)
+                result = copyValue(valueIndex, depth + 1);
+
+            if (! result)
+            {
+                lua_pop(m_src, 2);
+                return result;
+            }
+
+            lua_rawset(m_dst, -3); // Stack dst: ..., copy
+            lua_pop(m_src, 1); // Stack src: ..., key
+        }
+
+        if (lua_getmetatable(m_src, index)) // Stack src: ..., metatable
+        {
+            auto result = copyValue(lua_gettop(m_src), depth + 1);
+            lua_pop(m_src, 1);
+
+            if (! result)
+                return result;
+
+            lua_setmetatable(m_dst, -2);
+        }
+
+        return {};
+    }
+
+    Result copyUserdata(int index)
+    {
+        void* identity = lua_touserdata(m_src, index);
+        if (pushCopied(identity))
+            return {};
+
+        // Only objects of registered classes know how to copy themselves
+        const void* registryKey = nullptr;
+        if (lua_getmetatable(m_src, index)) // Stack src: ..., metatable
+        {
+            lua_rawgetp_x(m_src, -1, getTypeIdentityKey()); // Stack src: ..., metatable, registry key | nil
+            if (lua_islightuserdata(m_src, -1))
+                registryKey = lua_touserdata(m_src, -1);
+
+            lua_pop(m_src, 2);
+        }
+
+        if (registryKey == nullptr)
+            return makeErrorCode(ErrorCode::ValueNotTransferable);
+
+        auto result = static_cast<Userdata*>(identity)->transfer(m_dst, registryKey);
+        if (! result)
+            return result;
+
+        remember(identity);
+        return {};
+    }
+
+    Result copyFunction(int index)
+    {
+        // Only C functions without upvalues are independent from their state
+        if (! lua_iscfunction(m_src, index))
+            return makeErrorCode(ErrorCode::ValueNotTransferable);
+
+        if (lua_getupvalue(m_src, index, 1) != nullptr)
+        {
+            lua_pop(m_src, 1);
+            return makeErrorCode(ErrorCode::ValueNotTransferable);
+        }
+
+        lua_pushcfunction_x(m_dst, lua_tocfunction(m_src, index), "");
+        return {};
+    }
+
+    bool pushCopied(const void* identity)
+    {
+        const auto it = m_copies.find(identity);
+        if (it == m_copies.end())
+            return false;
+
+        lua_rawgeti(m_dst, m_copiesIndex, it->second);
+        return true;
+    }
+
+    void remember(const void* identity)
+    {
+        const int copyIndex = static_cast<int>(m_copies.size()) + 1;
+
+        lua_pushvalue(m_dst, -1);
+        lua_rawseti(m_dst, m_copiesIndex, copyIndex);
+
+        m_copies.emplace(identity, copyIndex);
+    }
+
+    lua_State* m_src;
+    lua_State* m_dst;
+    int m_copiesIndex = 0;
+    std::unordered_map<const void*, int> m_copies;
+};
+
+} // namespace detail
+
+//=================================================================================================
+/**
+ * @brief Copy a value from a Lua state onto the stack of another Lua state, without converting it to C++ types.
+ *
+ * Nil, booleans, numbers, strings, light userdata and C functions without upvalues are copied as they are. Tables are copied
+ * deeply, including their metatables, preserving cycles and references shared inside the value. Objects of registered classes are
+ * copied by their userdata: containers of shared objects are copied and share the same object, pointers refer to the same object,
+ * and objects stored by value are copy constructed when copyable. Their class must be registered in the destination state too.
+ *
+ * The two states can run on different threads, as long as neither of them is used by another thread during the transfer.
+ *
+ * @warning Objects pushed by pointer are not copied: both states refer to the same C++ object afterwards. The caller must keep it
+ * alive for as long as either state can reach it, and synchronize the accesses to it when the states run on different threads.
+ *
+ * @param src The source Lua state.
+ * @param srcIdx The index of the value on the source stack.
+ * @param dst The destination Lua state, which must not be the same as src.
+ *
+ * @returns An error if the value or one of its elements can't be transferred, in which case nothing is pushed on dst.
+ */
+[[nodiscard]] inline Result transfer(lua_State* src, int srcIdx, lua_State* dst)
+{
+    if (src == dst)
+        return makeErrorCode(ErrorCode::ValueNotTransferable);
+
+    const StackRestore sourceRestore(src);
+    StackRestore stackRestore(dst);
+
+    detail::ValueTransfer valueTransfer(src, dst);
+
+    auto result = valueTransfer.push(lua_absindex(src, srcIdx));
+    if (result)
+        stackRestore.reset();
+
+    return result;
+}
+
+/**
+ * @brief Copy a value referenced in a Lua state to another Lua state.
+ *
+ * @see transfer(lua_State*, int, lua_State*)
+ */
+[[nodiscard]] inline TypeResult<LuaRef> transfer(const LuaRef& value, lua_State* dst)
+{
+    lua_State* src = value.state();
+
+    value.push(src);
+
+    auto result = transfer(src, -1, dst);
+    lua_pop(src, 1);
+
+    if (! result)
+        return result.error();
+
+    return LuaRef::fromStack(dst);
+}
+
+} // namespace luabridge
@@ -10,8 +10,11 @@
 #include "Errors.h"
 #include "LuaException.h"
 #include "ClassInfo.h"
+#include "ClassStats.h"
+#include "ExternalMemory.h"
 #include "TypeTraits.h"
 #include "Result.h"
+#include "ScopedArena.h"
 #include "Stack.h"
 
 #include <stdexcept>
@@ -372,17 +375,119 @@ public:
         return m_p;
     }
 
+    //=============================================================================================
+    /**
+     * @brief Push the object onto another Lua state, used by `transfer`.
+     *
+     * @param L The destination Lua state.
+     * @param registryKey The registry key of the class or const table of the object, looked up in the destination registry.
+     *
+     * @return An error if the object can't be transferred or its class is not registered in the destination state.
+     */
+    virtual Result transfer(lua_State* L, const void* registryKey)
+    {
+        unused(L, registryKey);
+
+        return makeErrorCode(ErrorCode::ValueNotTransferable);
+    }
+
+    /**
+     * @brief Check if the object is alive and owned by the userdata, its lifetime not being managed by C++.
+     */
+    virtual bool ownsObject() const noexcept
+    {
+        return false;
+    }
+
+    /**
+     * @brief Destroy an owned object before the collection of the userdata, used by the automatic `__close` metamethod.
+     */
+    virtual void destroyObject() noexcept
+    {
+    }
+
 protected:
     Userdata() = default;
 
+    /**
+     * @brief Push the class or const table stored in the registry under a key, used by `transfer`.
+     */
+    static Result pushRegistryMetatable(lua_State* L, const void* registryKey)
+    {
+        lua_rawgetp_x(L, LUA_REGISTRYINDEX, registryKey);
+
+        if (! lua_istable(L, -1))
+        {
+            lua_pop(L, 1); // possibly: a nil
+
+            return makeErrorCode(ErrorCode::ClassNotRegistered);
+        }
+
+        return {};
+    }
+
     void* m_p = nullptr; // subclasses must set this
 };
 
+//=================================================================================================
+/**
+ * @brief Wraps a pointer to a class object stored by value in a `ScopedArena`.
+ *
+ * The lifetime of the object is managed by the arena: the userdata is marked dead when the arena is destroyed.
+ */
+class UserdataArena : public Userdata
+{
+public:
+    explicit UserdataArena(Userdata* value) noexcept
+        : m_value(value)
+    {
+    }
+
+    UserdataArena(const UserdataArena&) = delete;
+    UserdataArena operator=(const UserdataArena&) = delete;
+
+    /**
+     * @brief Push a copy of the object onto another Lua state, as its arena value does.
+     */
+    Result transfer(lua_State* L, const void* registryKey) override
+    {
+        return m_value->transfer(L, registryKey);
+    }
+
+    /**
+     * @brief Check if the object was not destroyed yet, as its arena value does.
+     */
+    bool ownsObject() const noexcept override
+    {
+        return m_value->ownsObject();
+    }
+
+    /**
+     * @brief Destroy the object ahead of the arena, as its arena value does.
+     */
+    void destroyObject() noexcept override
+    {
+        m_value->destroyObject();
+    }
+
+    /**
+     * @brief Confirm the construction of the object in the arena.
+     */
+    void commit(void* object) noexcept
+    {
+        m_p = object;
+    }
+
+private:
+    Userdata* m_value = nullptr;
+};
+
 //=================================================================================================
 /**
  * @brief Wraps a class object stored in a Lua userdata.
  *
- * The lifetime of the object is managed by Lua. The object is constructed inside the userdata using placement new.
+ * The lifetime of the object is managed by Lua. The object is constructed inside the userdata using placement new, or in the
+ * active `ScopedArena` for the classes registered with the `arenaAllocated` option.
  */
 template <class T>
 class UserdataValue : public Userdata
@@ -414,6 +519,12 @@ public:
      */
     static UserdataValue<T>* place(lua_State* L, std::error_code& ec)
     {
+        if (ScopedArena* arena = scoped_arena_for<T>(L); arena != nullptr)
+        {
+            if (auto* value = placeInArena(L, *arena); value != nullptr)
+                return value;
+        }
+
         auto* ud = new (lua_newuserdata_x<UserdataValue<T>>(L, sizeof(UserdataValue<T>))) UserdataValue<T>();
 
         lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getClassRegistryKey<T>());
@@ -434,6 +545,7 @@ public:
         }
 
         lua_setmetatable(L, -2);
+        count_class_object_created(L, -1);
 
         return ud;
     }
@@ -458,7 +570,8 @@ public:
 
         new (ud->getObject()) U(u);
 
-        ud->commit();
+        ud->commit(L);
+        report_external_memory(L, -1, *ud->getObject());
 
         return {};
     }
@@ -483,17 +596,111 @@ public:
 
         new (ud->getObject()) U(std::move(u));
 
-        ud->commit();
+        ud->commit(L);
+        report_external_memory(L, -1, *ud->getObject());
+
+        return {};
+    }
+
+    /**
+     * @brief Push T constructed in place from the result of a callable.
+     *
+     * The userdata is allocated before invoking the callable, so a T returned by value is materialized directly into the userdata
+     * storage by guaranteed copy elision, without an intermediate temporary and without requiring T to be copyable or movable.
+     *
+     * @param L A Lua state.
+     * @param f A callable returning T by value.
+     */
+    template <class F>
+    static Result construct(lua_State* L, F&& f)
+    {
+        std::error_code ec;
+        auto* ud = place(L, ec);
+
+        if (!ud)
+            return ec;
+
+        new (ud->getObject()) T(std::forward<F>(f)());
+
+        ud->commit(L);
+        report_external_memory(L, -1, *ud->getObject());
 
         return {};
     }
 
+    /**
+     * @brief Push a copy of an object using the class or const table stored in the registry under a key.
+     *
+     * @param L A Lua state.
+     * @param object The object to copy.
+     * @param registryKey The registry key of the class or const table.
+     */
+    static Result pushCopy(lua_State* L, const T& object, const void* registryKey)
+    {
+        if (auto result = pushRegistryMetatable(L, registryKey); ! result)
+            return result;
+
+        auto* ud = new (lua_newuserdata_x<UserdataValue<T>>(L, sizeof(UserdataValue<T>))) UserdataValue<T>();
+
+        lua_insert(L, -2);
+        lua_setmetatable(L, -2);
+        count_class_object_created(L, -1);
+
+        new (ud->getObject()) T(object);
+
+        ud->commit(L);
+        report_external_memory(L, -1, *ud->getObject());
+
+        return {};
+    }
+
+    /**
+     * @brief Push a copy of the object onto another Lua state, if T is copy constructible.
+     */
+    Result transfer(lua_State* L, const void* registryKey) override
+    {
+        if constexpr (std::is_copy_constructible_v<T>)
+        {
+            return pushCopy(L, *getObject(), registryKey);
+        }
+        else
+        {
+            return Userdata::transfer(L, registryKey);
+        }
+    }
+
+    /**
+     * @brief Check if the object was not destroyed yet.
+     */
+    bool ownsObject() const noexcept override
+    {
+        return getPointer() != nullptr;
+    }
+
+    /**
+     * @brief Destroy the object, the destructor of the userdata value becoming a no-op.
+     */
+    void destroyObject() noexcept override
+    {
+        if (getPointer() == nullptr)
+            return;
+
+        m_p = nullptr;
+        getObject()->~T();
+    }
+
     /**
      * @brief Confirm object construction.
+     *
+     * @param L A Lua state, with the userdata returned by `place` on top of the stack.
      */
-    void commit() noexcept
+    void commit(lua_State* L) noexcept
     {
         m_p = getObject();
+
+        // Values placed in a scoped arena are referenced by an arena userdata, only valid once the object is constructed
+        if (void* userdata = lua_touserdata(L, -1); userdata != this)
+            static_cast<UserdataArena*>(userdata)->commit(m_p);
     }
 
     T* getObject() noexcept
@@ -525,6 +732,40 @@ private:
         }
     }
 
+    /**
+     * @brief Push a userdata referring to a T placed in an arena, the class of T being registered.
+     *
+     * @returns The value in the arena, or `nullptr` without pushing anything if the arena memory is exhausted or the class is
+     * not registered.
+     */
+    static UserdataValue<T>* placeInArena(lua_State* L, ScopedArena& arena)
+    {
+        void* storage = arena.allocate(sizeof(UserdataValue<T>), alignof(UserdataValue<T>), [](void* value)
+        {
+            static_cast<UserdataValue<T>*>(value)->~UserdataValue<T>();
+        });
+
+        if (storage == nullptr)
+            return nullptr;
+
+        auto* value = new (storage) UserdataValue<T>();
+        new (lua_newuserdata_x<UserdataArena>(L, sizeof(UserdataArena))) UserdataArena(value);
+
+        lua_rawgetp_x(L, LUA_REGISTRYINDEX, detail::getClassRegistryKey<T>());
+        if (! lua_istable(L, -1))
+        {
+            lua_pop(L, 2); // The unconstructed value is left to the arena, its destructor being a no-op
+            return nullptr;
+        }
+
+        lua_setmetatable(L, -2);
+        count_class_object_created(L, -1);
+
+        arena.track(L, -1);
+
+        return value;
+    }
+
     alignas(AlignType) unsigned char m_storage[sizeof(T) + MaxPadding];
 };
 
@@ -578,6 +819,26 @@ public:
         return {};
     }
 
+    /**
+     * @brief Push the same pointer onto another Lua state, the object lifetime being still managed by C++.
+     *
+     * Both states share the object: the caller keeps it alive for as long as either state can reach it, and synchronizes the
+     * accesses to it when the states run on different threads.
+     */
+    Result transfer(lua_State* L, const void* registryKey) override
+    {
+        if (auto result = pushRegistryMetatable(L, registryKey); ! result)
+            return result;
+
+        new (lua_newuserdata_x<UserdataPtr>(L, sizeof(UserdataPtr))) UserdataPtr(m_p);
+
+        lua_insert(L, -2);
+        lua_setmetatable(L, -2);
+        count_class_object_created(L, -1);
+
+        return {};
+    }
+
 private:
     /**
      * @brief Push a pointer to object using metatable key.
@@ -602,6 +863,7 @@ private:
         }
 
         lua_setmetatable(L, -2);
+        count_class_object_created(L, -1);
 
         return {};
     }
@@ -666,6 +928,7 @@ public:
         }
 
         lua_setmetatable(L, -2);
+        count_class_object_created(L, -1);
 
         return ud;
     }
@@ -675,6 +938,42 @@ public:
         return static_cast<T*>(m_p);
     }
 
+    /**
+     * @brief Push a copy of the object onto another Lua state as a value, if T is copy constructible.
+     */
+    Result transfer(lua_State* L, const void* registryKey) override
+    {
+        if constexpr (std::is_copy_constructible_v<T>)
+        {
+            return UserdataValue<T>::pushCopy(L, *getObject(), registryKey);
+        }
+        else
+        {
+            return Userdata::transfer(L, registryKey);
+        }
+    }
+
+    /**
+     * @brief Check if the object was not freed yet.
+     */
+    bool ownsObject() const noexcept override
+    {
+        return getPointer() != nullptr;
+    }
+
+    /**
+     * @brief Free the object with its deallocator, the destructor of the userdata value becoming a no-op.
+     */
+    void destroyObject() noexcept override
+    {
+        T* object = getObject();
+        if (object == nullptr)
+            return;
+
+        m_p = nullptr;
+        m_dealloc(object);
+    }
+
 private:
     UserdataValueExternal(void* ptr, void (*dealloc)(T*)) noexcept
     {
@@ -731,6 +1030,23 @@ public:
         m_p = const_cast<void*>(reinterpret_cast<const void*>((ContainerTraits<C>::get(m_c))));
     }
 
+    /**
+     * @brief Push a copy of the container onto another Lua state, sharing the object.
+     */
+    Result transfer(lua_State* L, const void* registryKey) override
+    {
+        if (auto result = pushRegistryMetatable(L, registryKey); ! result)
+            return result;
+
+        new (lua_newuserdata_x<UserdataShared<C>>(L, sizeof(UserdataShared<C>))) UserdataShared<C>(m_c);
+
+        lua_insert(L, -2);
+        lua_setmetatable(L, -2);
+        count_class_object_created(L, -1);
+
+        return {};
+    }
+
 private:
     C m_c;
 };
@@ -766,6 +1082,7 @@ struct UserdataSharedHelper
             }
 
             lua_setmetatable(L, -2);
+            count_class_object_created(L, -1);
         }
         else
         {
@@ -797,6 +1114,7 @@ struct UserdataSharedHelper
             }
 
             lua_setmetatable(L, -2);
+            count_class_object_created(L, -1);
         }
         else
         {
@@ -837,6 +1155,7 @@ struct UserdataSharedHelper<C, true>
             }
 
             lua_setmetatable(L, -2);
+            count_class_object_created(L, -1);
         }
         else
         {
@@ -868,6 +1187,7 @@ struct UserdataSharedHelper<C, true>
             }
 
             lua_setmetatable(L, -2);
+            count_class_object_created(L, -1);
         }
         else
         {
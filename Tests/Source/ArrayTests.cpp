@@ -147,6 +147,18 @@ TEST_F(ArrayTests, FailOnWrongSize)
     EXPECT_FALSE((luabridge::isInstance<std::array<lua_Integer, 3>>(L, -1)));
 }
 
+TEST_F(ArrayTests, FailOnHoles)
+{
+    lua_createtable(L, 3, 0);
+    lua_pushinteger(L, 1);
+    lua_rawseti(L, -2, 1);
+    lua_pushinteger(L, 3);
+    lua_rawseti(L, -2, 3);
+
+    auto result = luabridge::Stack<std::array<std::optional<int>, 3>>::get(L, -1);
+    EXPECT_FALSE(result);
+}
+
 TEST_F(ArrayTests, GetNonTable)
 {
     lua_pushnumber(L, 42.0);
@@ -0,0 +1,196 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include "LuaBridge/BindingImage.h"
+
+#include <string>
+
+namespace {
+struct Base
+{
+    virtual ~Base() = default;
+
+    virtual std::string name() const { return "base"; }
+
+    int value = 1;
+};
+
+struct Derived : Base
+{
+    Derived() = default;
+    explicit Derived(int v) { value = v; }
+
+    std::string name() const override { return "derived"; }
+
+    int add(int x) const { return value + x; }
+    int add(int x, int y) const { return value + x + y; }
+
+    static int twice(int x) { return x * 2; }
+};
+
+int square(int x)
+{
+    return x * x;
+}
+
+void registerBindings(lua_State* L)
+{
+    luabridge::getGlobalNamespace(L)
+        .beginNamespace("geometry")
+            .addFunction("square", &square)
+            .addVariable("version", 3)
+            .beginClass<Base>("Base")
+                .addFunction("name", &Base::name)
+                .addProperty("value", &Base::value, &Base::value)
+            .endClass()
+            .deriveClass<Derived, Base>("Derived")
+                .addConstructor<void (*)(), void (*)(int)>()
+                .addFunction("add",
+                    luabridge::constOverload<int>(&Derived::add),
+                    luabridge::constOverload<int, int>(&Derived::add))
+                .addStaticFunction("twice", &Derived::twice)
+            .endClass()
+        .endNamespace();
+}
+} // namespace
+
+struct BindingImageTests : TestBase
+{
+};
+
+TEST_F(BindingImageTests, RecordAndApply)
+{
+    auto image = luabridge::BindingImage::record(&registerBindings);
+    ASSERT_TRUE(image);
+    EXPECT_GT(image->size(), 0u);
+    EXPECT_GT(image->objects(), 0u);
+
+    const int top = lua_gettop(L);
+    ASSERT_TRUE(image->apply(L));
+    EXPECT_EQ(top, lua_gettop(L));
+
+    runLua(R"(
+        local d = geometry.Derived(5)
+        result = tostring(d:name()) .. ":" .. d.value .. ":" .. d:add(1) .. ":" .. d:add(1, 2)
+            .. ":" .. geometry.Derived.twice(4) .. ":" .. geometry.square(3) .. ":" .. geometry.version
+    )");
+    EXPECT_EQ("derived:5:6:8:8:9:3", result<std::string>());
+
+    runLua("local d = geometry.Derived(); d.value = 10; result = d.value");
+    EXPECT_EQ(10, result<int>());
+}
+
+TEST_F(BindingImageTests, AppliedClassesWorkFromCpp)
+{
+    auto image = luabridge::BindingImage::record(&registerBindings);
+    ASSERT_TRUE(image);
+    ASSERT_TRUE(image->apply(L));
+
+    Derived derived(7);
+    ASSERT_TRUE(luabridge::setGlobal(L, &derived, "object"));
+
+    runLua("result = object:add(3)");
+    EXPECT_EQ(10, result<int>());
+
+    runLua("result = geometry.Derived(2)");
+    EXPECT_EQ(2, result().unsafe_cast<const Base*>()->value);
+    EXPECT_EQ("derived", result().unsafe_cast<const Base*>()->name());
+}
+
+TEST_F(BindingImageTests, StatesAreIndependent)
+{
+    auto image = luabridge::BindingImage::record(&registerBindings);
+    ASSERT_TRUE(image);
+
+    lua_State* other = createNewLuaState();
+    ASSERT_TRUE(image->apply(L));
+    ASSERT_TRUE(image->apply(other));
+
+    runLua("geometry.version = 4; result = geometry.Derived(1):add(1)");
+    EXPECT_EQ(2, result<int>());
+
+    EXPECT_TRUE(runLua("assert(geometry.version == 3); assert(geometry.Derived(2):add(2) == 4)", other));
+
+    lua_close(other);
+}
+
+TEST_F(BindingImageTests, SameBehaviourAsRegistration)
+{
+    auto image = luabridge::BindingImage::record(&registerBindings);
+    ASSERT_TRUE(image);
+    ASSERT_TRUE(image->apply(L));
+
+    lua_State* other = createNewLuaState();
+    registerBindings(other);
+
+    const char* script = R"(
+        local ok, err = pcall(function() return geometry.Derived():add("x") end)
+        assert(not ok)
+        assert(getmetatable(geometry.Derived()) ~= nil)
+        local base = geometry.Derived(4)
+        assert(base.value == 4)
+    )";
+
+    EXPECT_TRUE(runLua(script));
+    EXPECT_TRUE(runLua(script, other));
+
+    lua_close(other);
+}
+
+TEST_F(BindingImageTests, EmptySetup)
+{
+    auto image = luabridge::BindingImage::record([](lua_State*) {});
+    ASSERT_TRUE(image);
+    EXPECT_EQ(0u, image->objects());
+    EXPECT_TRUE(image->apply(L));
+}
+
+TEST_F(BindingImageTests, UnrecordableValues)
+{
+    auto lambda = luabridge::BindingImage::record([](lua_State* L)
+    {
+        luabridge::getGlobalNamespace(L)
+            .addFunction("lambda", [](int x) { return x + 1; });
+    });
+
+    ASSERT_FALSE(lambda);
+    EXPECT_EQ(luabridge::makeErrorCode(luabridge::ErrorCode::ValueNotTransferable), lambda.error());
+
+    auto script = luabridge::BindingImage::record([](lua_State* L)
+    {
+        ASSERT_EQ(LUABRIDGE_LUA_OK, luaL_loadstring(L, "function f() end"));
+        ASSERT_EQ(LUABRIDGE_LUA_OK, lua_pcall(L, 0, 0, 0));
+    });
+
+    ASSERT_FALSE(script);
+}
+
+TEST_F(BindingImageTests, ApplyReplacesExistingEntries)
+{
+    luabridge::getGlobalNamespace(L)
+        .beginNamespace("geometry")
+            .addFunction("cube", +[](int x) { return x * x * x; })
+        .endNamespace();
+
+    auto image = luabridge::BindingImage::record(&registerBindings);
+    ASSERT_TRUE(image);
+    ASSERT_TRUE(image->apply(L));
+
+    runLua("result = geometry.cube == nil and geometry.square(4) == 16");
+    EXPECT_TRUE(result<bool>());
+}
+
+#if LUABRIDGE_ON_LUAU
+TEST_F(BindingImageTests, ClosuresKeepTheirDebugNames)
+{
+    auto image = luabridge::BindingImage::record(&registerBindings);
+    ASSERT_TRUE(image);
+    ASSERT_TRUE(image->apply(L));
+
+    runLua("result = debug.info(geometry.square, 'n')");
+    EXPECT_EQ("square", result<std::string>());
+}
+#endif
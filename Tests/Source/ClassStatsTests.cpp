@@ -0,0 +1,126 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#if LUABRIDGE_ENABLE_CLASS_STATS
+
+#include <array>
+#include <optional>
+#include <string>
+
+namespace {
+struct CountedBase
+{
+    virtual ~CountedBase() = default;
+
+    std::array<char, 256> payload{};
+};
+
+struct CountedDerived : CountedBase
+{
+};
+
+std::optional<luabridge::ClassStats> findClassStats(lua_State* L, const std::string& name)
+{
+    for (auto& stats : luabridge::getClassStats(L))
+    {
+        if (stats.name == name)
+            return stats;
+    }
+
+    return std::nullopt;
+}
+} // namespace
+
+struct ClassStatsTests : TestBase
+{
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        luabridge::getGlobalNamespace(L)
+            .beginClass<CountedBase>("CountedBase")
+                .addConstructor<void (*)()>()
+            .endClass()
+            .deriveClass<CountedDerived, CountedBase>("CountedDerived")
+                .addConstructor<void (*)()>()
+            .endClass()
+            .addFunction("getClassStats", &luabridge::getClassStatsTable);
+    }
+};
+
+TEST_F(ClassStatsTests, NoStatsBeforeTheFirstObject)
+{
+    EXPECT_TRUE(luabridge::getClassStats(L).empty());
+}
+
+TEST_F(ClassStatsTests, CountsValueObjects)
+{
+    runLua(R"(
+        objects = {}
+        for i = 1, 3 do objects[i] = CountedBase() end
+    )");
+
+    auto stats = findClassStats(L, "CountedBase");
+    ASSERT_TRUE(stats);
+    EXPECT_EQ(3u, stats->live);
+    EXPECT_EQ(3u, stats->created);
+    EXPECT_EQ(0u, stats->collected);
+    EXPECT_LE(3 * sizeof(CountedBase), stats->bytes);
+
+    EXPECT_FALSE(findClassStats(L, "CountedDerived"));
+
+#if ! LUABRIDGE_ON_LUAU
+    runLua("objects = nil");
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    stats = findClassStats(L, "CountedBase");
+    ASSERT_TRUE(stats);
+    EXPECT_EQ(0u, stats->live);
+    EXPECT_EQ(3u, stats->created);
+    EXPECT_EQ(3u, stats->collected);
+    EXPECT_EQ(0u, stats->bytes);
+#endif
+}
+
+TEST_F(ClassStatsTests, CountsPointersAndConstPointersInTheSameClass)
+{
+    CountedBase object;
+    const CountedBase& constObject = object;
+
+    luabridge::setGlobal(L, &object, "pointer");
+    luabridge::setGlobal(L, &constObject, "constPointer");
+
+    auto stats = findClassStats(L, "CountedBase");
+    ASSERT_TRUE(stats);
+    EXPECT_EQ(2u, stats->live);
+    EXPECT_EQ(2u, stats->created);
+    EXPECT_GT(sizeof(CountedBase), stats->bytes);
+}
+
+TEST_F(ClassStatsTests, DerivedClassesAreCountedSeparately)
+{
+    runLua(R"(
+        base = CountedBase()
+        derived = CountedDerived()
+    )");
+
+    EXPECT_EQ(1u, findClassStats(L, "CountedBase")->created);
+    EXPECT_EQ(1u, findClassStats(L, "CountedDerived")->created);
+}
+
+TEST_F(ClassStatsTests, ReadableFromLua)
+{
+    runLua(R"(
+        local keep = { CountedBase(), CountedBase(), CountedDerived() }
+        local stats = getClassStats()
+        result = stats.CountedBase.live .. " " .. stats.CountedBase.created .. " " .. stats.CountedDerived.live
+    )");
+
+    EXPECT_EQ("2 2 1", result<std::string>());
+}
+
+#endif // LUABRIDGE_ENABLE_CLASS_STATS
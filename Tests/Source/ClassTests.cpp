@@ -4017,3 +4017,55 @@ TEST_F(ClassTests, StaticClassAccessReturnsMethodFromConstTable)
     EXPECT_TRUE(runLua("result = type(SimpleClass.getValue)"));
     EXPECT_EQ("function", result<std::string>());
 }
+
+TEST_F(ClassTests, MetadataSharedAcrossStates)
+{
+    struct SharedClass
+    {
+        int value = 3;
+
+        int get() const { return value; }
+        int add(int x) const { return value + x; }
+        int add(int x, int y) const { return value + x + y; }
+    };
+
+    const auto registerSharedClass = [](lua_State* state)
+    {
+        luabridge::getGlobalNamespace(state)
+            .beginClass<SharedClass>("SharedClass")
+                .addConstructor<void (*)()>()
+                .addFunction("get", &SharedClass::get)
+                .addFunction("add",
+                    luabridge::constOverload<int>(&SharedClass::add),
+                    luabridge::constOverload<int, int>(&SharedClass::add))
+                .addProperty("value", &SharedClass::value, &SharedClass::value)
+            .endClass();
+    };
+
+    const auto upvaluePointer = [](lua_State* state, const char* script)
+    {
+        EXPECT_EQ(LUABRIDGE_LUA_OK, luaL_loadstring(state, script));
+        EXPECT_EQ(LUABRIDGE_LUA_OK, lua_pcall(state, 0, 1, 0));
+        EXPECT_NE(nullptr, lua_getupvalue(state, -1, 1));
+        EXPECT_TRUE(lua_islightuserdata(state, -1));
+
+        const void* pointer = lua_touserdata(state, -1);
+        lua_pop(state, 2);
+        return pointer;
+    };
+
+    lua_State* other = createNewLuaState();
+    registerSharedClass(L);
+    registerSharedClass(other);
+
+    for (const char* script : { "return SharedClass().get", "return SharedClass().add" })
+        EXPECT_EQ(upvaluePointer(L, script), upvaluePointer(other, script));
+
+    EXPECT_TRUE(runLua("local o = SharedClass(); o.value = 4; result = o:get() + o:add(1) + o:add(1, 2)"));
+    EXPECT_EQ(4 + 5 + 7, result<int>());
+
+    ASSERT_TRUE(runLua("local o = SharedClass(); result = o:get() + o:add(1) + o:add(1, 2)", other));
+    EXPECT_EQ(3 + 4 + 6, luabridge::getGlobal(other, "result").unsafe_cast<int>());
+
+    lua_close(other);
+}
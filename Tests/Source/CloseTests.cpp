@@ -0,0 +1,272 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include <string>
+
+namespace {
+int resourcesAlive = 0;
+int resourcesReleased = 0;
+int resourcesDestructed = 0;
+
+struct Resource
+{
+    explicit Resource(int value = 0)
+        : value(value)
+    {
+        ++resourcesAlive;
+    }
+
+    Resource(const Resource& other)
+        : value(other.value)
+    {
+        ++resourcesAlive;
+    }
+
+    ~Resource()
+    {
+        --resourcesAlive;
+    }
+
+    void release()
+    {
+        released = true;
+        ++resourcesReleased;
+    }
+
+    int value;
+    bool released = false;
+};
+
+struct ScopedResource
+{
+    explicit ScopedResource(int value = 0)
+        : value(value)
+    {
+        ++resourcesAlive;
+    }
+
+    ~ScopedResource()
+    {
+        --resourcesAlive;
+    }
+
+    int value;
+};
+
+int readScopedResource(const ScopedResource* resource)
+{
+    return resource->value;
+}
+
+struct DerivedResource : Resource
+{
+    using Resource::Resource;
+};
+
+struct LockedResource : Resource
+{
+    using Resource::Resource;
+};
+
+void releaseLockedResource(LockedResource& resource)
+{
+    resource.release();
+}
+} // namespace
+
+struct CloseTests : TestBase
+{
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        resourcesAlive = 0;
+        resourcesReleased = 0;
+        resourcesDestructed = 0;
+
+        luabridge::getGlobalNamespace(L)
+            .beginClass<Resource>("Resource")
+                .addConstructor<void (*)(int)>()
+                .addProperty("value", &Resource::value)
+                .addProperty("released", &Resource::released)
+                .addCloseMethod(&Resource::release)
+            .endClass()
+            .beginClass<ScopedResource>("ScopedResource")
+                .addConstructor<void (*)(int)>()
+                .addProperty("value", &ScopedResource::value)
+                .addDestructor([](ScopedResource*) { ++resourcesDestructed; })
+                .addCloseMethod()
+            .endClass()
+            .deriveClass<DerivedResource, Resource>("DerivedResource")
+                .addConstructor<void (*)(int)>()
+            .endClass()
+            .deriveClass<LockedResource, Resource>("LockedResource")
+                .addConstructor<void (*)(int)>()
+                .addCloseMethod(&releaseLockedResource)
+            .endClass()
+            .addFunction("readScopedResource", &readScopedResource);
+    }
+};
+
+TEST_F(CloseTests, CloseMethodsAreRegisteredAsMetamethods)
+{
+    for (const void* key : { luabridge::detail::getClassRegistryKey<Resource>(),
+                             luabridge::detail::getConstRegistryKey<Resource>(),
+                             luabridge::detail::getClassRegistryKey<LockedResource>(),
+                             luabridge::detail::getConstRegistryKey<LockedResource>(),
+                             luabridge::detail::getClassRegistryKey<ScopedResource>(),
+                             luabridge::detail::getConstRegistryKey<ScopedResource>() })
+    {
+        luabridge::lua_rawgetp_x(L, LUA_REGISTRYINDEX, key);
+        lua_pushstring(L, "__close");
+        lua_rawget(L, -2);
+        EXPECT_TRUE(lua_isfunction(L, -1));
+        lua_pop(L, 2);
+    }
+}
+
+TEST_F(CloseTests, CloseMethodsAreNotInherited)
+{
+    luabridge::lua_rawgetp_x(L, LUA_REGISTRYINDEX, luabridge::detail::getClassRegistryKey<DerivedResource>());
+    lua_pushstring(L, "__close");
+    lua_rawget(L, -2);
+    EXPECT_TRUE(lua_isnil(L, -1));
+    lua_pop(L, 2);
+}
+
+#if LUA_VERSION_NUM >= 504 && ! LUABRIDGE_ON_LUAU
+TEST_F(CloseTests, CloseMethodIsCalledAtTheEndOfTheScope)
+{
+    runLua(R"(
+        kept = Resource(1)
+        do
+            local resource <close> = kept
+            before = resource.released
+        end
+        result = kept.released
+    )");
+
+    EXPECT_TRUE(result<bool>());
+    EXPECT_EQ(1, resourcesReleased);
+    EXPECT_EQ(1, resourcesAlive);
+
+    lua_getglobal(L, "before");
+    EXPECT_FALSE(lua_toboolean(L, -1));
+    lua_pop(L, 1);
+}
+
+TEST_F(CloseTests, CloseMethodIsCalledWhenAnErrorUnwindsTheScope)
+{
+    runLua(R"(
+        kept = Resource(1)
+        result = pcall(function()
+            local resource <close> = kept
+            error("failure")
+        end)
+    )");
+
+    EXPECT_FALSE(result<bool>());
+    EXPECT_EQ(1, resourcesReleased);
+}
+
+TEST_F(CloseTests, CloseMethodClosesConstObjects)
+{
+    Resource resource(1);
+    luabridge::setGlobal(L, static_cast<const Resource*>(&resource), "resource");
+
+    LockedResource locked(2);
+    luabridge::setGlobal(L, static_cast<const LockedResource*>(&locked), "locked");
+
+    runLua(R"(
+        do
+            local a <close> = resource
+            local b <close> = locked
+        end
+    )");
+
+    EXPECT_TRUE(resource.released);
+    EXPECT_TRUE(locked.released);
+    EXPECT_EQ(2, resourcesReleased);
+}
+
+TEST_F(CloseTests, DerivedClassesWithoutCloseMethodAreNotClosable)
+{
+#if LUABRIDGE_HAS_EXCEPTIONS
+    EXPECT_ANY_THROW(runLua("do local resource <close> = DerivedResource(1) end"));
+#else
+    EXPECT_FALSE(runLua("do local resource <close> = DerivedResource(1) end"));
+#endif
+
+    runLua(R"(
+        kept = LockedResource(1)
+        do local resource <close> = kept end
+        result = kept.released
+    )");
+
+    EXPECT_TRUE(result<bool>());
+}
+
+TEST_F(CloseTests, AutomaticCloseDestroysTheObject)
+{
+    runLua(R"(
+        do
+            local resource <close> = ScopedResource(3)
+            result = readScopedResource(resource)
+        end
+    )");
+
+    EXPECT_EQ(3, result<int>());
+    EXPECT_EQ(0, resourcesAlive);
+    EXPECT_EQ(1, resourcesDestructed);
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    EXPECT_EQ(0, resourcesAlive);
+    EXPECT_EQ(1, resourcesDestructed);
+}
+
+TEST_F(CloseTests, ClosedObjectsRaiseErrors)
+{
+    runLua(R"(
+        kept = ScopedResource(1)
+        do local resource <close> = kept end
+    )");
+
+    EXPECT_EQ(0, resourcesAlive);
+
+#if LUABRIDGE_HAS_EXCEPTIONS
+    EXPECT_ANY_THROW(runLua("result = kept.value"));
+    EXPECT_ANY_THROW(runLua("result = readScopedResource(kept)"));
+#else
+    EXPECT_FALSE(runLua("result = kept.value"));
+    EXPECT_FALSE(runLua("result = readScopedResource(kept)"));
+#endif
+
+    runLua("result = tostring(kept)");
+    EXPECT_EQ(0u, result<std::string>().find("destroyed object"));
+
+    runLua("do local again <close> = kept end");
+    EXPECT_EQ(1, resourcesDestructed);
+
+    lua_getglobal(L, "kept");
+    EXPECT_FALSE(luabridge::Stack<ScopedResource*>::isInstance(L, -1));
+    lua_pop(L, 1);
+}
+
+TEST_F(CloseTests, AutomaticCloseLeavesObjectsOwnedByCpp)
+{
+    ScopedResource stored(5);
+    luabridge::setGlobal(L, &stored, "stored");
+
+    runLua(R"(
+        do local resource <close> = stored end
+        result = stored.value
+    )");
+
+    EXPECT_EQ(5, result<int>());
+    EXPECT_EQ(1, resourcesAlive);
+    EXPECT_EQ(0, resourcesDestructed);
+}
+#endif
@@ -193,6 +193,74 @@ TEST_F(CoroutineTests, ThreadedRegistration)
 #endif
 }
 
+TEST_F(CoroutineTests, ThreadPoolReusesFinishedThreads)
+{
+    luabridge::ThreadPool pool(L, 2);
+
+    runLua("function add(a, b) return a + b end");
+
+    lua_State* thread = pool.acquire();
+    ASSERT_NE(nullptr, thread);
+    EXPECT_EQ(LUA_TTHREAD, lua_type(L, -1));
+    EXPECT_EQ(1u, pool.created());
+
+    luabridge::getGlobal(L, "add").push(thread);
+    lua_pushinteger(thread, 1);
+    lua_pushinteger(thread, 2);
+    ASSERT_EQ(LUABRIDGE_LUA_OK, luabridge::lua_resume_x(thread, L, 2));
+    EXPECT_EQ(3, lua_tointeger(thread, -1));
+
+    lua_pop(L, 1);
+    EXPECT_TRUE(pool.release(thread));
+    EXPECT_EQ(1u, pool.size());
+    EXPECT_EQ(0, lua_gettop(thread));
+
+    // The thread is anchored by the pool while unused
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    EXPECT_EQ(thread, pool.acquire());
+    EXPECT_EQ(0u, pool.size());
+    EXPECT_EQ(1u, pool.reused());
+
+    luabridge::getGlobal(L, "add").push(thread);
+    lua_pushinteger(thread, 3);
+    lua_pushinteger(thread, 4);
+    ASSERT_EQ(LUABRIDGE_LUA_OK, luabridge::lua_resume_x(thread, L, 2));
+    EXPECT_EQ(7, lua_tointeger(thread, -1));
+}
+
+TEST_F(CoroutineTests, ThreadPoolRejectsUnusableThreads)
+{
+    luabridge::ThreadPool pool(L, 1);
+
+    EXPECT_FALSE(pool.release(L));
+    EXPECT_FALSE(pool.release(nullptr));
+
+    runLua(R"(
+        function fail() error("failure") end
+        function suspend() coroutine.yield(1) end
+    )");
+
+    lua_State* failed = pool.acquire();
+    luabridge::getGlobal(L, "fail").push(failed);
+    EXPECT_NE(LUABRIDGE_LUA_OK, luabridge::lua_resume_x(failed, L, 0));
+
+    lua_State* suspended = pool.acquire();
+    luabridge::getGlobal(L, "suspend").push(suspended);
+    EXPECT_EQ(LUA_YIELD, luabridge::lua_resume_x(suspended, L, 0));
+
+#if LUABRIDGE_ON_LUAU || (LUA_VERSION_NUM >= 504 && ! LUABRIDGE_ON_RAVI)
+    EXPECT_TRUE(pool.release(failed));
+    EXPECT_EQ(0, lua_gettop(failed));
+
+    // Full pool
+    EXPECT_FALSE(pool.release(suspended));
+#else
+    EXPECT_FALSE(pool.release(failed));
+    EXPECT_FALSE(pool.release(suspended));
+#endif
+}
+
 //=============================================================================
 // C++20 coroutine tests
 //=============================================================================
@@ -788,6 +856,139 @@ TEST_F(CppCoroutineTests, AbandonedCoroutineNoLeak)
     EXPECT_EQ(1, destructed);
 }
 
+TEST_F(CppCoroutineTests, FramesRecycledThroughStatePool)
+{
+    luabridge::getGlobalNamespace(L)
+        .addCoroutine("countTo", [](int n) -> luabridge::CppCoroutine<int>
+        {
+            for (int i = 0; i < n; ++i)
+                co_yield i;
+            co_return n;
+        });
+
+    ASSERT_TRUE(runLua(
+        "for i = 1, 100 do\n"
+        "  local f = coroutine.wrap(countTo)\n"
+        "  local v = f(3)\n"
+        "  while v ~= 3 do v = f() end\n"
+        "  collectgarbage()\n"
+        "end\n"
+    ));
+
+    // Completed frames are destroyed and their blocks reused by the next coroutine
+    auto* pool = luabridge::detail::CoroutineFramePool::get(L);
+    EXPECT_EQ(0u, pool->outstanding());
+    EXPECT_EQ(1u, pool->cached());
+
+    // A coroutine still suspended when the state is closed keeps the pool alive until its frame is destroyed
+    ASSERT_TRUE(runLua(
+        "held = coroutine.wrap(countTo)\n"
+        "first = held(5)\n"
+    ));
+
+    EXPECT_EQ(0, luabridge::getGlobal(L, "first").unsafe_cast<int>());
+    EXPECT_EQ(1u, pool->outstanding());
+    EXPECT_EQ(0u, pool->cached());
+}
+
+TEST_F(CppCoroutineTests, CompletedCoroutineDestroyedWithoutCollection)
+{
+    int destructed = 0;
+    struct Guard { int* p; ~Guard() { ++(*p); } };
+
+    luabridge::getGlobalNamespace(L)
+        .addCoroutine("guarded", [&destructed](int n) -> luabridge::CppCoroutine<int>
+        {
+            Guard g{ &destructed };
+            co_yield n;
+            co_return n + 1;
+        });
+
+    luabridge::ThreadPool pool(L);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        lua_State* thread = pool.acquire();
+
+        luabridge::getGlobal(L, "guarded").push(thread);
+        lua_pushinteger(thread, i);
+        int nresults = 0;
+        ASSERT_EQ(LUA_YIELD, luabridge::lua_resume_x(thread, L, 1, &nresults));
+        lua_pop(thread, nresults);
+        ASSERT_EQ(LUABRIDGE_LUA_OK, luabridge::lua_resume_x(thread, L, 0));
+        EXPECT_EQ(i + 1, lua_tointeger(thread, -1));
+
+        // The frame has been destroyed when the coroutine returned, before any collection
+        EXPECT_EQ(i + 1, destructed);
+
+        lua_pop(L, 1);
+        EXPECT_TRUE(pool.release(thread));
+    }
+
+    EXPECT_EQ(1u, pool.created());
+    EXPECT_EQ(2u, pool.reused());
+}
+
+TEST_F(CppCoroutineTests, TupleYieldsMultipleValues)
+{
+    luabridge::getGlobalNamespace(L)
+        .addCoroutine("entries", []() -> luabridge::CppCoroutine<std::tuple<std::string, int>>
+        {
+            co_yield std::make_tuple(std::string("a"), 1);
+            co_yield std::make_tuple(std::string("b"), 2);
+            co_return std::make_tuple(std::string("end"), 0);
+        });
+
+    ASSERT_TRUE(runLua(
+        "local co = coroutine.create(entries)\n"
+        "local ok\n"
+        "ok, k1, v1 = coroutine.resume(co)\n"
+        "ok, k2, v2 = coroutine.resume(co)\n"
+        "count = select('#', coroutine.resume(co)) - 1\n"
+        "status = coroutine.status(co)\n"
+    ));
+
+    EXPECT_EQ("a", luabridge::getGlobal(L, "k1").unsafe_cast<std::string>());
+    EXPECT_EQ(1, luabridge::getGlobal(L, "v1").unsafe_cast<int>());
+    EXPECT_EQ("b", luabridge::getGlobal(L, "k2").unsafe_cast<std::string>());
+    EXPECT_EQ(2, luabridge::getGlobal(L, "v2").unsafe_cast<int>());
+    EXPECT_EQ(2, luabridge::getGlobal(L, "count").unsafe_cast<int>());
+    EXPECT_EQ("dead", luabridge::getGlobal(L, "status").unsafe_cast<std::string>());
+}
+
+TEST_F(CppCoroutineTests, ValuesYieldMultipleValues)
+{
+    luabridge::getGlobalNamespace(L)
+        .addCoroutine("weighted", []() -> luabridge::CppCoroutine<int>
+        {
+            co_yield luabridge::values(std::string("key"), 42, 0.5);
+            co_yield 7;
+            co_return 0;
+        })
+        .addCoroutine("pairsOnly", []() -> luabridge::CppCoroutine<void>
+        {
+            co_yield luabridge::values(1, 2);
+            co_return;
+        });
+
+    ASSERT_TRUE(runLua(
+        "local f = coroutine.wrap(weighted)\n"
+        "key, value, weight = f()\n"
+        "single = select('#', f())\n"
+        "local g = coroutine.wrap(pairsOnly)\n"
+        "a, b = g()\n"
+        "last = select('#', g())\n"
+    ));
+
+    EXPECT_EQ("key", luabridge::getGlobal(L, "key").unsafe_cast<std::string>());
+    EXPECT_EQ(42, luabridge::getGlobal(L, "value").unsafe_cast<int>());
+    EXPECT_DOUBLE_EQ(0.5, luabridge::getGlobal(L, "weight").unsafe_cast<double>());
+    EXPECT_EQ(1, luabridge::getGlobal(L, "single").unsafe_cast<int>());
+    EXPECT_EQ(1, luabridge::getGlobal(L, "a").unsafe_cast<int>());
+    EXPECT_EQ(2, luabridge::getGlobal(L, "b").unsafe_cast<int>());
+    EXPECT_EQ(0, luabridge::getGlobal(L, "last").unsafe_cast<int>());
+}
+
 TEST_F(CppCoroutineTests, VoidCoroutineWithSideEffects)
 {
     // Verify multiple void co_return paths all execute correctly
@@ -930,6 +1131,86 @@ TEST_F(CppCoroutineTests, LuaCoroutineChildReturnsImmediately)
     EXPECT_EQ(42, luabridge::getGlobal(L, "immResult").unsafe_cast<int>());
 }
 
+TEST_F(CppCoroutineTests, CallAsyncPropagatesYields)
+{
+    luabridge::getGlobalNamespace(L)
+        .addCoroutine("orchestrate", [](luabridge::LuaRef fn) -> luabridge::CppCoroutine<int>
+        {
+            auto first = co_await luabridge::callAsync<int>(fn, "timer");
+            co_yield luabridge::values(std::string("between"), first ? *first : -1);
+
+            auto second = co_await luabridge::callAsync<int>(fn, "event");
+            co_return second ? *second : -1;
+        });
+
+    ASSERT_TRUE(runLua(
+        "function waitFor(name)\n"
+        "  local a = coroutine.yield('waiting', name)\n"
+        "  local b = coroutine.yield('still', name)\n"
+        "  return a + b\n"
+        "end\n"
+        "local co = coroutine.create(orchestrate)\n"
+        "local ok\n"
+        "ok, tag1, name1 = coroutine.resume(co, waitFor)\n"
+        "ok, tag2 = coroutine.resume(co, 1)\n"
+        "ok, tag3, value3 = coroutine.resume(co, 2)\n"
+        "ok, tag4, name4 = coroutine.resume(co)\n"
+        "ok, tag5 = coroutine.resume(co, 10)\n"
+        "ok, result = coroutine.resume(co, 20)\n"
+        "status = coroutine.status(co)\n"
+    ));
+
+    EXPECT_EQ("waiting", luabridge::getGlobal(L, "tag1").unsafe_cast<std::string>());
+    EXPECT_EQ("timer", luabridge::getGlobal(L, "name1").unsafe_cast<std::string>());
+    EXPECT_EQ("still", luabridge::getGlobal(L, "tag2").unsafe_cast<std::string>());
+    EXPECT_EQ("between", luabridge::getGlobal(L, "tag3").unsafe_cast<std::string>());
+    EXPECT_EQ(3, luabridge::getGlobal(L, "value3").unsafe_cast<int>());
+    EXPECT_EQ("waiting", luabridge::getGlobal(L, "tag4").unsafe_cast<std::string>());
+    EXPECT_EQ("event", luabridge::getGlobal(L, "name4").unsafe_cast<std::string>());
+    EXPECT_EQ("still", luabridge::getGlobal(L, "tag5").unsafe_cast<std::string>());
+    EXPECT_EQ(30, luabridge::getGlobal(L, "result").unsafe_cast<int>());
+    EXPECT_EQ("dead", luabridge::getGlobal(L, "status").unsafe_cast<std::string>());
+}
+
+TEST_F(CppCoroutineTests, CallAsyncReturningImmediately)
+{
+    luabridge::getGlobalNamespace(L)
+        .addCoroutine("sum", [](luabridge::LuaRef fn) -> luabridge::CppCoroutine<int>
+        {
+            auto result = co_await luabridge::callAsync<std::tuple<int, int>>(fn, 3, 4);
+            co_return result ? std::get<0>(*result) + std::get<1>(*result) : -1;
+        });
+
+    ASSERT_TRUE(runLua(
+        "result = coroutine.wrap(sum)(function(a, b) return a * 10, b * 10 end)\n"
+    ));
+
+    EXPECT_EQ(70, luabridge::getGlobal(L, "result").unsafe_cast<int>());
+}
+
+TEST_F(CppCoroutineTests, CallAsyncError)
+{
+    luabridge::getGlobalNamespace(L)
+        .addCoroutine("failing", [](luabridge::LuaRef fn) -> luabridge::CppCoroutine<int>
+        {
+            auto result = co_await luabridge::callAsync<int>(fn);
+            co_return result ? *result : -1;
+        });
+
+    ASSERT_TRUE(runLua(
+        "local co = coroutine.create(failing)\n"
+        "coroutine.resume(co, function() coroutine.yield() error('broken') end)\n"
+        "ok, result = coroutine.resume(co)\n"
+    ));
+
+#if LUABRIDGE_HAS_EXCEPTIONS
+    EXPECT_FALSE(luabridge::getGlobal(L, "ok").unsafe_cast<bool>());
+#else
+    EXPECT_TRUE(luabridge::getGlobal(L, "ok").unsafe_cast<bool>());
+    EXPECT_EQ(-1, luabridge::getGlobal(L, "result").unsafe_cast<int>());
+#endif
+}
+
 TEST_F(CppCoroutineTests, CoroutineStateCapture)
 {
     // Lambda captures mutable state; verify it persists correctly across suspensions
@@ -0,0 +1,134 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace {
+struct Buffer
+{
+    Buffer() = default;
+
+    explicit Buffer(std::size_t size)
+        : data(size)
+    {
+    }
+
+    std::vector<char> data;
+};
+
+struct Unestimated
+{
+    std::vector<char> data = std::vector<char>(4096);
+};
+
+std::size_t estimateBuffer(const Buffer& buffer)
+{
+    return buffer.data.size();
+}
+
+Buffer makeBuffer(std::size_t size)
+{
+    return Buffer(size);
+}
+} // namespace
+
+struct ExternalMemoryTests : TestBase
+{
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        luabridge::getGlobalNamespace(L)
+            .beginClass<Buffer>("Buffer")
+                .addConstructor<void (*)(std::size_t)>()
+                .setMemoryEstimator(&estimateBuffer)
+            .endClass()
+            .beginClass<Unestimated>("Unestimated")
+                .addConstructor<void (*)()>()
+            .endClass()
+            .addFunction("makeBuffer", &makeBuffer);
+    }
+};
+
+TEST_F(ExternalMemoryTests, NothingReportedWithoutObjects)
+{
+    EXPECT_EQ(0u, luabridge::getExternalMemory(L));
+}
+
+#if ! LUABRIDGE_ON_LUAU
+TEST_F(ExternalMemoryTests, ReportsConstructedObjects)
+{
+    runLua(R"(
+        a = Buffer(1000)
+        b = Buffer(24)
+    )");
+
+    EXPECT_EQ(1024u, luabridge::getExternalMemory(L));
+}
+
+TEST_F(ExternalMemoryTests, ReportsObjectsReturnedByValue)
+{
+    runLua("a = makeBuffer(2048)");
+
+    EXPECT_EQ(2048u, luabridge::getExternalMemory(L));
+
+    ASSERT_TRUE(luabridge::push(L, Buffer(512)));
+    lua_pop(L, 1);
+
+    EXPECT_EQ(2560u, luabridge::getExternalMemory(L));
+}
+#endif
+
+TEST_F(ExternalMemoryTests, IgnoresClassesWithoutEstimatorAndPointers)
+{
+    Buffer buffer(4096);
+    luabridge::setGlobal(L, &buffer, "pointer");
+    luabridge::setGlobal(L, std::make_shared<Buffer>(4096), "shared");
+
+    runLua("unestimated = Unestimated()");
+
+    EXPECT_EQ(0u, luabridge::getExternalMemory(L));
+}
+
+#if LUABRIDGE_ON_LUAU
+TEST_F(ExternalMemoryTests, EstimatesAreIgnored)
+{
+    runLua("a = Buffer(4096)");
+
+    EXPECT_EQ(0u, luabridge::getExternalMemory(L));
+}
+#else
+TEST_F(ExternalMemoryTests, ReleasesCollectedObjects)
+{
+    runLua(R"(
+        keep = Buffer(100)
+        local temporary = Buffer(5000)
+    )");
+
+    EXPECT_EQ(5100u, luabridge::getExternalMemory(L));
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    EXPECT_EQ(100u, luabridge::getExternalMemory(L));
+}
+
+TEST_F(ExternalMemoryTests, EstimatesDriveTheCollector)
+{
+    lua_gc(L, LUA_GCCOLLECT, 0);
+
+    // Without the estimates, a few kilobytes of userdata would never trigger a collection cycle
+    runLua(R"(
+        for i = 1, 2000 do
+            local buffer = Buffer(1024 * 1024)
+        end
+    )");
+
+    EXPECT_GT(std::size_t(256) * 1024 * 1024, luabridge::getExternalMemory(L));
+}
+#endif
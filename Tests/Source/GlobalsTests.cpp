@@ -0,0 +1,203 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include "LuaBridge/Vector.h"
+
+#include <string>
+#include <vector>
+
+struct GlobalsTests : TestBase
+{
+};
+
+TEST_F(GlobalsTests, HandleReadsGlobal)
+{
+    runLua("value = 42");
+
+    luabridge::GlobalHandle<int> handle(L, "value");
+    EXPECT_FALSE(handle.isCached());
+    EXPECT_EQ(L, handle.state());
+
+    const int topBefore = lua_gettop(L);
+    EXPECT_EQ(42, *handle.get());
+    EXPECT_EQ(topBefore, lua_gettop(L));
+
+    runLua("value = 43");
+    EXPECT_EQ(43, *handle.get());
+}
+
+TEST_F(GlobalsTests, HandleReadsMissingGlobal)
+{
+    luabridge::GlobalHandle<int> handle(L, "missing");
+    EXPECT_FALSE(handle.get());
+
+    luabridge::GlobalHandle<std::optional<int>> optionalHandle(L, "missing");
+    ASSERT_TRUE(optionalHandle.get());
+    EXPECT_FALSE(*optionalHandle.get());
+}
+
+TEST_F(GlobalsTests, HandleWritesGlobal)
+{
+    luabridge::GlobalHandle<std::string> handle(L, "text");
+
+    const int topBefore = lua_gettop(L);
+    EXPECT_TRUE(handle.set(std::string("hello")));
+    EXPECT_EQ(topBefore, lua_gettop(L));
+
+    runLua("result = text .. ' world'");
+    EXPECT_EQ("hello world", result<std::string>());
+    EXPECT_EQ("hello", *handle.get());
+}
+
+TEST_F(GlobalsTests, CachedHandleObservesAssignments)
+{
+    runLua("values = { 1 }");
+
+    luabridge::GlobalHandle<std::vector<int>> handle(L, "values", true);
+    ASSERT_TRUE(handle.isCached());
+
+    EXPECT_EQ(std::vector<int>({ 1 }), *handle.get());
+    EXPECT_EQ(std::vector<int>({ 1 }), *handle.get());
+
+    runLua("values = { 1, 2 }");
+    EXPECT_EQ(std::vector<int>({ 1, 2 }), *handle.get());
+
+    EXPECT_TRUE(handle.set(std::vector<int>{ 10 }));
+    EXPECT_EQ(std::vector<int>({ 10 }), *handle.get());
+
+    lua_newtable(L);
+    lua_setglobal(L, "values");
+    EXPECT_TRUE(handle.get()->empty());
+
+    runLua("result = #values");
+    EXPECT_EQ(0, result<int>());
+}
+
+TEST_F(GlobalsTests, CachedFlagIgnoredForScalars)
+{
+    runLua("number = 1 flag = true");
+
+    luabridge::GlobalHandle<int> integer(L, "number", true);
+    luabridge::GlobalHandle<double> real(L, "number", true);
+    luabridge::GlobalHandle<bool> boolean(L, "flag", true);
+    EXPECT_FALSE(integer.isCached());
+    EXPECT_FALSE(real.isCached());
+    EXPECT_FALSE(boolean.isCached());
+
+    EXPECT_EQ(1, *integer.get());
+    EXPECT_EQ(1.0, *real.get());
+    EXPECT_TRUE(*boolean.get());
+
+    luabridge::GlobalHandle<std::string> text(L, "number", true);
+    EXPECT_TRUE(text.isCached());
+}
+
+TEST_F(GlobalsTests, CachedHandleLeavesGlobalsTableUntouched)
+{
+    runLua("watched = 'a'");
+
+    luabridge::GlobalHandle<std::string> handle(L, "watched", true);
+    ASSERT_TRUE(handle.isCached());
+    EXPECT_EQ("a", *handle.get());
+
+    runLua("result = getmetatable(_G) == nil and rawget(_G, 'watched') == 'a'");
+    EXPECT_TRUE(result<bool>());
+
+    runLua(R"(
+        result = false
+        for k, v in pairs(_G) do
+            if k == 'watched' and v == 'a' then result = true end
+        end
+    )");
+    EXPECT_TRUE(result<bool>());
+
+    runLua("rawset(_G, 'watched', 'b')");
+    EXPECT_EQ("b", *handle.get());
+}
+
+TEST_F(GlobalsTests, CachedHandleTellsIntegersFromFloats)
+{
+    runLua("number = 1");
+
+    luabridge::GlobalHandle<std::string> handle(L, "number", true);
+    const std::string integer = *handle.get();
+
+    runLua("number = 1.0");
+    const std::string real = *handle.get();
+
+#if LUA_VERSION_NUM >= 503 && ! LUABRIDGE_ON_LUAU
+    EXPECT_NE(integer, real);
+#else
+    EXPECT_EQ(integer, real);
+#endif
+}
+
+TEST_F(GlobalsTests, CachedHandlesOnTheSameGlobal)
+{
+    runLua("shared = 'a'");
+
+    luabridge::GlobalHandle<std::string> first(L, "shared", true);
+    luabridge::GlobalHandle<std::string> second(L, "shared", true);
+    ASSERT_TRUE(first.isCached());
+    ASSERT_TRUE(second.isCached());
+
+    EXPECT_EQ("a", *first.get());
+    EXPECT_EQ("a", *second.get());
+
+    EXPECT_TRUE(first.set(std::string("b")));
+    EXPECT_EQ("b", *first.get());
+    EXPECT_EQ("b", *second.get());
+
+    luabridge::GlobalHandle<std::string> uncached(L, "shared");
+    EXPECT_EQ("b", *uncached.get());
+}
+
+TEST_F(GlobalsTests, CachedHandleWithGlobalsMetatable)
+{
+    runLua("setmetatable(_G, { __index = function(_, k) return 'fallback' end })");
+
+    luabridge::GlobalHandle<std::string> handle(L, "anything", true);
+    EXPECT_TRUE(handle.isCached());
+    EXPECT_EQ("fallback", *handle.get());
+
+    runLua("anything = 'one'");
+    EXPECT_EQ("one", *handle.get());
+
+    runLua(R"(
+        local values = {}
+        setmetatable(_G, {
+            __index = function(_, k) return values[k] end,
+            __newindex = function(_, k, v) values[k] = v end
+        })
+        anything = nil
+        anything = 'two'
+    )");
+    EXPECT_EQ("two", *handle.get());
+
+    EXPECT_TRUE(handle.set(std::string("three")));
+    EXPECT_EQ("three", *handle.get());
+
+    runLua("result = rawget(_G, 'anything') == nil and anything == 'three'");
+    EXPECT_TRUE(result<bool>());
+}
+
+TEST_F(GlobalsTests, HandleIsMovable)
+{
+    runLua("value = 'three'");
+
+    luabridge::GlobalHandle<std::string> handle(L, "value", true);
+    EXPECT_EQ("three", *handle.get());
+
+    luabridge::GlobalHandle<std::string> moved(std::move(handle));
+    EXPECT_EQ(nullptr, handle.state());
+    EXPECT_TRUE(moved.isCached());
+    EXPECT_EQ("three", *moved.get());
+
+    luabridge::GlobalHandle<std::string> assigned(L, "other");
+    assigned = std::move(moved);
+    runLua("value = 'four'");
+    EXPECT_EQ("four", *assigned.get());
+}
@@ -0,0 +1,187 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include "LuaBridge/UnorderedMap.h"
+#include "LuaBridge/Vector.h"
+
+#if LUABRIDGE_HAS_CXX17_MEMORY_RESOURCE
+
+#include <memory_resource>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace {
+class CountingResource : public std::pmr::memory_resource
+{
+public:
+    std::size_t allocations = 0;
+    std::size_t outstanding = 0;
+
+private:
+    void* do_allocate(std::size_t bytes, std::size_t alignment) override
+    {
+        ++allocations;
+        outstanding += bytes;
+        return std::pmr::new_delete_resource()->allocate(bytes, alignment);
+    }
+
+    void do_deallocate(void* p, std::size_t bytes, std::size_t alignment) override
+    {
+        outstanding -= bytes;
+        std::pmr::new_delete_resource()->deallocate(p, bytes, alignment);
+    }
+
+    bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override
+    {
+        return this == &other;
+    }
+};
+} // namespace
+
+struct MemoryResourceTests : TestBase
+{
+};
+
+TEST_F(MemoryResourceTests, StackRoundTrip)
+{
+    const std::pmr::string text = "a string long enough to not fit in the small buffer";
+    ASSERT_TRUE(luabridge::push(L, text));
+    EXPECT_EQ(text, *luabridge::get<std::pmr::string>(L, -1));
+    lua_pop(L, 1);
+
+    const std::pmr::vector<int> vector = { 1, 2, 3 };
+    ASSERT_TRUE(luabridge::push(L, vector));
+    EXPECT_EQ(vector, *luabridge::get<std::pmr::vector<int>>(L, -1));
+    lua_pop(L, 1);
+
+    const std::pmr::unordered_map<std::string, int> map = { { "a", 1 }, { "b", 2 } };
+    ASSERT_TRUE(luabridge::push(L, map));
+    EXPECT_EQ(map, *(luabridge::get<std::pmr::unordered_map<std::string, int>>(L, -1)));
+    lua_pop(L, 1);
+}
+
+TEST_F(MemoryResourceTests, GetIntoResource)
+{
+    CountingResource resource;
+
+    lua_pushstring(L, "a string long enough to not fit in the small buffer");
+    auto text = luabridge::Stack<std::pmr::string>::get(L, -1, &resource);
+    ASSERT_TRUE(text);
+    EXPECT_EQ(&resource, text->get_allocator().resource());
+    EXPECT_EQ(1u, resource.allocations);
+    lua_pop(L, 1);
+
+    runLua("result = { 1, 2, 3 }");
+    lua_getglobal(L, "result");
+    auto vector = luabridge::Stack<std::pmr::vector<int>>::get(L, -1, &resource);
+    ASSERT_TRUE(vector);
+    EXPECT_EQ(&resource, vector->get_allocator().resource());
+    EXPECT_EQ((std::pmr::vector<int>{ 1, 2, 3 }), *vector);
+    lua_pop(L, 1);
+}
+
+TEST_F(MemoryResourceTests, ArgumentsDecodedFromArena)
+{
+    CountingResource upstream;
+    luabridge::setArgumentsMemoryResource(L, &upstream);
+    EXPECT_EQ(&upstream, luabridge::getArgumentsMemoryResource(L));
+
+    bool fromDefaultResource = true;
+    bool valueFromDefaultResource = false;
+    std::size_t totalSize = 0;
+
+    luabridge::getGlobalNamespace(L)
+        .addFunction("concat", [&](const std::pmr::string& a, std::pmr::string b, const std::pmr::vector<int>& v) {
+            fromDefaultResource = a.get_allocator().resource() == std::pmr::get_default_resource()
+                || v.get_allocator().resource() == std::pmr::get_default_resource();
+            valueFromDefaultResource = b.get_allocator().resource() == std::pmr::get_default_resource();
+            totalSize = a.size() + b.size() + v.size();
+            return std::string(a) + std::string(b);
+        });
+
+    runLua("result = concat('hello', ' world', { 1, 2, 3 })");
+    EXPECT_EQ("hello world", result<std::string>());
+    EXPECT_FALSE(fromDefaultResource);
+    EXPECT_TRUE(valueFromDefaultResource);
+    EXPECT_EQ(14u, totalSize);
+    EXPECT_EQ(0u, upstream.allocations);
+
+    runLua("result = concat('', string.rep('x', 4096), {})");
+    EXPECT_EQ(4096u, result<std::string>().size());
+    EXPECT_EQ(0u, upstream.allocations);
+
+    runLua("result = concat(string.rep('x', 4096), '', {})");
+    EXPECT_EQ(4096u, result<std::string>().size());
+    EXPECT_LT(0u, upstream.allocations);
+    EXPECT_EQ(0u, upstream.outstanding);
+
+    luabridge::setArgumentsMemoryResource(L, nullptr);
+    EXPECT_EQ(std::pmr::get_default_resource(), luabridge::getArgumentsMemoryResource(L));
+}
+
+namespace {
+struct Named
+{
+    explicit Named(std::pmr::string n)
+        : name(std::move(n))
+    {
+    }
+
+    std::size_t size() const
+    {
+        return name.size();
+    }
+
+    std::string text() const
+    {
+        return std::string(name);
+    }
+
+    std::pmr::string name;
+};
+} // namespace
+
+TEST_F(MemoryResourceTests, ArgumentsTakenByValueOutliveTheCall)
+{
+    luabridge::getGlobalNamespace(L)
+        .beginClass<Named>("Named")
+            .addFunction("size", &Named::size)
+            .addFunction("text", &Named::text)
+        .endClass()
+        .addFunction("makeNamed", [](std::pmr::string name) { return Named(std::move(name)); });
+
+    runLua("local named = makeNamed(string.rep('x', 4000)); collectgarbage(); result = named:size()");
+    EXPECT_EQ(4000u, result<std::size_t>());
+
+    runLua("result = makeNamed(string.rep('y', 4000)):text()");
+    EXPECT_EQ(std::string(4000, 'y'), result<std::string>());
+}
+
+TEST_F(MemoryResourceTests, ArgumentsArenaReleasedOnDecodeError)
+{
+    CountingResource upstream;
+    luabridge::setArgumentsMemoryResource(L, &upstream);
+
+    luabridge::getGlobalNamespace(L)
+        .addFunction("count", [](const std::pmr::unordered_map<std::pmr::string, int>& map, int) { return map.size(); });
+
+    runLua("result = count({ a = 1, b = 2 }, 1)");
+    EXPECT_EQ(2u, result<std::size_t>());
+
+#if LUABRIDGE_HAS_EXCEPTIONS
+    EXPECT_ANY_THROW(runLua("local t = {} for i = 1, 1000 do t[string.rep('k', 64) .. i] = i end result = count(t, 'x')"));
+#else
+    EXPECT_FALSE(runLua("local t = {} for i = 1, 1000 do t[string.rep('k', 64) .. i] = i end result = count(t, 'x')"));
+#endif
+
+    EXPECT_LT(0u, upstream.allocations);
+    EXPECT_EQ(0u, upstream.outstanding);
+
+    luabridge::setArgumentsMemoryResource(L, nullptr);
+}
+
+#endif
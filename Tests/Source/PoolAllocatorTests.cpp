@@ -0,0 +1,163 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include "LuaBridge/PoolAllocator.h"
+
+#include <cstring>
+#include <string>
+
+struct PoolAllocatorTests : TestBase
+{
+};
+
+#if LUABRIDGE_ON_LUAJIT
+// LuaJIT on 64 bit targets without GC64 refuses custom allocators, and lua_newstate returns NULL
+#define SKIP_IF_NO_STATE(S) if ((S) == nullptr) GTEST_SKIP() << "custom allocators are not supported by this LuaJIT build"
+#else
+#define SKIP_IF_NO_STATE(S)
+#endif
+
+TEST_F(PoolAllocatorTests, ReusesFreedBlocksOfTheSameSizeClass)
+{
+    luabridge::PoolAllocator allocator;
+
+    void* first = allocator.reallocate(nullptr, 0, 40);
+    ASSERT_NE(nullptr, first);
+    EXPECT_EQ(40u, allocator.stats().live);
+    EXPECT_EQ(1u, allocator.stats().pooledAllocations);
+    EXPECT_EQ(luabridge::PoolAllocator::slabSize, allocator.stats().reserved);
+
+    EXPECT_EQ(nullptr, allocator.reallocate(first, 40, 0));
+    EXPECT_EQ(0u, allocator.stats().live);
+
+    void* second = allocator.reallocate(nullptr, 0, 33);
+    EXPECT_EQ(first, second);
+
+    // Growing inside the size class keeps the block
+    EXPECT_EQ(second, allocator.reallocate(second, 33, 48));
+
+    allocator.reallocate(second, 48, 0);
+}
+
+TEST_F(PoolAllocatorTests, MovesBlocksAcrossSizeClassesAndLargeBlocks)
+{
+    luabridge::PoolAllocator allocator;
+
+    auto* block = static_cast<char*>(allocator.reallocate(nullptr, 0, 16));
+    ASSERT_NE(nullptr, block);
+    std::memcpy(block, "0123456789abcde", 16);
+
+    block = static_cast<char*>(allocator.reallocate(block, 16, 300));
+    ASSERT_NE(nullptr, block);
+    EXPECT_STREQ("0123456789abcde", block);
+
+    block = static_cast<char*>(allocator.reallocate(block, 300, 4096));
+    ASSERT_NE(nullptr, block);
+    EXPECT_STREQ("0123456789abcde", block);
+    EXPECT_EQ(2u, allocator.stats().pooledAllocations);
+    EXPECT_EQ(3u, allocator.stats().allocations);
+
+    block = static_cast<char*>(allocator.reallocate(block, 4096, 64));
+    ASSERT_NE(nullptr, block);
+    EXPECT_STREQ("0123456789abcde", block);
+    EXPECT_EQ(64u, allocator.stats().live);
+    EXPECT_EQ(4096u, allocator.stats().peak);
+
+    allocator.reallocate(block, 64, 0);
+    EXPECT_EQ(0u, allocator.stats().live);
+
+    allocator.resetPeak();
+    EXPECT_EQ(0u, allocator.stats().peak);
+}
+
+TEST_F(PoolAllocatorTests, LimitRefusesGrowthOnly)
+{
+    luabridge::PoolAllocator allocator(1000);
+
+    void* block = allocator.reallocate(nullptr, 0, 800);
+    ASSERT_NE(nullptr, block);
+
+    EXPECT_EQ(nullptr, allocator.reallocate(nullptr, 0, 300));
+    EXPECT_EQ(nullptr, allocator.reallocate(block, 800, 1200));
+    EXPECT_EQ(2u, allocator.stats().failedAllocations);
+    EXPECT_EQ(800u, allocator.stats().live);
+
+    block = allocator.reallocate(block, 800, 100);
+    ASSERT_NE(nullptr, block);
+
+    allocator.setLimit(50);
+    block = allocator.reallocate(block, 100, 20);
+    EXPECT_NE(nullptr, block);
+
+    allocator.reallocate(block, 20, 0);
+    EXPECT_EQ(0u, allocator.stats().live);
+}
+
+TEST_F(PoolAllocatorTests, NewStateRunsScripts)
+{
+    lua_State* S = luabridge::newState();
+    SKIP_IF_NO_STATE(S);
+    ASSERT_NE(nullptr, S);
+
+    luabridge::PoolAllocator* allocator = luabridge::PoolAllocator::get(S);
+    ASSERT_NE(nullptr, allocator);
+    EXPECT_EQ(0u, allocator->limit());
+
+    luaL_openlibs(S);
+    const auto before = allocator->stats();
+
+    runLua(R"(
+        local t = {}
+        for i = 1, 1000 do t[i] = { value = tostring(i) } end
+        total = 0
+        for i = 1, #t do total = total + #t[i].value end
+    )", S);
+
+    lua_getglobal(S, "total");
+    EXPECT_EQ(2893, lua_tointeger(S, -1));
+    lua_pop(S, 1);
+
+    EXPECT_LT(before.pooledAllocations + 2000, allocator->stats().pooledAllocations);
+    EXPECT_LE(allocator->stats().live, allocator->stats().peak);
+    EXPECT_EQ(0u, allocator->stats().failedAllocations);
+
+    luabridge::closeState(S);
+
+    EXPECT_EQ(nullptr, luabridge::PoolAllocator::get(L));
+}
+
+TEST_F(PoolAllocatorTests, MemoryLimitRaisesLuaErrors)
+{
+    luabridge::StateOptions options;
+    options.memoryLimit = 512 * 1024;
+
+    lua_State* S = luabridge::newState(options);
+    SKIP_IF_NO_STATE(S);
+    ASSERT_NE(nullptr, S);
+
+    luaL_openlibs(S);
+
+    runLua(R"(
+        ok = pcall(function()
+            local t = {}
+            for i = 1, 1000000 do t[i] = { i } end
+        end)
+        collectgarbage("collect")
+        after = #tostring(12345)
+    )", S);
+
+    lua_getglobal(S, "ok");
+    EXPECT_FALSE(lua_toboolean(S, -1));
+    lua_getglobal(S, "after");
+    EXPECT_EQ(5, lua_tointeger(S, -1));
+    lua_pop(S, 2);
+
+    const auto& stats = luabridge::PoolAllocator::get(S)->stats();
+    EXPECT_LT(0u, stats.failedAllocations);
+    EXPECT_GE(options.memoryLimit, stats.peak);
+
+    luabridge::closeState(S);
+}
@@ -0,0 +1,209 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include "LuaBridge/Profiler.h"
+
+#if ! LUABRIDGE_ON_LUAU
+
+#include <chrono>
+#include <sstream>
+#include <string>
+
+namespace {
+void profilerTestHook(lua_State*, lua_Debug*)
+{
+}
+
+#if LUABRIDGE_ENABLE_PROFILING
+void profilerSpin()
+{
+    const auto end = std::chrono::steady_clock::now() + std::chrono::milliseconds(5);
+    while (std::chrono::steady_clock::now() < end)
+    {
+    }
+}
+
+bool endsWith(const std::string& text, const std::string& suffix)
+{
+    return text.size() >= suffix.size() && text.compare(text.size() - suffix.size(), suffix.size(), suffix) == 0;
+}
+#endif
+} // namespace
+
+struct ProfilerTests : TestBase
+{
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+#if LUABRIDGE_ON_LUAJIT
+        runLua("jit.off()");
+#endif
+
+        runLua(R"(
+            function busy(n)
+                local x = 0
+                for i = 1, n do x = x + i % 7 end
+                return x
+            end
+        )");
+    }
+};
+
+TEST_F(ProfilerTests, StartAndStopRestoreTheHook)
+{
+    lua_sethook(L, &profilerTestHook, LUA_MASKLINE, 0);
+
+    luabridge::Profiler profiler(L);
+    EXPECT_FALSE(profiler.isRunning());
+    EXPECT_EQ(nullptr, luabridge::Profiler::get(L));
+
+    EXPECT_TRUE(profiler.start());
+    EXPECT_TRUE(profiler.isRunning());
+    EXPECT_EQ(&profiler, luabridge::Profiler::get(L));
+    EXPECT_NE(&profilerTestHook, lua_gethook(L));
+
+    luabridge::Profiler other(L);
+    EXPECT_FALSE(other.start());
+    EXPECT_FALSE(other.isRunning());
+
+    profiler.stop();
+    EXPECT_FALSE(profiler.isRunning());
+    EXPECT_EQ(nullptr, luabridge::Profiler::get(L));
+    EXPECT_EQ(&profilerTestHook, lua_gethook(L));
+    EXPECT_EQ(LUA_MASKLINE, lua_gethookmask(L));
+
+    EXPECT_TRUE(other.start());
+}
+
+TEST_F(ProfilerTests, SamplesLuaStacks)
+{
+    luabridge::Profiler profiler(L, std::chrono::microseconds(1), 100);
+    ASSERT_TRUE(profiler.start());
+
+    runLua(R"(
+        function outer() local x = busy(200000) return x end
+        result = outer()
+    )");
+
+    profiler.stop();
+
+    ASSERT_LT(0u, profiler.sampleCount());
+
+    bool found = false;
+    for (const auto& [stack, count] : profiler.samples())
+    {
+        EXPECT_LT(0u, count);
+        EXPECT_EQ(0u, stack.find("main chunk ("));
+
+        if (stack.find(";outer (") != std::string::npos && stack.find(";busy (") != std::string::npos)
+            found = true;
+    }
+
+    EXPECT_TRUE(found);
+
+    profiler.reset();
+    EXPECT_EQ(0u, profiler.sampleCount());
+    EXPECT_TRUE(profiler.samples().empty());
+}
+
+TEST_F(ProfilerTests, StoppedProfilerDoesNotSample)
+{
+    luabridge::Profiler profiler(L, std::chrono::microseconds(1), 100);
+    ASSERT_TRUE(profiler.start());
+    profiler.stop();
+
+    runLua("result = busy(100000)");
+
+    EXPECT_EQ(0u, profiler.sampleCount());
+}
+
+TEST_F(ProfilerTests, CoroutinesOutlivingTheProfilerDropTheHook)
+{
+    {
+        luabridge::Profiler profiler(L, std::chrono::microseconds(1), 100);
+        ASSERT_TRUE(profiler.start());
+
+        runLua(R"(
+            co = coroutine.create(function()
+                coroutine.yield()
+                result = busy(100000)
+            end)
+            coroutine.resume(co)
+        )");
+    }
+
+    runLua("coroutine.resume(co)");
+    EXPECT_EQ(300000, result<int>());
+
+    lua_getglobal(L, "co");
+    lua_State* co = lua_tothread(L, -1);
+    ASSERT_NE(nullptr, co);
+    EXPECT_EQ(nullptr, lua_gethook(co));
+    lua_pop(L, 1);
+}
+
+TEST_F(ProfilerTests, WritesFoldedStacks)
+{
+    luabridge::Profiler profiler(L, std::chrono::microseconds(1), 100);
+    ASSERT_TRUE(profiler.start());
+
+    runLua("result = busy(200000)");
+
+    profiler.stop();
+
+    std::istringstream stream(profiler.folded());
+    std::uint64_t total = 0;
+    std::string line;
+    while (std::getline(stream, line))
+    {
+        const auto separator = line.rfind(' ');
+        ASSERT_NE(std::string::npos, separator);
+
+        const auto stack = line.substr(0, separator);
+        ASSERT_EQ(1u, profiler.samples().count(stack));
+        EXPECT_EQ(profiler.samples().at(stack), std::stoull(line.substr(separator + 1)));
+
+        total += std::stoull(line.substr(separator + 1));
+    }
+
+    EXPECT_EQ(profiler.sampleCount(), total);
+}
+
+#if LUABRIDGE_ENABLE_PROFILING
+TEST_F(ProfilerTests, AttributesTimeToBindings)
+{
+    luabridge::getGlobalNamespace(L)
+        .beginNamespace("profiler")
+            .addFunction("spin", &profilerSpin)
+        .endNamespace();
+
+    luabridge::Profiler profiler(L, std::chrono::microseconds(100), 1000000);
+    ASSERT_TRUE(profiler.start());
+
+    runLua(R"(
+        function caller() profiler.spin() end
+        caller()
+    )");
+
+    profiler.stop();
+
+    std::uint64_t spinSamples = 0;
+    for (const auto& [stack, count] : profiler.samples())
+    {
+        if (endsWith(stack, ";spin"))
+        {
+            EXPECT_NE(std::string::npos, stack.find(";caller ("));
+            spinSamples += count;
+        }
+    }
+
+    // The binding runs for 5 milliseconds, sampled every 100 microseconds
+    EXPECT_LE(40u, spinSamples);
+}
+#endif
+
+#endif // ! LUABRIDGE_ON_LUAU
@@ -0,0 +1,197 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#if LUABRIDGE_ENABLE_PROFILING
+
+#include <optional>
+#include <sstream>
+#include <string>
+
+namespace {
+struct ProfiledCounter
+{
+    ProfiledCounter() = default;
+    explicit ProfiledCounter(int value) : value(value) {}
+
+    int add(int amount) { value += amount; return value; }
+    int addTwice(int amount) { return add(amount) + add(amount); }
+    int get() const { return value; }
+
+    static int twice(int x) { return x * 2; }
+
+    int value = 0;
+};
+
+int profiledFree(int x)
+{
+    return x + 1;
+}
+
+int profiledVariadic(lua_State* L)
+{
+    const int arguments = lua_gettop(L);
+    for (int i = 1; i <= arguments; ++i)
+        lua_pushvalue(L, i);
+
+    lua_pushinteger(L, arguments);
+    return arguments + 1;
+}
+
+std::optional<luabridge::BindingProfile> findProfile(const char* className, const char* name, luabridge::BindingKind kind = luabridge::BindingKind::Function)
+{
+    for (auto& profile : luabridge::getBindingProfiles())
+    {
+        if (profile.className == className && profile.name == name && profile.kind == kind)
+            return profile;
+    }
+
+    return std::nullopt;
+}
+} // namespace
+
+struct ProfilingTests : TestBase
+{
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        luabridge::getGlobalNamespace(L)
+            .beginNamespace("profiling")
+                .addFunction("free", &profiledFree)
+                .addFunction("overloaded", [](int x) { return x; }, [](const char* s) { return std::string(s); })
+                .beginClass<ProfiledCounter>("ProfiledCounter")
+                    .addConstructor<void (*)(), void (*)(int)>()
+                    .addFunction("add", &ProfiledCounter::add)
+                    .addFunction("addTwice", &ProfiledCounter::addTwice)
+                    .addFunction("get", &ProfiledCounter::get)
+                    .addStaticFunction("twice", &ProfiledCounter::twice)
+                    .addProperty("value", &ProfiledCounter::value, &ProfiledCounter::value)
+                .endClass()
+            .endNamespace();
+
+        luabridge::resetBindingProfiles();
+    }
+};
+
+TEST_F(ProfilingTests, CountsCalls)
+{
+    runLua(R"(
+        local counter = profiling.ProfiledCounter(1)
+        for i = 1, 10 do counter:add(i) end
+        result = counter:get() + profiling.free(1) + profiling.ProfiledCounter.twice(2)
+    )");
+
+    EXPECT_EQ(56 + 2 + 4, result<int>());
+
+    auto add = findProfile("ProfiledCounter", "add");
+    ASSERT_TRUE(add);
+    EXPECT_EQ(10u, add->calls);
+    EXPECT_EQ(10u, add->timedCalls);
+
+    auto histogramCalls = std::uint64_t(0);
+    for (auto count : add->histogram)
+        histogramCalls += count;
+
+    EXPECT_EQ(10u, histogramCalls);
+    EXPECT_LE(add->averageTime(), add->totalTime);
+    EXPECT_LE(add->percentile(0.5), add->percentile(0.99));
+
+    EXPECT_EQ(1u, findProfile("ProfiledCounter", "get")->calls);
+    EXPECT_EQ(1u, findProfile("ProfiledCounter", "twice")->calls);
+    EXPECT_EQ(1u, findProfile("", "free")->calls);
+    EXPECT_EQ(1u, findProfile("ProfiledCounter", "ProfiledCounter", luabridge::BindingKind::Constructor)->calls);
+    EXPECT_EQ(0u, findProfile("ProfiledCounter", "addTwice")->calls);
+}
+
+TEST_F(ProfilingTests, PropertiesAndOverloads)
+{
+    runLua(R"(
+        local counter = profiling.ProfiledCounter()
+        counter.value = 5
+        counter.value = counter.value + 1
+        result = profiling.overloaded(1) .. profiling.overloaded("a") .. counter.value
+    )");
+
+    EXPECT_EQ("1a6", result<std::string>());
+
+    EXPECT_EQ(2u, findProfile("ProfiledCounter", "value", luabridge::BindingKind::Getter)->calls);
+    EXPECT_EQ(2u, findProfile("ProfiledCounter", "value", luabridge::BindingKind::Setter)->calls);
+    EXPECT_EQ(2u, findProfile("", "overloaded")->calls);
+}
+
+TEST_F(ProfilingTests, ArgumentsAndResultsArePreserved)
+{
+    luabridge::getGlobalNamespace(L)
+        .addFunction("profiledVariadic", &profiledVariadic);
+
+    runLua(R"(
+        local a, b, c, n = profiledVariadic('x', nil, 3)
+        result = tostring(a) .. tostring(b) .. tostring(c) .. tostring(n) .. select('#', profiledVariadic())
+    )");
+
+    EXPECT_EQ("xnil331", result<std::string>());
+    EXPECT_EQ(2u, findProfile("", "profiledVariadic")->calls);
+}
+
+TEST_F(ProfilingTests, ErrorsAreCountedButNotTimed)
+{
+    runLua("ok = pcall(function() local counter = profiling.ProfiledCounter(); counter:add('not a number') end)");
+    EXPECT_FALSE(luabridge::getGlobal(L, "ok").unsafe_cast<bool>());
+
+    auto add = findProfile("ProfiledCounter", "add");
+    ASSERT_TRUE(add);
+    EXPECT_EQ(1u, add->calls);
+    EXPECT_EQ(0u, add->timedCalls);
+}
+
+TEST_F(ProfilingTests, SharedAcrossStates)
+{
+    lua_State* other = createNewLuaState();
+
+    luabridge::getGlobalNamespace(other)
+        .beginNamespace("profiling")
+            .addFunction("free", &profiledFree)
+        .endNamespace();
+
+    ASSERT_TRUE(runLua("profiling.free(1) profiling.free(2)", other));
+    ASSERT_TRUE(runLua("profiling.free(3)"));
+
+    lua_close(other);
+
+    EXPECT_EQ(3u, findProfile("", "free")->calls);
+}
+
+TEST_F(ProfilingTests, TopBindings)
+{
+    runLua(R"(
+        local counter = profiling.ProfiledCounter()
+        for i = 1, 5 do counter:add(i) end
+        for i = 1, 3 do counter:get() end
+    )");
+
+    auto top = luabridge::getTopBindingProfiles(2, luabridge::BindingProfileOrder::Calls);
+    ASSERT_EQ(2u, top.size());
+    EXPECT_EQ("add", top[0].name);
+    EXPECT_EQ(5u, top[0].calls);
+    EXPECT_EQ("get", top[1].name);
+    EXPECT_EQ(3u, top[1].calls);
+
+    // Bindings never called are not reported
+    EXPECT_EQ(3u, luabridge::getTopBindingProfiles(100).size());
+
+    std::ostringstream stream;
+    luabridge::dumpTopBindingProfiles(stream, 2, luabridge::BindingProfileOrder::Calls);
+
+    const auto dump = stream.str();
+    EXPECT_NE(std::string::npos, dump.find("ProfiledCounter.add"));
+    EXPECT_NE(std::string::npos, dump.find("ProfiledCounter.get"));
+    EXPECT_EQ(std::string::npos, dump.find("ProfiledCounter.ProfiledCounter (constructor)"));
+
+    luabridge::resetBindingProfiles();
+    EXPECT_TRUE(luabridge::getTopBindingProfiles(100).empty());
+}
+
+#endif // LUABRIDGE_ENABLE_PROFILING
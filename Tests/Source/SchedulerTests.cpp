@@ -0,0 +1,318 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include "LuaBridge/Scheduler.h"
+
+#include <string>
+#include <thread>
+#include <vector>
+
+struct SchedulerTests : TestBase
+{
+};
+
+TEST_F(SchedulerTests, SpawnedThreadsRunInOrder)
+{
+    luabridge::Scheduler scheduler(L);
+    scheduler.registerFunctions();
+
+    runLua(R"(
+        order = {}
+        function task(name)
+            table.insert(order, name)
+            coroutine.yield()
+            table.insert(order, name)
+        end
+    )");
+
+    scheduler.spawn(luabridge::getGlobal(L, "task"), "a");
+    scheduler.spawn(luabridge::getGlobal(L, "task"), "b");
+    EXPECT_EQ(2u, scheduler.size());
+    EXPECT_EQ(2u, scheduler.stats().ready);
+
+    EXPECT_EQ(2u, scheduler.tick(0.0));
+    EXPECT_EQ(2u, scheduler.size());
+
+    EXPECT_EQ(2u, scheduler.tick(0.0));
+    EXPECT_EQ(0u, scheduler.size());
+    EXPECT_EQ(2u, scheduler.stats().finished);
+
+    const auto order = luabridge::getGlobal(L, "order");
+    EXPECT_EQ("a", order[1].unsafe_cast<std::string>());
+    EXPECT_EQ("b", order[2].unsafe_cast<std::string>());
+    EXPECT_EQ("a", order[3].unsafe_cast<std::string>());
+    EXPECT_EQ("b", order[4].unsafe_cast<std::string>());
+}
+
+TEST_F(SchedulerTests, SleepWaitsForDeadline)
+{
+    luabridge::Scheduler scheduler(L, 0.125);
+    scheduler.registerFunctions();
+
+    runLua(R"(
+        woken = 0
+        function task()
+            scheduler.sleep(0.5)
+            woken = woken + 1
+            scheduler.sleep(100)
+            woken = woken + 1
+        end
+    )");
+
+    scheduler.spawn(luabridge::getGlobal(L, "task"));
+
+    scheduler.tick(0.0);
+    EXPECT_EQ(1u, scheduler.stats().sleeping);
+
+    scheduler.tick(0.25);
+    EXPECT_EQ(0, luabridge::getGlobal(L, "woken").unsafe_cast<int>());
+    EXPECT_EQ(0u, scheduler.stats().resumes);
+
+    scheduler.tick(0.25);
+    EXPECT_EQ(1, luabridge::getGlobal(L, "woken").unsafe_cast<int>());
+    EXPECT_EQ(1u, scheduler.stats().sleeping);
+
+    // Deadline further than a wheel revolution
+    scheduler.tick(50.0);
+    EXPECT_EQ(1, luabridge::getGlobal(L, "woken").unsafe_cast<int>());
+
+    scheduler.tick(50.0);
+    EXPECT_EQ(2, luabridge::getGlobal(L, "woken").unsafe_cast<int>());
+    EXPECT_EQ(0u, scheduler.size());
+    EXPECT_DOUBLE_EQ(100.5, scheduler.now());
+}
+
+TEST_F(SchedulerTests, WaitReturnsSignalValues)
+{
+    luabridge::Scheduler scheduler(L);
+    scheduler.registerFunctions();
+
+    runLua(R"(
+        received = {}
+        function task()
+            local a, b = scheduler.wait("event")
+            table.insert(received, a + b)
+        end
+        function signaller()
+            woken = scheduler.signal("event", 10, 20)
+        end
+    )");
+
+    scheduler.spawn(luabridge::getGlobal(L, "task"));
+    scheduler.spawn(luabridge::getGlobal(L, "task"));
+    scheduler.tick(0.0);
+    EXPECT_EQ(2u, scheduler.stats().waiting);
+
+    EXPECT_EQ(0u, scheduler.signal(luabridge::LuaRef(L, "other")));
+
+    scheduler.spawn(luabridge::getGlobal(L, "signaller"));
+    scheduler.tick(0.0);
+    EXPECT_EQ(2, luabridge::getGlobal(L, "woken").unsafe_cast<int>());
+    EXPECT_EQ(0u, scheduler.stats().waiting);
+    EXPECT_EQ(2u, scheduler.stats().ready);
+
+    scheduler.tick(0.0);
+    EXPECT_EQ(0u, scheduler.size());
+
+    const auto received = luabridge::getGlobal(L, "received");
+    EXPECT_EQ(30, received[1].unsafe_cast<int>());
+    EXPECT_EQ(30, received[2].unsafe_cast<int>());
+}
+
+TEST_F(SchedulerTests, SignalFromCpp)
+{
+    luabridge::Scheduler scheduler(L);
+    scheduler.registerFunctions();
+
+    runLua(R"(
+        event = {}
+        function task()
+            result = scheduler.wait(event)
+        end
+    )");
+
+    scheduler.spawn(luabridge::getGlobal(L, "task"));
+    scheduler.tick(0.0);
+
+    EXPECT_EQ(1u, scheduler.signal(luabridge::getGlobal(L, "event"), "hello"));
+    EXPECT_EQ(0u, scheduler.signal(luabridge::getGlobal(L, "event"), "again"));
+
+    scheduler.tick(0.0);
+    EXPECT_EQ("hello", luabridge::getGlobal(L, "result").unsafe_cast<std::string>());
+}
+
+TEST_F(SchedulerTests, SpawnFromLua)
+{
+    luabridge::Scheduler scheduler(L);
+    scheduler.registerFunctions();
+
+    runLua(R"(
+        total = 0
+        function parent()
+            for i = 1, 3 do
+                scheduler.spawn(function(x) total = total + x end, i)
+            end
+        end
+    )");
+
+    scheduler.spawn(luabridge::getGlobal(L, "parent"));
+    EXPECT_EQ(1u, scheduler.tick(0.0));
+    EXPECT_EQ(3u, scheduler.stats().ready);
+
+    EXPECT_EQ(3u, scheduler.tick(0.0));
+    EXPECT_EQ(6, luabridge::getGlobal(L, "total").unsafe_cast<int>());
+}
+
+TEST_F(SchedulerTests, ThreadsSpawnedFromLuaAreNotRecycled)
+{
+    luabridge::Scheduler scheduler(L);
+    scheduler.registerFunctions();
+
+    runLua(R"(
+        function parent()
+            child = scheduler.spawn(function() end)
+        end
+    )");
+
+    scheduler.spawn(luabridge::getGlobal(L, "parent"));
+    EXPECT_EQ(1u, scheduler.tick(0.0));
+    EXPECT_EQ(1u, scheduler.tick(0.0));
+    EXPECT_EQ(0u, scheduler.size());
+
+    lua_getglobal(L, "child");
+    lua_State* child = lua_tothread(L, -1);
+    lua_pop(L, 1);
+    ASSERT_NE(nullptr, child);
+
+    EXPECT_NE(child, scheduler.spawn(luabridge::getGlobal(L, "parent")));
+    EXPECT_NE(child, scheduler.spawn(luabridge::getGlobal(L, "parent")));
+}
+
+TEST_F(SchedulerTests, SignalPayloadOutlivesSignallingThread)
+{
+    luabridge::Scheduler scheduler(L);
+    scheduler.registerFunctions();
+
+    runLua(R"(
+        function waiter()
+            local payload = scheduler.wait("event")
+            result = payload.value
+        end
+        function parent()
+            scheduler.spawn(function() scheduler.signal("event", { value = 42 }) end)
+        end
+    )");
+
+    scheduler.spawn(luabridge::getGlobal(L, "waiter"));
+    scheduler.spawn(luabridge::getGlobal(L, "parent"));
+    EXPECT_EQ(2u, scheduler.tick(0.0));
+    EXPECT_EQ(1u, scheduler.tick(0.0));
+    EXPECT_EQ(1u, scheduler.stats().ready);
+
+    runLua("collectgarbage()");
+
+    EXPECT_EQ(1u, scheduler.tick(0.0));
+    EXPECT_EQ(0u, scheduler.size());
+    EXPECT_EQ(42, luabridge::getGlobal(L, "result").unsafe_cast<int>());
+}
+
+TEST_F(SchedulerTests, ErrorsAreReported)
+{
+    luabridge::Scheduler scheduler(L);
+    scheduler.registerFunctions();
+
+    std::vector<std::string> messages;
+    scheduler.setErrorHandler([&messages](lua_State*, std::string_view message) { messages.emplace_back(message); });
+
+    runLua(R"(
+        function task()
+            error("failure", 0)
+        end
+    )");
+
+    scheduler.spawn(luabridge::getGlobal(L, "task"));
+    scheduler.tick(0.0);
+
+    EXPECT_EQ(1u, scheduler.stats().errors);
+    EXPECT_EQ(1u, scheduler.stats().finished);
+    EXPECT_EQ(0u, scheduler.size());
+    ASSERT_EQ(1u, messages.size());
+    EXPECT_EQ("failure", messages[0]);
+}
+
+TEST_F(SchedulerTests, SleepOutsideSchedulerFails)
+{
+    luabridge::Scheduler scheduler(L);
+    scheduler.registerFunctions();
+
+    {
+        auto [result, error] = runLuaCaptureError("scheduler.sleep(1)");
+        EXPECT_FALSE(result);
+        EXPECT_NE(std::string::npos, error.find("sleep must be called from a thread run by the scheduler"));
+    }
+
+    {
+        auto [result, error] = runLuaCaptureError("coroutine.wrap(function() scheduler.wait('x') end)()");
+        EXPECT_FALSE(result);
+        EXPECT_NE(std::string::npos, error.find("wait must be called from a thread run by the scheduler"));
+    }
+}
+
+TEST_F(SchedulerTests, TickBudgetLimitsResumes)
+{
+    luabridge::Scheduler scheduler(L);
+    scheduler.registerFunctions();
+
+    luabridge::getGlobalNamespace(L)
+        .addFunction("work", [] { std::this_thread::sleep_for(std::chrono::milliseconds(2)); });
+
+    runLua(R"(
+        function task()
+            work()
+        end
+    )");
+
+    for (int i = 0; i < 10; ++i)
+        scheduler.spawn(luabridge::getGlobal(L, "task"));
+
+    scheduler.setTickBudget(std::chrono::microseconds(100));
+
+    EXPECT_EQ(1u, scheduler.tick(0.0));
+    EXPECT_EQ(9u, scheduler.stats().ready);
+
+    scheduler.setTickBudget(luabridge::Scheduler::Clock::duration::zero());
+
+    EXPECT_EQ(9u, scheduler.tick(0.0));
+    EXPECT_EQ(0u, scheduler.size());
+}
+
+TEST_F(SchedulerTests, ManyThreads)
+{
+    luabridge::Scheduler scheduler(L, 0.125);
+    scheduler.registerFunctions();
+
+    runLua(R"(
+        done = 0
+        function task(i)
+            scheduler.sleep((i % 4) * 0.25)
+            scheduler.wait("go")
+            done = done + 1
+        end
+    )");
+
+    for (int i = 0; i < 1000; ++i)
+        scheduler.spawn(luabridge::getGlobal(L, "task"), i);
+
+    scheduler.tick(0.0);
+    scheduler.tick(1.0);
+    scheduler.tick(0.0);
+    EXPECT_EQ(1000u, scheduler.stats().waiting);
+
+    EXPECT_EQ(1000u, scheduler.signal(luabridge::LuaRef(L, "go")));
+    scheduler.tick(0.0);
+    EXPECT_EQ(1000, luabridge::getGlobal(L, "done").unsafe_cast<int>());
+    EXPECT_EQ(0u, scheduler.size());
+}
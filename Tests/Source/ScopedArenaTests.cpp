@@ -0,0 +1,209 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include <stdexcept>
+#include <string>
+
+namespace {
+int arenaObjectsAlive = 0;
+
+struct ArenaObject
+{
+    explicit ArenaObject(int value = 0)
+        : value(value)
+    {
+#if LUABRIDGE_HAS_EXCEPTIONS
+        if (value < 0)
+            throw std::invalid_argument("negative value");
+#endif
+
+        ++arenaObjectsAlive;
+    }
+
+    ArenaObject(const ArenaObject& other)
+        : value(other.value)
+    {
+        ++arenaObjectsAlive;
+    }
+
+    ~ArenaObject()
+    {
+        --arenaObjectsAlive;
+    }
+
+    int value;
+};
+
+struct HeapObject
+{
+    int value = 7;
+};
+
+ArenaObject makeArenaObject(int value)
+{
+    return ArenaObject(value);
+}
+
+int readArenaObject(const ArenaObject* object)
+{
+    return object->value;
+}
+} // namespace
+
+struct ScopedArenaTests : TestBase
+{
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        arenaObjectsAlive = 0;
+
+        luabridge::getGlobalNamespace(L)
+            .beginClass<ArenaObject>("ArenaObject", luabridge::arenaAllocated)
+                .addConstructor<void (*)(int)>()
+                .addProperty("value", &ArenaObject::value)
+            .endClass()
+            .beginClass<HeapObject>("HeapObject")
+                .addConstructor<void (*)()>()
+                .addProperty("value", &HeapObject::value)
+            .endClass()
+            .addFunction("makeArenaObject", &makeArenaObject)
+            .addFunction("readArenaObject", &readArenaObject);
+    }
+};
+
+TEST_F(ScopedArenaTests, ObjectsAreDestroyedWithTheArena)
+{
+    {
+        luabridge::ScopedArena arena(L);
+        EXPECT_EQ(&arena, luabridge::ScopedArena::current(L));
+
+        runLua(R"(
+            kept = ArenaObject(1)
+            returned = makeArenaObject(2)
+            for i = 1, 10 do local temporary = ArenaObject(i) end
+            result = kept.value + returned.value + readArenaObject(kept)
+        )");
+
+        EXPECT_EQ(4, result<int>());
+        EXPECT_EQ(12u, arena.objectCount());
+        EXPECT_LT(0u, arena.reservedBytes());
+        EXPECT_EQ(12, arenaObjectsAlive);
+    }
+
+    EXPECT_EQ(0, arenaObjectsAlive);
+    EXPECT_EQ(nullptr, luabridge::ScopedArena::current(L));
+
+    lua_gc(L, LUA_GCCOLLECT, 0);
+    EXPECT_EQ(0, arenaObjectsAlive);
+}
+
+TEST_F(ScopedArenaTests, DeadObjectsRaiseErrors)
+{
+    {
+        luabridge::ScopedArena arena(L);
+        runLua("kept = ArenaObject(1)");
+    }
+
+#if LUABRIDGE_HAS_EXCEPTIONS
+    EXPECT_ANY_THROW(runLua("result = kept.value"));
+    EXPECT_ANY_THROW(runLua("kept.value = 2"));
+    EXPECT_ANY_THROW(runLua("result = readArenaObject(kept)"));
+#else
+    EXPECT_FALSE(runLua("result = kept.value"));
+    EXPECT_FALSE(runLua("kept.value = 2"));
+    EXPECT_FALSE(runLua("result = readArenaObject(kept)"));
+#endif
+
+    runLua("result = tostring(kept)");
+    EXPECT_EQ(0u, result<std::string>().find("destroyed object"));
+
+    lua_getglobal(L, "kept");
+    EXPECT_FALSE(luabridge::Stack<ArenaObject*>::isInstance(L, -1));
+    lua_pop(L, 1);
+}
+
+TEST_F(ScopedArenaTests, OnlyOptedInClassesUseTheArena)
+{
+    {
+        luabridge::ScopedArena arena(L);
+        runLua("heap = HeapObject()");
+
+        EXPECT_EQ(0u, arena.objectCount());
+    }
+
+    runLua("result = heap.value");
+    EXPECT_EQ(7, result<int>());
+}
+
+TEST_F(ScopedArenaTests, WithoutArenaObjectsAreStoredInTheirUserdata)
+{
+    runLua("kept = ArenaObject(3)");
+
+    {
+        luabridge::ScopedArena arena(L);
+    }
+
+    runLua("result = kept.value");
+    EXPECT_EQ(3, result<int>());
+    EXPECT_EQ(1, arenaObjectsAlive);
+}
+
+TEST_F(ScopedArenaTests, NestedArenas)
+{
+    luabridge::ScopedArena outer(L);
+    runLua("outer = ArenaObject(1)");
+
+    {
+        luabridge::ScopedArena inner(L);
+        runLua("inner = ArenaObject(2)");
+
+        EXPECT_EQ(1u, outer.objectCount());
+        EXPECT_EQ(1u, inner.objectCount());
+        EXPECT_EQ(2, arenaObjectsAlive);
+    }
+
+    EXPECT_EQ(&outer, luabridge::ScopedArena::current(L));
+    EXPECT_EQ(1, arenaObjectsAlive);
+
+    runLua("result = outer.value");
+    EXPECT_EQ(1, result<int>());
+}
+
+TEST_F(ScopedArenaTests, CollectedUserdataKeepTheirObjectUntilTheArenaEnds)
+{
+    {
+        luabridge::ScopedArena arena(L, 256);
+
+        runLua("for i = 1, 100 do local temporary = ArenaObject(i) end");
+        lua_gc(L, LUA_GCCOLLECT, 0);
+        lua_gc(L, LUA_GCCOLLECT, 0);
+
+        EXPECT_EQ(100, arenaObjectsAlive);
+        EXPECT_EQ(100u, arena.objectCount());
+    }
+
+    EXPECT_EQ(0, arenaObjectsAlive);
+}
+
+#if LUABRIDGE_HAS_EXCEPTIONS
+TEST_F(ScopedArenaTests, ThrowingConstructorsLeaveNoObject)
+{
+    {
+        luabridge::ScopedArena arena(L);
+
+        runLua(R"(
+            result = pcall(ArenaObject, -1)
+            collectgarbage("collect")
+        )");
+
+        EXPECT_FALSE(result<bool>());
+        EXPECT_EQ(0, arenaObjectsAlive);
+    }
+
+    EXPECT_EQ(0, arenaObjectsAlive);
+}
+#endif
@@ -132,6 +132,18 @@ TEST_F(SetTests, LuaRef)
 #endif
 }
 
+TEST_F(SetTests, PushAsSequence)
+{
+    const std::set<int> value{ 10, 20, 30 };
+    ASSERT_TRUE(luabridge::push(L, value));
+    lua_setglobal(L, "result");
+
+    runLua("local sum = 0 "
+           "for i, v in ipairs(result) do sum = sum + i * v end "
+           "result = #result * 1000 + sum");
+    EXPECT_EQ(3 * 1000 + 10 * 1 + 20 * 2 + 30 * 3, result<int>());
+}
+
 TEST_F(SetTests, CastToSet)
 {
     using StringSet = std::set<std::string>;
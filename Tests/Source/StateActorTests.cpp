@@ -0,0 +1,201 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include "LuaBridge/StateActor.h"
+
+#include <atomic>
+#include <chrono>
+#include <future>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+struct Vec2
+{
+    double x = 0.0;
+    double y = 0.0;
+};
+} // namespace
+
+struct StateActorTests : TestBase
+{
+};
+
+TEST_F(StateActorTests, JobsRunOnDrainInOrder)
+{
+    luabridge::StateActor actor(L);
+
+    std::vector<int> order;
+    for (int i = 0; i < 5; ++i)
+        actor.post([&order, i](lua_State*) { order.push_back(i); });
+
+    EXPECT_EQ(5u, actor.size());
+    EXPECT_TRUE(order.empty());
+
+    EXPECT_EQ(5u, actor.drain());
+    EXPECT_EQ((std::vector<int>{ 0, 1, 2, 3, 4 }), order);
+    EXPECT_EQ(0u, actor.size());
+    EXPECT_EQ(0u, actor.drain());
+}
+
+TEST_F(StateActorTests, DrainInBatches)
+{
+    luabridge::StateActor actor(L);
+
+    int runs = 0;
+    for (int i = 0; i < 10; ++i)
+        actor.post([&runs](lua_State*) { ++runs; });
+
+    EXPECT_EQ(4u, actor.drain(4));
+    EXPECT_EQ(4, runs);
+    EXPECT_EQ(6u, actor.size());
+
+    EXPECT_EQ(6u, actor.drain(100));
+    EXPECT_EQ(10, runs);
+}
+
+TEST_F(StateActorTests, JobsPostedWhileDraining)
+{
+    luabridge::StateActor actor(L);
+
+    int runs = 0;
+    actor.post([&](lua_State*)
+    {
+        ++runs;
+        actor.post([&runs](lua_State*) { ++runs; });
+    });
+
+    EXPECT_EQ(2u, actor.drain());
+    EXPECT_EQ(2, runs);
+}
+
+TEST_F(StateActorTests, StackIsRestored)
+{
+    luabridge::StateActor actor(L);
+
+    const int top = lua_gettop(L);
+    actor.post([](lua_State* L) { lua_pushinteger(L, 1); lua_newtable(L); });
+    actor.drain();
+
+    EXPECT_EQ(top, lua_gettop(L));
+}
+
+TEST_F(StateActorTests, SubmitAndCall)
+{
+    luabridge::getGlobalNamespace(L)
+        .beginClass<Vec2>("Vec2")
+            .addProperty("x", &Vec2::x)
+            .addProperty("y", &Vec2::y)
+        .endClass();
+
+    runLua(R"(
+        function square(x) return x * x end
+        function length2(v) return v.x * v.x + v.y * v.y end
+    )");
+
+    luabridge::StateActor actor(L);
+
+    auto state = actor.submit([](lua_State* L) { return L; });
+    auto square = actor.call<int>("square", 7);
+    auto length2 = actor.call<double>("length2", Vec2{ 3.0, 4.0 });
+    auto missing = actor.call<int>("missing");
+
+    EXPECT_EQ(std::future_status::timeout, square.wait_for(std::chrono::seconds(0)));
+
+    actor.drain();
+
+    EXPECT_EQ(L, state.get());
+    EXPECT_EQ(49, *square.get());
+    EXPECT_DOUBLE_EQ(25.0, *length2.get());
+
+#if LUABRIDGE_HAS_EXCEPTIONS
+    EXPECT_THROW(missing.get(), luabridge::LuaException);
+#else
+    EXPECT_FALSE(missing.get());
+#endif
+}
+
+TEST_F(StateActorTests, ManyProducers)
+{
+    runLua("counter = 0");
+
+    luabridge::StateActor actor(L);
+
+    constexpr int producers = 4;
+    constexpr int jobsPerProducer = 1000;
+
+    std::atomic<bool> done = false;
+    std::vector<std::thread> threads;
+    for (int i = 0; i < producers; ++i)
+    {
+        threads.emplace_back([&actor]
+        {
+            for (int j = 0; j < jobsPerProducer; ++j)
+            {
+                actor.post([](lua_State* L)
+                {
+                    ASSERT_EQ(LUABRIDGE_LUA_OK, luaL_loadstring(L, "counter = counter + 1"));
+                    ASSERT_EQ(LUABRIDGE_LUA_OK, lua_pcall(L, 0, 0, 0));
+                });
+            }
+        });
+    }
+
+    std::thread joiner([&]
+    {
+        for (auto& thread : threads)
+            thread.join();
+
+        done = true;
+    });
+
+    std::size_t drained = 0;
+    while (! done.load())
+        drained += actor.drain(64);
+
+    joiner.join();
+    drained += actor.drain();
+
+    EXPECT_EQ(static_cast<std::size_t>(producers * jobsPerProducer), drained);
+    EXPECT_EQ(producers * jobsPerProducer, luabridge::getGlobal(L, "counter").unsafe_cast<int>());
+}
+
+#if LUABRIDGE_HAS_EXCEPTIONS
+TEST_F(StateActorTests, Exceptions)
+{
+    luabridge::StateActor actor(L);
+
+    auto result = actor.submit([](lua_State*) -> int { throw std::runtime_error("failure"); });
+    actor.post([](lua_State*) { throw std::logic_error("failure"); });
+
+    int runs = 0;
+    actor.post([&runs](lua_State*) { ++runs; });
+
+    EXPECT_THROW(actor.drain(), std::logic_error);
+    EXPECT_THROW(result.get(), std::runtime_error);
+
+    // The jobs after the failed one are still queued
+    EXPECT_EQ(1u, actor.drain());
+    EXPECT_EQ(1, runs);
+}
+#endif
+
+TEST_F(StateActorTests, PendingJobsAreDiscarded)
+{
+    std::future<int> result;
+
+    {
+        luabridge::StateActor actor(L);
+        result = actor.submit([](lua_State*) { return 1; });
+    }
+
+#if LUABRIDGE_HAS_EXCEPTIONS
+    EXPECT_THROW(result.get(), std::future_error);
+#else
+    EXPECT_TRUE(result.valid());
+#endif
+}
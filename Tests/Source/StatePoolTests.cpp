@@ -0,0 +1,157 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include "LuaBridge/StatePool.h"
+
+#include <set>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+struct Vec2
+{
+    double x = 0.0;
+    double y = 0.0;
+};
+
+void setupState(lua_State* L)
+{
+    luaL_openlibs(L);
+
+    luabridge::getGlobalNamespace(L)
+        .beginClass<Vec2>("Vec2")
+            .addConstructor<void (*)()>()
+            .addProperty("x", &Vec2::x)
+            .addProperty("y", &Vec2::y)
+        .endClass();
+
+    const char* script = R"(
+        function length2(v) return v.x * v.x + v.y * v.y end
+        function square(x) return x * x end
+    )";
+
+    ASSERT_EQ(LUABRIDGE_LUA_OK, luaL_loadstring(L, script));
+    ASSERT_EQ(LUABRIDGE_LUA_OK, lua_pcall(L, 0, 0, 0));
+}
+} // namespace
+
+struct StatePoolTests : ::testing::Test
+{
+};
+
+TEST_F(StatePoolTests, StatesAreSetUp)
+{
+    int setups = 0;
+    luabridge::StatePool pool(3, [&setups](lua_State* L)
+    {
+        ++setups;
+        setupState(L);
+    });
+
+    EXPECT_EQ(3u, pool.size());
+    EXPECT_EQ(3, setups);
+}
+
+TEST_F(StatePoolTests, CallReturnsResults)
+{
+    luabridge::StatePool pool(4, &setupState);
+
+    std::vector<std::future<luabridge::TypeResult<int>>> results;
+    for (int i = 0; i < 100; ++i)
+        results.push_back(pool.call<int>("square", i));
+
+    for (int i = 0; i < 100; ++i)
+    {
+        auto result = results[i].get();
+        ASSERT_TRUE(result);
+        EXPECT_EQ(i * i, *result);
+    }
+}
+
+TEST_F(StatePoolTests, CallWithRegisteredClass)
+{
+    luabridge::StatePool pool(2, &setupState);
+
+    auto result = pool.call<double>("length2", Vec2{ 3.0, 4.0 }).get();
+    ASSERT_TRUE(result);
+    EXPECT_DOUBLE_EQ(25.0, *result);
+}
+
+TEST_F(StatePoolTests, CallFailure)
+{
+    luabridge::StatePool pool(1, &setupState);
+
+    auto result = pool.call<int>("missing", 1).get();
+    EXPECT_FALSE(result);
+
+    // The worker is still usable
+    EXPECT_EQ(4, *pool.call<int>("square", 2).get());
+}
+
+TEST_F(StatePoolTests, SubmitRunsOnWorkerStates)
+{
+    std::vector<lua_State*> states;
+    luabridge::StatePool pool(2, [&states](lua_State* L)
+    {
+        states.push_back(L);
+        setupState(L);
+    });
+
+    std::vector<std::future<lua_State*>> results;
+    for (int i = 0; i < 20; ++i)
+        results.push_back(pool.submit([](lua_State* L) { return L; }));
+
+    for (auto& result : results)
+    {
+        lua_State* L = result.get();
+        EXPECT_TRUE(L == states[0] || L == states[1]);
+    }
+
+    auto stackTop = pool.submit([](lua_State* L)
+    {
+        lua_pushinteger(L, 1);
+        return lua_gettop(L);
+    });
+
+    EXPECT_EQ(1, stackTop.get());
+    EXPECT_EQ(0, pool.submit([](lua_State* L) { return lua_gettop(L); }).get());
+}
+
+#if LUABRIDGE_HAS_EXCEPTIONS
+TEST_F(StatePoolTests, ExceptionsAreStoredInFuture)
+{
+    luabridge::StatePool pool(1, &setupState);
+
+    auto result = pool.submit([](lua_State*) -> int { throw std::runtime_error("failure"); });
+    EXPECT_THROW(result.get(), std::runtime_error);
+
+    luabridge::StatePool throwingPool(1, [](lua_State* L)
+    {
+        setupState(L);
+        luabridge::enableExceptions(L);
+    });
+
+    auto call = throwingPool.call<int>("missing");
+    EXPECT_THROW(call.get(), luabridge::LuaException);
+}
+#endif
+
+TEST_F(StatePoolTests, IdleWorkersStealJobs)
+{
+    luabridge::StatePool pool(2, &setupState);
+
+    // A job queued from a worker goes to its own deque. The worker blocks until the job is done, so only the other worker can
+    // run it, by stealing it
+    auto nested = pool.submit([&pool](lua_State* L)
+    {
+        auto job = pool.submit([](lua_State* L) { return L; });
+        return job.get() != L;
+    });
+
+    EXPECT_TRUE(nested.get());
+    EXPECT_GE(pool.stolen(), 1u);
+}
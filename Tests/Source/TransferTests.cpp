@@ -0,0 +1,260 @@
+// https://github.com/kunitoki/LuaBridge3
+// Copyright 2026, kunitoki
+// SPDX-License-Identifier: MIT
+
+#include "TestBase.h"
+
+#include <memory>
+#include <string>
+
+namespace {
+struct Point
+{
+    int x = 0;
+    int y = 0;
+};
+
+struct Unique
+{
+    Unique() = default;
+    Unique(const Unique&) = delete;
+    Unique(Unique&&) = default;
+};
+
+struct Shared
+{
+    int value = 0;
+};
+
+void registerClasses(lua_State* L)
+{
+    luabridge::getGlobalNamespace(L)
+        .beginClass<Point>("Point")
+            .addConstructor<void (*)()>()
+            .addProperty("x", &Point::x, &Point::x)
+            .addProperty("y", &Point::y, &Point::y)
+        .endClass()
+        .beginClass<Unique>("Unique")
+            .addConstructor<void (*)()>()
+        .endClass()
+        .beginClass<Shared>("Shared")
+            .addProperty("value", &Shared::value, &Shared::value)
+        .endClass();
+}
+} // namespace
+
+struct TransferTests : TestBase
+{
+    lua_State* D = nullptr;
+
+    void SetUp() override
+    {
+        TestBase::SetUp();
+
+        D = createNewLuaState();
+    }
+
+    void TearDown() override
+    {
+        lua_close(D);
+
+        TestBase::TearDown();
+    }
+
+    luabridge::Result transferGlobal(const char* name)
+    {
+        lua_getglobal(L, name);
+        auto result = luabridge::transfer(L, -1, D);
+        lua_pop(L, 1);
+
+        if (result)
+            lua_setglobal(D, name);
+
+        return result;
+    }
+};
+
+TEST_F(TransferTests, Scalars)
+{
+    runLua(R"(
+        b = true
+        i = 42
+        n = 1.5
+        s = "hello\0world"
+    )");
+
+    for (const char* name : { "b", "i", "n", "s", "missing" })
+        ASSERT_TRUE(transferGlobal(name));
+
+    EXPECT_TRUE(runLua(R"(
+        assert(b == true)
+        assert(i == 42 and (math.type == nil or math.type(i) == "integer"))
+        assert(n == 1.5)
+        assert(s == "hello\0world" and #s == 11)
+        assert(missing == nil)
+    )", D));
+
+    lua_pushlightuserdata(L, this);
+    ASSERT_TRUE(luabridge::transfer(L, -1, D));
+    EXPECT_EQ(this, lua_touserdata(D, -1));
+    lua_pop(D, 1);
+}
+
+TEST_F(TransferTests, NestedTables)
+{
+    runLua(R"(
+        value = { 1, 2, 3, name = "root", child = { deep = { list = { "a", "b" } } }, [true] = "key" }
+        setmetatable(value, { __index = function() return "fallback" end })
+    )");
+
+    const int top = lua_gettop(D);
+    ASSERT_FALSE(transferGlobal("value"));
+    EXPECT_EQ(top, lua_gettop(D));
+
+    runLua("setmetatable(value, { kind = 'meta' })");
+    ASSERT_TRUE(transferGlobal("value"));
+
+    EXPECT_TRUE(runLua(R"(
+        assert(#value == 3 and value[3] == 3)
+        assert(value.name == "root")
+        assert(value.child.deep.list[2] == "b")
+        assert(value[true] == "key")
+        assert(getmetatable(value).kind == "meta")
+    )", D));
+}
+
+TEST_F(TransferTests, SharedReferencesAndCycles)
+{
+    runLua(R"(
+        local shared = { n = 1 }
+        value = { a = shared, b = shared }
+        value.self = value
+        value[shared] = "shared key"
+    )");
+
+    ASSERT_TRUE(transferGlobal("value"));
+
+    EXPECT_TRUE(runLua(R"(
+        assert(value.a == value.b)
+        assert(value.self == value)
+        assert(value[value.a] == "shared key")
+        value.a.n = 2
+        assert(value.b.n == 2)
+    )", D));
+}
+
+TEST_F(TransferTests, ClassValuesAreCopied)
+{
+    registerClasses(L);
+    registerClasses(D);
+
+    runLua(R"(
+        p = Point()
+        p.x, p.y = 1, 2
+        points = { p, p }
+    )");
+
+    ASSERT_TRUE(transferGlobal("points"));
+
+    runLua("p.x = 10");
+
+    auto points = luabridge::getGlobal(D, "points");
+    EXPECT_EQ(1, points[1].unsafe_cast<Point>().x);
+    EXPECT_EQ(2, points[1].unsafe_cast<Point>().y);
+    EXPECT_TRUE(runLua("assert(points[1] == points[2])", D));
+
+    runLua("u = Unique()");
+    const int top = lua_gettop(D);
+    auto result = transferGlobal("u");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(luabridge::makeErrorCode(luabridge::ErrorCode::ValueNotTransferable), result.error());
+    EXPECT_EQ(top, lua_gettop(D));
+}
+
+TEST_F(TransferTests, ConstObjectsStayConst)
+{
+    registerClasses(L);
+    registerClasses(D);
+
+    const Point point{ 3, 4 };
+    ASSERT_TRUE(luabridge::push(L, &point));
+    ASSERT_TRUE(luabridge::transfer(L, -1, D));
+    lua_setglobal(D, "p");
+
+    EXPECT_TRUE(runLua("assert(p.x == 3 and p.y == 4)", D));
+    EXPECT_TRUE(runLua("assert(not pcall(function() p.x = 5 end))", D));
+    EXPECT_EQ(&point, luabridge::getGlobal(D, "p").unsafe_cast<const Point*>());
+}
+
+TEST_F(TransferTests, SharedObjectsAreShared)
+{
+    registerClasses(L);
+    registerClasses(D);
+
+    auto shared = std::make_shared<Shared>();
+    ASSERT_TRUE(luabridge::push(L, shared));
+    EXPECT_EQ(2, shared.use_count());
+
+    ASSERT_TRUE(luabridge::transfer(L, -1, D));
+    EXPECT_EQ(3, shared.use_count());
+    lua_setglobal(D, "s");
+
+    runLua("s.value = 7", D);
+    EXPECT_EQ(7, shared->value);
+
+    lua_close(D);
+    D = createNewLuaState();
+    EXPECT_EQ(2, shared.use_count());
+}
+
+TEST_F(TransferTests, UnregisteredClassInDestination)
+{
+    registerClasses(L);
+
+    runLua("p = Point()");
+
+    auto result = transferGlobal("p");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(luabridge::makeErrorCode(luabridge::ErrorCode::ClassNotRegistered), result.error());
+}
+
+TEST_F(TransferTests, Functions)
+{
+    luabridge::lua_pushcfunction_x(L, +[](lua_State* l) -> int { lua_pushinteger(l, 99); return 1; }, "f");
+    ASSERT_TRUE(luabridge::transfer(L, -1, D));
+    lua_setglobal(D, "f");
+    EXPECT_TRUE(runLua("assert(f() == 99)", D));
+
+    runLua("g = function() end");
+    EXPECT_FALSE(transferGlobal("g"));
+
+    runLua("t = { 1, 2, { print }, coroutine.create(function() end) }");
+    const int top = lua_gettop(D);
+    EXPECT_FALSE(transferGlobal("t"));
+    EXPECT_EQ(top, lua_gettop(D));
+}
+
+TEST_F(TransferTests, MaxDepth)
+{
+    runLua(R"(
+        deep = {}
+        local t = deep
+        for i = 1, 1000 do t.next = {} t = t.next end
+    )");
+
+    auto result = transferGlobal("deep");
+    ASSERT_FALSE(result);
+    EXPECT_EQ(luabridge::makeErrorCode(luabridge::ErrorCode::LuaStackOverflow), result.error());
+}
+
+TEST_F(TransferTests, LuaRef)
+{
+    runLua("value = { answer = 42 }");
+    const int top = lua_gettop(L);
+
+    auto result = luabridge::transfer(luabridge::getGlobal(L, "value"), D);
+    ASSERT_TRUE(result);
+    EXPECT_EQ(D, result->state());
+    EXPECT_EQ(42, (*result)["answer"].unsafe_cast<int>());
+    EXPECT_EQ(top, lua_gettop(L));
+}
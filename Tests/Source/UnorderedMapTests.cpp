@@ -6,6 +6,7 @@
 
 #include "LuaBridge/UnorderedMap.h"
 
+#include <string>
 #include <unordered_map>
 
 struct UnorderedMapTests : TestBase
@@ -164,6 +165,21 @@ TEST_F(UnorderedMapTests, LuaRef)
     }
 }
 
+TEST_F(UnorderedMapTests, LargeStringKeyedRoundTrip)
+{
+    std::unordered_map<std::string, int> expected;
+    for (int i = 0; i < 10000; ++i)
+        expected.emplace("key" + std::to_string(i), i);
+
+    ASSERT_TRUE(luabridge::push(L, expected));
+
+    const auto actual = luabridge::get<std::unordered_map<std::string, int>>(L, -1);
+    ASSERT_TRUE(actual);
+    EXPECT_EQ(expected, *actual);
+
+    lua_pop(L, 1);
+}
+
 TEST_F(UnorderedMapTests, PassToFunction)
 {
     runLua("function foo (map) "
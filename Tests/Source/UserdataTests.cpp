@@ -322,3 +322,95 @@ TEST_F(TypeResultErrorHandlingTest, WrongClassTypeError)
     EXPECT_TRUE(true);
 #endif
 }
+
+//=================================================================================================
+// By-value results constructed in place
+//=================================================================================================
+
+namespace {
+struct PinnedValue
+{
+    explicit PinnedValue(int v) : value(v) {}
+
+    PinnedValue(const PinnedValue&) = delete;
+    PinnedValue(PinnedValue&&) = delete;
+    PinnedValue& operator=(const PinnedValue&) = delete;
+    PinnedValue& operator=(PinnedValue&&) = delete;
+
+    int get() const { return value; }
+
+    int value;
+};
+
+PinnedValue makePinnedValue(int v)
+{
+    return PinnedValue(v);
+}
+
+struct CountedValue
+{
+    static inline int copies = 0;
+    static inline int moves = 0;
+
+    explicit CountedValue(int v) : value(v) {}
+    CountedValue(const CountedValue& other) : value(other.value) { ++copies; }
+    CountedValue(CountedValue&& other) noexcept : value(other.value) { ++moves; }
+
+    int value;
+};
+
+struct CountedValueFactory
+{
+    CountedValue make(int v) const { return CountedValue(v * 2); }
+};
+} // namespace
+
+struct UserdataInPlaceTest : TestBase
+{
+};
+
+TEST_F(UserdataInPlaceTest, NonMovableResult)
+{
+    luabridge::getGlobalNamespace(L)
+        .beginClass<PinnedValue>("PinnedValue")
+            .addFunction("get", &PinnedValue::get)
+        .endClass()
+        .addFunction("makePinnedValue", &makePinnedValue)
+        .addFunction("makePinnedLambda", [](int v) { return PinnedValue(v + 1); });
+
+    runLua("result = makePinnedValue(7):get() + makePinnedLambda(7):get()");
+    EXPECT_EQ(15, result<int>());
+}
+
+TEST_F(UserdataInPlaceTest, ResultIsNotCopiedOrMoved)
+{
+    luabridge::getGlobalNamespace(L)
+        .beginClass<CountedValue>("CountedValue")
+            .addProperty("value", &CountedValue::value)
+        .endClass()
+        .beginClass<CountedValueFactory>("CountedValueFactory")
+            .addConstructor<void (*)()>()
+            .addFunction("make", &CountedValueFactory::make)
+        .endClass()
+        .addFunction("makeCounted", [](int v) { return CountedValue(v); });
+
+    CountedValue::copies = 0;
+    CountedValue::moves = 0;
+
+    runLua("result = makeCounted(3).value + CountedValueFactory():make(4).value");
+    EXPECT_EQ(11, result<int>());
+    EXPECT_EQ(0, CountedValue::copies);
+    EXPECT_EQ(0, CountedValue::moves);
+}
+
+TEST_F(UserdataInPlaceTest, UnregisteredResultFails)
+{
+    luabridge::getGlobalNamespace(L)
+        .addFunction("makeCounted", [](int v) { return CountedValue(v); });
+
+#if LUABRIDGE_HAS_EXCEPTIONS
+    EXPECT_THROW(runLua("result = makeCounted(1)"), std::exception);
+#else
+    EXPECT_FALSE(runLua("result = makeCounted(1)"));
+#endif
+}
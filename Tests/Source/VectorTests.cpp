@@ -143,6 +143,51 @@ TEST_F(VectorTests, GetWithInvalidItem)
     EXPECT_EQ(luabridge::ErrorCode::InvalidTypeCast, result.error());
 }
 
+TEST_F(VectorTests, GetDecodesSequencePartInOrder)
+{
+    runLua("result = {} "
+           "for i = 1, 1000 do result[i] = i * 0.5 end "
+           "result.name = 'ignored'");
+
+    const auto actual = result<std::vector<double>>();
+    ASSERT_EQ(1000u, actual.size());
+
+    for (std::size_t i = 0; i < actual.size(); ++i)
+        EXPECT_DOUBLE_EQ(static_cast<double>(i + 1) * 0.5, actual[i]);
+}
+
+TEST_F(VectorTests, GetSkipsHoles)
+{
+    // With a full array part of 3 slots the length is 3 on every runtime, so element 2 is a hole inside the sequence
+    lua_createtable(L, 3, 0);
+    lua_pushinteger(L, 1);
+    lua_rawseti(L, -2, 1);
+    lua_pushinteger(L, 3);
+    lua_rawseti(L, -2, 3);
+    ASSERT_EQ(3, luabridge::get_length(L, -1));
+
+    auto result = luabridge::Stack<std::vector<int>>::get(L, -1);
+
+#if LUABRIDGE_STRICT_SEQUENCE_CONVERSIONS
+    ASSERT_FALSE(result);
+#else
+    ASSERT_TRUE(result);
+    EXPECT_EQ((std::vector<int>{ 1, 3 }), *result);
+#endif
+}
+
+TEST_F(VectorTests, GetWithNonRepresentableNumber)
+{
+    runLua("result = { 1, 2.5, 3 }");
+    EXPECT_FALSE(result().cast<std::vector<int>>());
+
+    runLua("result = { 1, 300, 3 }");
+    EXPECT_FALSE(result().cast<std::vector<std::uint8_t>>());
+
+    runLua("result = { 1, 'a', 3 }");
+    EXPECT_FALSE(result().cast<std::vector<float>>());
+}
+
 TEST_F(VectorTests, IsInstance)
 {
     ASSERT_TRUE((luabridge::push(L, std::vector<int>{ 1, 2, 3 })));